@@ -0,0 +1,145 @@
+//
+//  BenchmarkRunner.cpp
+//  Benchmark
+//
+//  Created by Erwin on 18/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "BenchmarkRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <numeric>
+
+// Extracts a value from a line written by writeJson. It is not a general JSON parser.
+std::string extractValue(const std::string& line, const std::string& key) {
+    std::string pattern = "\"" + key + "\":";
+    auto pos = line.find(pattern);
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += pattern.size();
+
+    auto end = line.find_first_of(",}", pos);
+    std::string value = line.substr(pos, end - pos);
+    if (value.size() >= 2 && value.front() == '"') {
+        value = value.substr(1, value.size() - 2);
+    }
+
+    return value;
+}
+
+bool BenchmarkRunner::run(const std::string& name, std::function<long()> fun,
+                          int warmUps, int repetitions) {
+    if (!_filter.empty() && name.find(_filter) == std::string::npos) {
+        return true;
+    }
+
+    if (_warmUps >= 0) warmUps = _warmUps;
+    if (_repetitions >= 0) repetitions = _repetitions;
+    repetitions = std::max(repetitions, 1);
+
+    bool consistent = true;
+    long work = 0;
+    for (int i = 0; i < warmUps; i++) {
+        work = fun();
+    }
+
+    std::vector<double> times;
+    for (int i = 0; i < repetitions; i++) {
+        auto startTime = std::chrono::steady_clock::now();
+        long runWork = fun();
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+
+        times.push_back(duration.count());
+        if ((warmUps > 0 || i > 0) && runWork != work) {
+            consistent = false;
+        }
+        work = runWork;
+    }
+
+    std::sort(times.begin(), times.end());
+    double median = (times.size() % 2 == 1
+                     ? times[times.size() / 2]
+                     : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2);
+    double mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+
+    _results.push_back({name, repetitions, times.front(), median, mean, work});
+
+    std::cerr << name << ": " << median << "s (median of " << repetitions << ")";
+    if (!consistent) {
+        std::cerr << " WARNING: work differed across runs";
+    }
+    std::cerr << std::endl;
+
+    return consistent;
+}
+
+void BenchmarkRunner::writeJson(std::ostream &os) const {
+    os << "{\"benchmarks\":[" << std::endl;
+    bool first = true;
+    for (auto& result : _results) {
+        if (!first) {
+            os << "," << std::endl;
+        }
+        first = false;
+
+        os << "{\"name\":\"" << result.name << "\""
+        << ",\"repetitions\":" << result.repetitions
+        << ",\"min\":" << result.minTime
+        << ",\"median\":" << result.medianTime
+        << ",\"mean\":" << result.meanTime
+        << ",\"work\":" << result.work
+        << "}";
+    }
+    os << std::endl << "]}" << std::endl;
+}
+
+int BenchmarkRunner::compareWithBaseline(const std::string& filename, double tolerance,
+                                         std::ostream &os) const {
+    std::ifstream input(filename);
+    if (!input) {
+        return -1;
+    }
+
+    std::map<std::string, std::pair<double, long>> baseline;
+    std::string line;
+    while (std::getline(input, line)) {
+        std::string name = extractValue(line, "name");
+        if (!name.empty()) {
+            baseline[name] = {std::stod(extractValue(line, "median")),
+                              std::stol(extractValue(line, "work"))};
+        }
+    }
+
+    int numRegressions = 0;
+    for (auto& result : _results) {
+        auto entry = baseline.find(result.name);
+        if (entry == baseline.end()) {
+            os << result.name << ": not in baseline" << std::endl;
+            continue;
+        }
+
+        double baselineTime = entry->second.first;
+        double ratio = result.medianTime / baselineTime;
+        bool regressed = ratio > 1 + tolerance;
+        bool workChanged = result.work != entry->second.second;
+
+        os << result.name << ": " << baselineTime << "s -> " << result.medianTime << "s ("
+        << ratio << "x)";
+        if (regressed) {
+            os << " REGRESSION";
+        }
+        if (workChanged) {
+            os << " WORK CHANGED (" << entry->second.second << " -> " << result.work << ")";
+        }
+        os << std::endl;
+
+        numRegressions += (regressed || workChanged);
+    }
+
+    return numRegressions;
+}
@@ -0,0 +1,59 @@
+//
+//  BenchmarkRunner.h
+//  Benchmark
+//
+//  Created by Erwin on 18/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct BenchmarkResult {
+    std::string name;
+    int repetitions;
+
+    // Wall time in seconds
+    double minTime;
+    double medianTime;
+    double meanTime;
+
+    // Amount of work done by a single run, e.g. number of steps executed or programs searched.
+    // It is included so that behavioral changes are noticed when comparing against a baseline.
+    long work;
+};
+
+// Runs benchmarks with warm-up and repetitions. Results are written as JSON, with one benchmark
+// per line, so that a stored baseline can easily be compared against.
+class BenchmarkRunner {
+    // When set (non-negative), override the settings of individual benchmarks
+    int _warmUps = -1;
+    int _repetitions = -1;
+
+    std::string _filter;
+    std::vector<BenchmarkResult> _results;
+
+public:
+    void setWarmUps(int warmUps) { _warmUps = warmUps; }
+    void setRepetitions(int repetitions) { _repetitions = repetitions; }
+    void setFilter(const std::string& filter) { _filter = filter; }
+
+    // Runs the benchmark, unless it is excluded by the filter. The function should return the
+    // amount of work it did. Expensive benchmarks can use fewer warm-ups and repetitions.
+    // Returns false if the amount of work differed across runs.
+    bool run(const std::string& name, std::function<long()> fun,
+             int warmUps = 1, int repetitions = 5);
+
+    const std::vector<BenchmarkResult>& results() const { return _results; }
+
+    void writeJson(std::ostream &os) const;
+
+    // Compares the results against those in the given baseline file. Returns the number of
+    // benchmarks whose median time regressed by more than the given tolerance (a fraction), or
+    // whose work differs. Returns -1 if the baseline cannot be read.
+    int compareWithBaseline(const std::string& filename, double tolerance,
+                            std::ostream &os) const;
+};
@@ -0,0 +1,364 @@
+//
+//  main.cpp
+//  Benchmark
+//
+//  Created by Erwin on 18/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include <climits>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cxxopts.hpp"
+
+#include "BenchmarkRunner.h"
+
+#include "ExhaustiveSearcher.h"
+#include "ExitFinder.h"
+#include "FastExecutor.h"
+#include "HangExecutor.h"
+#include "InterpretedProgramBuilder.h"
+#include "InterpretedProgramCanonizer.h"
+#include "MetaLoopHangDetector.h"
+#include "PeriodicHangDetector.h"
+#include "Program.h"
+#include "RunSummary.h"
+#include "SearchOrchestration.h"
+
+// Long running program that is used to benchmark the executors
+const std::string longRunningProgram = "Zv6+kpUoAqW0bw";
+
+struct HangCorpus {
+    std::string name;
+    HangType hangType;
+    std::vector<std::string> programs;
+};
+
+// Representative programs for each type of hang, taken from the hang tests
+const std::vector<HangCorpus> hangCorpora = {
+    {"periodic", HangType::PERIODIC, {
+        "VYgQIECAAg", "VQohZBiSAg", "VQolYFqSVg", "VYgQIkAICA",
+        "VQIiZBiEAg", "VSohZAiAAg", "VSohZEiAAg", "VSohZFiCAg"
+    }},
+    {"nested-periodic", HangType::NESTED_PERIODIC, {
+        "ZiKIVkSGSEoEAA", "ZioIWEYEAmFACA", "ZiKIVkFmhECAAA", "ZgKChhFgkoWFoA",
+        "ZgKChhFglIWFoA", "ZgICEikAWIEEYA", "ZggIQiUBaIQlgA", "ZgIAkikAWIEFYA"
+    }},
+    {"glider", HangType::APERIODIC_GLIDER, {
+        "ZgKCBhFglIWFoA", "ZggIWECGUkIEgA", "ZgiJUkAkYGFgiA", "ZgoIWESGUmYEgA",
+        "ZiIJSJEoYKlkGA", "ZgiJUkFmBCFgiA", "ZiiJUkJEZGBkiA", "ZgiJUkUkYGFkiA"
+    }},
+    {"regular-sweep", HangType::REGULAR_SWEEP, {
+        "VQgJKGJgWA", "VQgJIWIYWA", "ZgoCQhGABoAlqA", "ZgCCAAIJRqgEGA",
+        "ZgoCUoGJoFgEAA", "ZoIEkhCCkCFgKA", "ZgoCQhSIGIYFgA", "dwiCFSQCABggAJFgiA"
+    }},
+    {"irregular-sweep", HangType::IRREGULAR_SWEEP, {
+        "ZgqCUgWJGIYFgA", "ZgIAEolEGGGEIA", "ZggCSCQBYIQFgA", "ZgqCUhWIWIYFgA",
+        "ZgqCUiSBWIWFoA", "ZgoCQiWBWIWFoA", "ZgIAkgkAWKEFYA", "ZgIAkokFWGEEIA"
+    }},
+};
+
+std::shared_ptr<InterpretedProgramBuilder> buildProgram(const std::string& programSpec) {
+    Program program = Program::fromString(programSpec);
+    auto programBuilder = std::make_shared<InterpretedProgramBuilder>();
+    programBuilder->buildFromProgram(program);
+
+    return programBuilder;
+}
+
+void benchmarkExecutors(BenchmarkRunner& runner) {
+    auto programBuilder = buildProgram(longRunningProgram);
+    const int dataSize = 1000000;
+    const int maxFastSteps = 200000000;
+    const int maxSteps = 20000000;
+
+    auto runExecutor = [&](ProgramExecutor& executor, int stepLimit) {
+        executor.setMaxSteps(stepLimit);
+        executor.execute(programBuilder);
+        executor.pop();
+
+        return (long)executor.numSteps();
+    };
+
+    FastExecutor fastExecutor(dataSize);
+    runner.run("fast-executor", [&]() { return runExecutor(fastExecutor, maxFastSteps); });
+
+    FastExecutor narrowExecutor(dataSize);
+    narrowExecutor.setCellWidth(CellWidth::NARROW_8);
+    runner.run("fast-executor-narrow8", [&]() { return runExecutor(narrowExecutor, maxFastSteps); });
+
+    runner.run("hang-executor-undo", [&]() {
+        HangExecutor hangExecutor(dataSize, 0);
+        return runExecutor(hangExecutor, maxSteps);
+    });
+
+    // Hang detection is much slower, so use fewer steps
+    const int maxHangDetectionSteps = 1000000;
+    runner.run("hang-executor-detection", [&]() {
+        HangExecutor hangExecutor(dataSize, maxHangDetectionSteps);
+        hangExecutor.addDefaultHangDetectors();
+        hangExecutor.setMaxSteps(maxHangDetectionSteps);
+        hangExecutor.execute(programBuilder);
+        hangExecutor.pop();
+
+        return (long)hangExecutor.numSteps();
+    });
+}
+
+// Runs the corpus of each hang type with only the hang detector that should detect it. The
+// amount of work is the number of hangs that were detected.
+void benchmarkHangDetectors(BenchmarkRunner& runner) {
+    for (auto& corpus : hangCorpora) {
+        std::vector<std::shared_ptr<InterpretedProgramBuilder>> programs;
+        for (auto& programSpec : corpus.programs) {
+            programs.push_back(buildProgram(programSpec));
+        }
+
+        HangExecutor hangExecutor(16384, 100000);
+        hangExecutor.setMaxSteps(100000);
+        if (corpus.hangType == HangType::PERIODIC) {
+            hangExecutor.addHangDetector(std::make_shared<PeriodicHangDetector>(hangExecutor));
+        } else {
+            hangExecutor.addHangDetector(std::make_shared<MetaLoopHangDetector>(hangExecutor));
+        }
+
+        runner.run("detector-" + corpus.name, [&]() {
+            long numDetected = 0;
+            for (int i = 0; i < 100; i++) {
+                for (auto& program : programs) {
+                    RunResult result = hangExecutor.execute(program);
+                    hangExecutor.pop();
+
+                    numDetected += (result == RunResult::DETECTED_HANG
+                                    && hangExecutor.detectedHangType() == corpus.hangType);
+                }
+            }
+            return numDetected;
+        });
+    }
+}
+
+void benchmarkRunSummary(BenchmarkRunner& runner) {
+    // Obtain a long run history without any hang detectors interfering
+    const int numSteps = 2000000;
+    HangExecutor hangExecutor(1000000, numSteps);
+    hangExecutor.setMaxSteps(numSteps);
+    hangExecutor.setBoundRunHistory(false);
+    hangExecutor.execute(buildProgram(longRunningProgram));
+    const RunHistory sourceHistory = hangExecutor.getRunHistory();
+
+    runner.run("run-summary", [&]() {
+        RunHistory runHistory;
+        std::vector<int> helperBuf;
+        RunSummary runSummary(runHistory, helperBuf);
+        MetaRunSummary metaRunSummary(runSummary.getRunBlocks(), helperBuf);
+
+        for (auto programBlock : sourceHistory) {
+            runHistory.push_back(programBlock);
+            if (runSummary.processNewRunUnits()) {
+                metaRunSummary.processNewRunUnits();
+            }
+        }
+
+        return (long)runSummary.getNumRunBlocks();
+    });
+}
+
+std::vector<std::string> allCorpusPrograms() {
+    std::vector<std::string> programSpecs;
+    for (auto& corpus : hangCorpora) {
+        programSpecs.insert(programSpecs.end(), corpus.programs.begin(), corpus.programs.end());
+    }
+    return programSpecs;
+}
+
+void benchmarkCanonizer(BenchmarkRunner& runner) {
+    std::vector<std::shared_ptr<InterpretedProgramBuilder>> programs;
+    for (auto& programSpec : allCorpusPrograms()) {
+        programs.push_back(buildProgram(programSpec));
+    }
+
+    runner.run("canonizer", [&]() {
+        long numBlocks = 0;
+        for (int i = 0; i < 1000; i++) {
+            for (auto& program : programs) {
+                InterpretedProgramCanonizer canonizer {*program};
+                numBlocks += canonizer.numProgramBlocks();
+            }
+        }
+        return numBlocks;
+    });
+}
+
+void benchmarkExitFinder(BenchmarkRunner& runner) {
+    runner.run("exit-finder", [&]() {
+        long numExits = 0;
+        for (auto& programSpec : allCorpusPrograms()) {
+            Program program = Program::fromString(programSpec);
+            InterpretedProgramBuilder programBuilder;
+            programBuilder.buildFromProgram(program);
+            ExitFinder exitFinder(program, programBuilder);
+
+            for (int i = 0; i < 1000; i++) {
+                for (int j = 0; j < programBuilder.numProgramBlocks(); j++) {
+                    const ProgramBlock* block = programBuilder.programBlockAt(j);
+                    if (block->isFinalized()) {
+                        numExits += exitFinder.canExitFrom(block);
+                    }
+                }
+            }
+        }
+        return numExits;
+    });
+}
+
+void benchmarkProgramBuilder(BenchmarkRunner& runner) {
+    std::vector<Program> programs;
+    for (auto& programSpec : allCorpusPrograms()) {
+        programs.push_back(Program::fromString(programSpec));
+    }
+    // Large programs have longer straight lines of NOOPs
+    programs.push_back(Program::fromString(
+        "zggIAACkgAEUCCEAAAEQgAEQEoGUAEECAmWQIEIgAEAWiEAAGAgCAAAIIA"));
+    programs.push_back(Program::fromString(
+        "3SICAAAKSAAEUCIBEAAARSAkGUEiBBgIQQIgGWgABCFogQAAYkoCAFgCCA"));
+
+    InterpretedProgramBuilder programBuilder;
+    LargeInterpretedProgramBuilder largeProgramBuilder;
+    runner.run("program-builder", [&]() {
+        long numBlocks = 0;
+        for (int i = 0; i < 1000; i++) {
+            for (auto& program : programs) {
+                if (InterpretedProgramBuilder::supportsSize(program.getSize())) {
+                    programBuilder.buildFromProgram(program);
+                    numBlocks += programBuilder.numProgramBlocks();
+                } else {
+                    largeProgramBuilder.buildFromProgram(program);
+                    numBlocks += largeProgramBuilder.numProgramBlocks();
+                }
+            }
+        }
+        return numBlocks;
+    });
+}
+
+// Runs the search with output suppressed. Returns the number of programs that were evaluated.
+template <class Searcher, class SearchFun>
+long runSearch(Searcher& searcher, SearchFun search) {
+    auto tracker = std::make_unique<ProgressTracker>();
+    tracker->setDumpStatsPeriod(INT_MAX);
+    tracker->setDumpSuccessStepsLimit(INT_MAX);
+    searcher.attachProgressTracker(std::move(tracker));
+
+    // Suppress progress output, so that it does not mix with the JSON output
+    std::ostringstream discardedOutput;
+    auto coutBuf = std::cout.rdbuf(discardedOutput.rdbuf());
+    search();
+    std::cout.rdbuf(coutBuf);
+
+    tracker = searcher.detachProgressTracker();
+    return (tracker->getTotalSuccess() + tracker->getTotalErrors() + tracker->getTotalHangs());
+}
+
+// Searches the same way as a full search from the command line
+template <class SearchRunner>
+long fullSearch(int size) {
+    SearchSettings settings {size};
+    SearchRunner searchRunner {settings};
+
+    return runSearch(searchRunner.getSearcher(), [&]() { searchRunner.run(); });
+}
+
+// Searches a sub-tree of the 7x7 search space, as a full 7x7 search takes too long
+template <class ExhaustiveSearcher>
+long subTreeSearch7x7() {
+    SearchSettings settings {7};
+    ExhaustiveSearcher searcher {settings};
+    const std::vector<Ins> resumeFrom = {
+        Ins::NOOP, Ins::NOOP, Ins::NOOP, Ins::DATA, Ins::TURN, Ins::DATA, Ins::DATA, Ins::TURN
+    };
+
+    return runSearch(searcher, [&]() { searcher.searchSubTree(resumeFrom); });
+}
+
+void benchmarkSearch(BenchmarkRunner& runner) {
+    runner.run("search-5x5", [&]() { return fullSearch<OrchestratedSearchRunner>(5); });
+
+    // Compare the searchers that are specialized for the program width with the generic one
+    runner.run("search-6x6", [&]() {
+        return fullSearch<BasicOrchestratedSearchRunner<8, 6>>(6);
+    }, 0, 3);
+    runner.run("search-6x6-generic", [&]() {
+        return fullSearch<OrchestratedSearchRunner>(6);
+    }, 0, 3);
+    runner.run("search-7x7-subtree", [&]() {
+        return subTreeSearch7x7<BasicExhaustiveSearcher<8, 7>>();
+    }, 0, 3);
+    runner.run("search-7x7-subtree-generic", [&]() {
+        return subTreeSearch7x7<ExhaustiveSearcher>();
+    }, 0, 3);
+}
+
+int main(int argc, char * argv[]) {
+    cxxopts::Options options("Benchmark", "Benchmarks for the Busy Beaver Finder");
+    options.add_options()
+        ("f,filter", "Only run benchmarks whose name contains this", cxxopts::value<std::string>())
+        ("warm-ups", "Number of warm-up runs", cxxopts::value<int>())
+        ("r,repetitions", "Number of timed runs", cxxopts::value<int>())
+        ("o,output", "File to write JSON results to", cxxopts::value<std::string>())
+        ("b,baseline", "JSON results to compare against", cxxopts::value<std::string>())
+        ("tolerance", "Allowed slowdown compared to baseline", cxxopts::value<double>())
+        ("help", "Show help");
+    auto result = options.parse(argc, argv);
+
+    if (result.count("help")) {
+        std::cout << options.help({""}) << std::endl;
+        return 0;
+    }
+
+    BenchmarkRunner runner;
+    if (result.count("filter")) {
+        runner.setFilter(result["filter"].as<std::string>());
+    }
+    if (result.count("warm-ups")) {
+        runner.setWarmUps(result["warm-ups"].as<int>());
+    }
+    if (result.count("repetitions")) {
+        runner.setRepetitions(result["repetitions"].as<int>());
+    }
+
+    benchmarkExecutors(runner);
+    benchmarkHangDetectors(runner);
+    benchmarkRunSummary(runner);
+    benchmarkCanonizer(runner);
+    benchmarkProgramBuilder(runner);
+    benchmarkExitFinder(runner);
+    benchmarkSearch(runner);
+
+    if (result.count("output")) {
+        std::ofstream output(result["output"].as<std::string>());
+        runner.writeJson(output);
+    } else {
+        runner.writeJson(std::cout);
+    }
+
+    if (result.count("baseline")) {
+        double tolerance = result.count("tolerance") ? result["tolerance"].as<double>() : 0.1;
+        int numRegressions = runner.compareWithBaseline(result["baseline"].as<std::string>(),
+                                                        tolerance, std::cerr);
+        if (numRegressions < 0) {
+            std::cerr << "Could not read baseline" << std::endl;
+            return -1;
+        }
+        if (numRegressions > 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
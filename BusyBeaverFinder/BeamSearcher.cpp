@@ -0,0 +1,196 @@
+//
+//  BeamSearcher.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "BeamSearcher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <iterator>
+#include <iostream>
+#include <thread>
+
+template <int maxProgramSize, int programWidth>
+BasicBeamSearcher<maxProgramSize, programWidth>::BasicBeamSearcher(
+    SearchSettings settings, BeamSearchSettings beamSettings
+) :
+    _settings(settings),
+    _beamSettings(beamSettings)
+{
+    for (int i = std::max(1, _beamSettings.numThreads); --i >= 0; ) {
+        _workers.push_back(std::make_unique<SearcherType>(_settings));
+        _workers.back()->attachProgressTracker(createWorkerTracker());
+    }
+}
+
+template <int maxProgramSize, int programWidth>
+std::unique_ptr<ProgressTracker>
+BasicBeamSearcher<maxProgramSize, programWidth>::createWorkerTracker() const {
+    auto tracker = std::make_unique<ProgressTracker>();
+
+    // Progress is reported by the beam searcher
+    tracker->setDumpStatsPeriod(INT_MAX);
+    tracker->setDumpSuccessStepsLimit(INT_MAX);
+
+    return tracker;
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicBeamSearcher<maxProgramSize, programWidth>::checkForRecord(const SearcherType& worker) {
+    const ProgressTracker* tracker = worker.getProgressTracker();
+
+    std::lock_guard<std::mutex> lock(_recordMutex);
+    if (tracker->getMaxStepsFound() > _maxStepsFound) {
+        _maxStepsFound = tracker->getMaxStepsFound();
+        _bestProgramSpec = tracker->getBestProgramSpec();
+
+        std::cout << "REC " << _maxStepsFound << " " << _bestProgramSpec << std::endl;
+    }
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicBeamSearcher<maxProgramSize, programWidth>::expandBeam(
+    std::vector<PartialProgram>& frontier
+) {
+    std::vector<std::vector<PartialProgram>> frontiers(_workers.size());
+    std::atomic<size_t> next = 0;
+
+    // Workers take the next partial program from the beam, so that the most promising programs
+    // are expanded first
+    auto expand = [&](int workerIndex) {
+        SearcherType& worker = *_workers[workerIndex];
+        size_t i;
+        while ((i = next++) < _beam.size()) {
+            worker.expand(_beam[i].instructions, frontiers[workerIndex]);
+            checkForRecord(worker);
+        }
+    };
+
+    if (_workers.size() == 1) {
+        expand(0);
+    } else {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < _workers.size(); i++) {
+            threads.emplace_back(expand, i);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    for (auto& workerFrontier : frontiers) {
+        frontier.insert(frontier.end(), workerFrontier.begin(), workerFrontier.end());
+    }
+}
+
+// Ties are broken by the instructions, so that the search does not depend on the order in which
+// threads finish
+bool morePromisingThan(const PartialProgram& p1, const PartialProgram& p2) {
+    return (p1.score != p2.score) ? p1.score > p2.score : p1.instructions < p2.instructions;
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicBeamSearcher<maxProgramSize, programWidth>::selectBeam() {
+    size_t beamWidth = std::max(1, _beamSettings.beamWidth);
+    if (_beamSettings.maxExpansions > 0) {
+        beamWidth = std::min(beamWidth, (size_t)(_beamSettings.maxExpansions - _totalExpanded));
+    }
+
+    _beam.clear();
+    if (_queue.size() > beamWidth) {
+        std::nth_element(_queue.begin(), _queue.begin() + beamWidth, _queue.end(),
+                         morePromisingThan);
+        std::move(_queue.begin(), _queue.begin() + beamWidth, std::back_inserter(_beam));
+        _queue.erase(_queue.begin(), _queue.begin() + beamWidth);
+    } else {
+        std::swap(_beam, _queue);
+    }
+    std::sort(_beam.begin(), _beam.end(), morePromisingThan);
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicBeamSearcher<maxProgramSize, programWidth>::addToQueue(
+    std::vector<PartialProgram>& frontier
+) {
+    std::move(frontier.begin(), frontier.end(), std::back_inserter(_queue));
+
+    size_t maxQueueSize = std::max(1, _beamSettings.maxQueueSize);
+    if (_queue.size() > maxQueueSize) {
+        std::nth_element(_queue.begin(), _queue.begin() + maxQueueSize, _queue.end(),
+                         morePromisingThan);
+        _queue.resize(maxQueueSize);
+    }
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicBeamSearcher<maxProgramSize, programWidth>::mergeWorkerTrackers() {
+    for (auto& worker : _workers) {
+        auto tracker = worker->detachProgressTracker();
+        _tracker->merge(*tracker);
+        worker->attachProgressTracker(createWorkerTracker());
+    }
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicBeamSearcher<maxProgramSize, programWidth>::search() {
+    _queue.clear();
+    _queue.push_back({ {}, 0 });
+    _round = 0;
+    _totalExpanded = 0;
+
+    while (!_queue.empty()
+           && (_beamSettings.maxExpansions == 0 || _totalExpanded < _beamSettings.maxExpansions)
+    ) {
+        std::vector<PartialProgram> frontier;
+
+        selectBeam();
+        expandBeam(frontier);
+        _totalExpanded += _beam.size();
+        mergeWorkerTrackers();
+        addToQueue(frontier);
+        _round++;
+
+        dumpSearchProgress(std::cout);
+        std::cout << std::endl;
+    }
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicBeamSearcher<maxProgramSize, programWidth>::dumpSettings(std::ostream &os) const {
+    _workers[0]->dumpSettings(os);
+    os
+    << "BeamWidth = " << _beamSettings.beamWidth
+    << ", MaxQueueSize = " << _beamSettings.maxQueueSize
+    << ", MaxExpansions = " << _beamSettings.maxExpansions
+    << ", Threads = " << _workers.size()
+    << std::endl;
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicBeamSearcher<maxProgramSize, programWidth>::dumpSearchProgress(std::ostream &os) const {
+    os
+    << "Round=" << _round
+    << ", Queue=" << _queue.size()
+    << ", Expanded=" << _totalExpanded
+    << ", Best score=" << (_beam.empty() ? 0 : _beam[0].score)
+    << ", Max steps=" << _maxStepsFound;
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicBeamSearcher<maxProgramSize, programWidth>::dumpHangDetectionProfile(
+    std::ostream &os
+) const {
+    for (auto& worker : _workers) {
+        worker->dumpHangDetectionProfile(os);
+    }
+}
+
+template class BasicBeamSearcher<8>;
+template class BasicBeamSearcher<8, 6>;
+template class BasicBeamSearcher<8, 7>;
+template class BasicBeamSearcher<16>;
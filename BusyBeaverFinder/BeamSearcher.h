@@ -0,0 +1,89 @@
+//
+//  BeamSearcher.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Searcher.h"
+#include "ExhaustiveSearcher.h"
+
+struct BeamSearchSettings {
+    // The number of partial programs that are expanded each round
+    int beamWidth = 1000;
+
+    // The maximum number of partial programs that are waiting to be expanded. When there are
+    // more, the least promising ones are dropped.
+    int maxQueueSize = 1000000;
+
+    // The search stops after this many partial programs have been expanded. Zero means no limit.
+    long maxExpansions = 0;
+
+    // The number of threads that expand partial programs in parallel
+    int numThreads = 1;
+};
+
+/* Searches for long-running programs on grids that are too large for an exhaustive search. It is
+ * a best-first search that proceeds in rounds. Each round, the most promising partial programs
+ * are taken from the queue and expanded by one instruction. The resulting partial programs are
+ * added to the queue.
+ *
+ * Partial programs are stored as instruction stacks, from which the exhaustive searchers that do
+ * the actual expansion resume. Each thread uses its own searcher and progress tracker. The results
+ * of the latter are merged into this searcher's tracker after each round.
+ */
+template <int maxProgramSize, int programWidth = 0>
+class BasicBeamSearcher : public Searcher {
+    using SearcherType = BasicExhaustiveSearcher<maxProgramSize, programWidth>;
+
+    SearchSettings _settings;
+    BeamSearchSettings _beamSettings;
+
+    std::vector<std::unique_ptr<SearcherType>> _workers;
+
+    std::vector<PartialProgram> _queue;
+    // The partial programs expanded in the current round. Sorted by score, most promising first
+    std::vector<PartialProgram> _beam;
+    int _round = 0;
+    long _totalExpanded = 0;
+
+    // Guards the step record, which is updated by the worker threads
+    std::mutex _recordMutex;
+    int _maxStepsFound = 0;
+    std::string _bestProgramSpec;
+
+    std::unique_ptr<ProgressTracker> createWorkerTracker() const;
+
+    void expandBeam(std::vector<PartialProgram>& frontier);
+    void selectBeam();
+    void addToQueue(std::vector<PartialProgram>& frontier);
+    void mergeWorkerTrackers();
+
+    // Reports the best program found by the worker when it is a new step record
+    void checkForRecord(const SearcherType& worker);
+
+public:
+    BasicBeamSearcher(SearchSettings settings, BeamSearchSettings beamSettings);
+
+    int getMaxStepsFound() const { return _maxStepsFound; }
+    long getTotalExpanded() const { return _totalExpanded; }
+
+    // Returns the program with the step record
+    const std::string getProgramSpec() const override { return _bestProgramSpec; }
+    int getNumSteps() const override { return _maxStepsFound; }
+
+    void search();
+
+    void dumpSettings(std::ostream &os) const override;
+    void dumpSearchProgress(std::ostream &os) const override;
+    void dumpHangDetectionProfile(std::ostream &os) const override;
+};
+
+using BeamSearcher = BasicBeamSearcher<8>;
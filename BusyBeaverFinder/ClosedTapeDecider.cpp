@@ -0,0 +1,349 @@
+//
+//  ClosedTapeDecider.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "ClosedTapeDecider.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <thread>
+
+#include "InterpretedProgram.h"
+#include "InterpretedProgramBuilder.h"
+#include "Program.h"
+
+void ClosedTapeCertificate::write(std::ostream &os) const {
+    auto writeSegment = [&os](const TapeSegment& segment) {
+        for (TapeSymbol symbol : segment) {
+            os << " " << (int)symbol;
+        }
+        os << std::endl;
+    };
+
+    os << windowSize << " " << valueBound << " "
+    << windows.size() << " " << configs.size() << std::endl;
+    for (auto& window : windows) {
+        writeSegment(window);
+    }
+    for (auto& config : configs) {
+        os << config.blockIndex;
+        writeSegment(config.segment);
+    }
+}
+
+bool ClosedTapeCertificate::read(std::istream &is) {
+    auto readSegment = [&is](TapeSegment& segment, int size) {
+        segment.resize(std::max(size, 0));
+        for (TapeSymbol& symbol : segment) {
+            int value;
+            is >> value;
+            symbol = (TapeSymbol)value;
+        }
+    };
+
+    size_t numWindows, numConfigs;
+    if (!(is >> windowSize >> valueBound >> numWindows >> numConfigs)) {
+        return false;
+    }
+    windows.resize(numWindows);
+    for (auto& window : windows) {
+        readSegment(window, windowSize);
+    }
+    configs.resize(numConfigs);
+    for (auto& config : configs) {
+        is >> config.blockIndex;
+        readSegment(config.segment, 2 * windowSize - 1);
+    }
+
+    return static_cast<bool>(is);
+}
+
+void ClosedTapeLanguage::reset(int windowSize, int valueBound) {
+    assert(windowSize > 0 && valueBound >= 0 && valueBound < SCHAR_MAX);
+
+    _windowSize = windowSize;
+    _valueBound = valueBound;
+    _windows.clear();
+    _reversedWindows.clear();
+
+    // The tape is initially empty
+    addWindow(TapeSegment(windowSize, 0));
+}
+
+bool ClosedTapeLanguage::addWindow(const TapeSegment& window) {
+    if (!_windows.insert(window).second) {
+        return false;
+    }
+
+    _reversedWindows.insert(TapeSegment(window.rbegin(), window.rend()));
+    return true;
+}
+
+ClosedTapeConfig ClosedTapeLanguage::initialConfig() const {
+    return ClosedTapeConfig { .blockIndex = 0, .segment = TapeSegment(segmentSize(), 0) };
+}
+
+long ClosedTapeLanguage::lowerBound(TapeSymbol symbol) const {
+    return (symbol < -_valueBound) ? LONG_MIN : symbol;
+}
+
+long ClosedTapeLanguage::upperBound(TapeSymbol symbol) const {
+    return (symbol > _valueBound) ? LONG_MAX : symbol;
+}
+
+void ClosedTapeLanguage::extend(const std::set<TapeSegment>& windows, const TapeSegment& segment,
+                                int amount, std::vector<TapeSegment>& result) {
+    int contextSize = _windowSize - 1;
+
+    // Each step appends a cell and drops the first one. As only the last cells of a segment
+    // determine how it can be extended, equal segments are merged after each step.
+    _frontier.clear();
+    _frontier.insert(segment);
+    while (amount-- > 0) {
+        _nextFrontier.clear();
+        for (auto& current : _frontier) {
+            TapeSegment context(current.end() - contextSize, current.end());
+            for (auto it = windows.lower_bound(context);
+                 it != windows.end() && std::equal(context.begin(), context.end(), it->begin());
+                 ++it) {
+                TapeSegment next(current.begin() + 1, current.end());
+                next.push_back(it->back());
+                _nextFrontier.insert(std::move(next));
+            }
+        }
+        std::swap(_frontier, _nextFrontier);
+    }
+
+    result.insert(result.end(), _frontier.begin(), _frontier.end());
+}
+
+void ClosedTapeLanguage::shift(const TapeSegment& segment, int amount,
+                               std::vector<TapeSegment>& result) {
+    if (amount > 0) {
+        extend(_windows, segment, amount, result);
+    } else {
+        // Extend the mirrored segment, and mirror the results back
+        size_t size = result.size();
+        extend(_reversedWindows, TapeSegment(segment.rbegin(), segment.rend()), -amount, result);
+        for (auto it = result.begin() + size; it != result.end(); ++it) {
+            std::reverse(it->begin(), it->end());
+        }
+    }
+}
+
+bool ClosedTapeLanguage::addSuccessors(const InterpretedProgram& program,
+                                       const ClosedTapeConfig& config,
+                                       std::vector<ClosedTapeConfig>& successors,
+                                       std::vector<TapeSegment>& newWindows) {
+    const ProgramBlock* block = program.programBlockAt(config.blockIndex);
+    if (!block->isFinalized() || block->isExit()) {
+        return false;
+    }
+    if (block->isHang()) {
+        // Execution remains in this block forever
+        return true;
+    }
+
+    int center = _windowSize - 1;
+    int amount = block->getInstructionAmount();
+    std::vector<TapeSegment> segments;
+
+    if (block->isDelta()) {
+        TapeSymbol value = config.segment[center];
+        long low = lowerBound(value) == LONG_MIN ? LONG_MIN : lowerBound(value) + amount;
+        long high = upperBound(value) == LONG_MAX ? LONG_MAX : upperBound(value) + amount;
+
+        // Add all symbols whose values overlap with the possible new values
+        for (int symbol = -_valueBound - 1; symbol <= _valueBound + 1; symbol++) {
+            if (lowerBound(symbol) <= high && low <= upperBound(symbol)) {
+                TapeSegment segment = config.segment;
+                segment[center] = symbol;
+
+                // All windows that contain the modified cell are within the segment
+                for (int i = 0; i < _windowSize; i++) {
+                    newWindows.emplace_back(segment.begin() + i,
+                                            segment.begin() + i + _windowSize);
+                }
+                segments.push_back(std::move(segment));
+            }
+        }
+    } else {
+        shift(config.segment, amount, segments);
+    }
+
+    for (auto& segment : segments) {
+        const ProgramBlock* next = (segment[center] == 0) ? block->zeroBlock()
+                                                          : block->nonZeroBlock();
+        successors.push_back(ClosedTapeConfig {
+            .blockIndex = program.indexOf(next), .segment = std::move(segment)
+        });
+    }
+
+    return true;
+}
+
+bool ClosedTapeDecider::tryProveHang(const InterpretedProgram& program,
+                                     int windowSize, int valueBound) {
+    _language.reset(windowSize, valueBound);
+    _configs.clear();
+    _worklist.clear();
+
+    _worklist.push_back(&*_configs.insert(_language.initialConfig()).first);
+    bool windowsChanged = false;
+    while (!_worklist.empty()) {
+        if (_configs.size() > _settings.maxConfigs
+            || _language.windows().size() > _settings.maxWindows) {
+            return false;
+        }
+
+        const ClosedTapeConfig* config = _worklist.back();
+        _worklist.pop_back();
+
+        _successors.clear();
+        _newWindows.clear();
+        if (!_language.addSuccessors(program, *config, _successors, _newWindows)) {
+            return false;
+        }
+
+        for (auto& window : _newWindows) {
+            windowsChanged |= _language.addWindow(window);
+        }
+        for (auto& successor : _successors) {
+            auto [it, inserted] = _configs.insert(std::move(successor));
+            if (inserted) {
+                _worklist.push_back(&*it);
+            }
+        }
+
+        if (_worklist.empty() && windowsChanged) {
+            // Shifts may have more successors now, so revisit them
+            windowsChanged = false;
+            for (auto& config : _configs) {
+                if (!program.programBlockAt(config.blockIndex)->isDelta()) {
+                    _worklist.push_back(&config);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ClosedTapeDecider::proveHang(const InterpretedProgram& program,
+                                  ClosedTapeCertificate& certificate) {
+    for (int windowSize = 1; windowSize <= _settings.maxWindowSize; windowSize++) {
+        for (int valueBound = 1; valueBound <= _settings.maxValueBound; valueBound++) {
+            if (tryProveHang(program, windowSize, valueBound)) {
+                certificate.windowSize = windowSize;
+                certificate.valueBound = valueBound;
+                certificate.windows.assign(_language.windows().begin(),
+                                           _language.windows().end());
+                certificate.configs.assign(_configs.begin(), _configs.end());
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool verifyClosedTapeCertificate(const InterpretedProgram& program,
+                                 const ClosedTapeCertificate& certificate) {
+    if (certificate.windowSize <= 0 || certificate.valueBound < 0
+        || certificate.valueBound >= SCHAR_MAX) {
+        return false;
+    }
+
+    ClosedTapeLanguage language;
+    language.reset(certificate.windowSize, certificate.valueBound);
+
+    auto isValid = [&](const TapeSegment& segment, int size) {
+        return (segment.size() == size
+                && std::all_of(segment.begin(), segment.end(), [&](TapeSymbol symbol) {
+                    return std::abs(symbol) <= certificate.valueBound + 1;
+                }));
+    };
+
+    for (auto& window : certificate.windows) {
+        if (!isValid(window, language.windowSize())) return false;
+        language.addWindow(window);
+    }
+    if (language.windows().size() != certificate.windows.size()) {
+        // The certificate lacks the empty window
+        return false;
+    }
+
+    std::set<ClosedTapeConfig> configs;
+    for (auto& config : certificate.configs) {
+        if (config.blockIndex < 0 || config.blockIndex >= program.numProgramBlocks()
+            || !isValid(config.segment, language.segmentSize())) {
+            return false;
+        }
+        configs.insert(config);
+    }
+    if (configs.count(language.initialConfig()) == 0) {
+        return false;
+    }
+
+    std::vector<ClosedTapeConfig> successors;
+    std::vector<TapeSegment> newWindows;
+    for (auto& config : configs) {
+        successors.clear();
+        newWindows.clear();
+        if (!language.addSuccessors(program, config, successors, newWindows)) {
+            return false;
+        }
+
+        for (auto& window : newWindows) {
+            if (!language.containsWindow(window)) return false;
+        }
+        for (auto& successor : successors) {
+            if (configs.count(successor) == 0) return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector<ClosedTapeResult> decideClosedTapeHangs(const std::vector<std::string>& programSpecs,
+                                                    ClosedTapeSettings settings, int numThreads) {
+    std::vector<ClosedTapeResult> results(programSpecs.size());
+    std::atomic<size_t> next = 0;
+
+    auto decide = [&]() {
+        ClosedTapeDecider decider(settings);
+        size_t i;
+        while ((i = next++) < programSpecs.size()) {
+            Program program = Program::fromString(programSpecs[i]);
+            auto interpretedProgram = buildInterpretedProgram(program);
+
+            results[i].programSpec = programSpecs[i];
+            results[i].proven = (interpretedProgram
+                                 && decider.proveHang(*interpretedProgram,
+                                                      results[i].certificate));
+        }
+    };
+
+    numThreads = std::max(1, std::min(numThreads, (int)programSpecs.size()));
+    if (numThreads == 1) {
+        decide();
+    } else {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numThreads; i++) {
+            threads.emplace_back(decide);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    return results;
+}
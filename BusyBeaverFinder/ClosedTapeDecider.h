@@ -0,0 +1,141 @@
+//
+//  ClosedTapeDecider.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+class InterpretedProgram;
+
+/* The closed tape decider proves that a program hangs by constructing a regular language of tape
+ * configurations that contains the initial configuration, is closed under the transitions of the
+ * interpreted program, and excludes the exit. It is a variant of the Closed Position Set decider
+ * for Turing Machines.
+ *
+ * The language consists of all tapes whose windows of n consecutive cells are in a finite set.
+ * Next to it, there is a finite set of local configurations: the program block to execute and the
+ * cells within distance n - 1 of the data pointer. As 2L cells are unbounded, values are
+ * abstracted. Values in the range [-K, K] are exact, larger values are represented by K + 1, and
+ * smaller values by -(K + 1).
+ */
+
+// Abstracted data value
+typedef int8_t TapeSymbol;
+// Abstracted data values of consecutive cells
+typedef std::vector<TapeSymbol> TapeSegment;
+
+struct ClosedTapeConfig {
+    int blockIndex;
+    // The cells around the data pointer, which is in the middle
+    TapeSegment segment;
+
+    bool operator<(const ClosedTapeConfig& other) const {
+        return (blockIndex != other.blockIndex
+                ? blockIndex < other.blockIndex : segment < other.segment);
+    }
+};
+
+// The closed language, which proves that the program hangs. It can be verified in a single pass.
+struct ClosedTapeCertificate {
+    // The length of the windows (n)
+    int windowSize;
+    // The largest value that is represented exactly (K)
+    int valueBound;
+
+    std::vector<TapeSegment> windows;
+    std::vector<ClosedTapeConfig> configs;
+
+    void write(std::ostream &os) const;
+    bool read(std::istream &is);
+};
+
+// The abstract transitions of an interpreted program, given a set of windows
+class ClosedTapeLanguage {
+    int _windowSize;
+    int _valueBound;
+
+    std::set<TapeSegment> _windows;
+    // The windows with their cells reversed, for extending segments to the left
+    std::set<TapeSegment> _reversedWindows;
+
+    // Helper buffers for extending segments
+    std::set<TapeSegment> _frontier, _nextFrontier;
+
+    long lowerBound(TapeSymbol symbol) const;
+    long upperBound(TapeSymbol symbol) const;
+
+    void extend(const std::set<TapeSegment>& windows, const TapeSegment& segment, int amount,
+                std::vector<TapeSegment>& result);
+    void shift(const TapeSegment& segment, int amount, std::vector<TapeSegment>& result);
+
+public:
+    void reset(int windowSize, int valueBound);
+
+    int windowSize() const { return _windowSize; }
+    int valueBound() const { return _valueBound; }
+    int segmentSize() const { return 2 * _windowSize - 1; }
+
+    const std::set<TapeSegment>& windows() const { return _windows; }
+    bool containsWindow(const TapeSegment& window) const { return _windows.count(window) > 0; }
+    // Returns true if the window was not yet included
+    bool addWindow(const TapeSegment& window);
+
+    // The configuration where the entry block is about to execute on an empty tape
+    ClosedTapeConfig initialConfig() const;
+
+    // Adds all configurations that can directly follow the given one to successors. It also adds
+    // the windows that contain the data pointer after a delta, as these can be new. Returns false
+    // when the configuration may not hang, i.e. its block is an exit or is not yet finalized.
+    bool addSuccessors(const InterpretedProgram& program, const ClosedTapeConfig& config,
+                       std::vector<ClosedTapeConfig>& successors,
+                       std::vector<TapeSegment>& newWindows);
+};
+
+struct ClosedTapeSettings {
+    // The decider tries all combinations of window size and value bound up to these maximums
+    int maxWindowSize = 3;
+    int maxValueBound = 2;
+
+    // Bounds the time spent on each attempt
+    int maxConfigs = 4000;
+    int maxWindows = 1000;
+};
+
+class ClosedTapeDecider {
+    ClosedTapeSettings _settings;
+    ClosedTapeLanguage _language;
+
+    std::set<ClosedTapeConfig> _configs;
+    std::vector<const ClosedTapeConfig*> _worklist;
+    std::vector<ClosedTapeConfig> _successors;
+    std::vector<TapeSegment> _newWindows;
+
+    bool tryProveHang(const InterpretedProgram& program, int windowSize, int valueBound);
+
+public:
+    ClosedTapeDecider(ClosedTapeSettings settings = {}) : _settings(settings) {}
+
+    // Returns true if it proved that the program hangs. The certificate is then set.
+    bool proveHang(const InterpretedProgram& program, ClosedTapeCertificate& certificate);
+};
+
+// Checks that the certificate describes a closed language that excludes the exit
+bool verifyClosedTapeCertificate(const InterpretedProgram& program,
+                                 const ClosedTapeCertificate& certificate);
+
+struct ClosedTapeResult {
+    std::string programSpec;
+    bool proven;
+    ClosedTapeCertificate certificate;
+};
+
+// Runs the decider on each of the programs, using the given number of threads
+std::vector<ClosedTapeResult> decideClosedTapeHangs(const std::vector<std::string>& programSpecs,
+                                                    ClosedTapeSettings settings, int numThreads);
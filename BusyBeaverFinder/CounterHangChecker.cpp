@@ -0,0 +1,547 @@
+//
+//  CounterHangChecker.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "CounterHangChecker.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+#include "Data.h"
+#include "InterpretedProgram.h"
+
+namespace {
+
+int signOfValue(long value) {
+    return (value > 0) - (value < 0);
+}
+
+template <typename Iterator>
+bool isStationary(Iterator begin, Iterator end) {
+    int dp = 0;
+    for (auto it = begin; it != end; ++it) {
+        if (!(*it)->isDelta()) {
+            dp += (*it)->getInstructionAmount();
+        }
+    }
+
+    return dp == 0;
+}
+
+const ProgramBlock* findBlock(const InterpretedProgram& program, int startIndex) {
+    for (int i = 0; i < program.numProgramBlocks(); i++) {
+        const ProgramBlock* block = program.programBlockAt(i);
+        if (block->getStartIndex() == startIndex) {
+            return block;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace
+
+void CounterCertificate::write(std::ostream &os) const {
+    os << numSteps << " " << segments.size();
+    for (auto& segment : segments) {
+        os << " " << segment.loopExitIndex << " " << segment.blocks.size();
+        for (int block : segment.blocks) {
+            os << " " << block;
+        }
+    }
+    os << " " << minDp << " " << cells.size();
+    for (auto& cell : cells) {
+        os << " " << cell.factor << " " << cell.offset;
+    }
+    os << " " << driverDp << " " << driverSign << std::endl;
+}
+
+bool CounterCertificate::read(std::istream &is) {
+    size_t numSegments, numCells;
+    if (!(is >> numSteps >> numSegments)) {
+        return false;
+    }
+    segments.resize(numSegments);
+    for (auto& segment : segments) {
+        size_t numBlocks;
+        if (!(is >> segment.loopExitIndex >> numBlocks)) {
+            return false;
+        }
+        segment.blocks.resize(numBlocks);
+        for (int& block : segment.blocks) {
+            is >> block;
+        }
+    }
+    if (!(is >> minDp >> numCells)) {
+        return false;
+    }
+    cells.resize(numCells);
+    for (auto& cell : cells) {
+        is >> cell.factor >> cell.offset;
+    }
+
+    return static_cast<bool>(is >> driverDp >> driverSign);
+}
+
+bool CounterHangChecker::init(const MetaLoopAnalysis* metaLoopAnalysis,
+                              const ExecutionState& executionState) {
+    _metaLoopAnalysis = nullptr;
+
+    // Stationary loops are executed symbolically, as their number of iterations only depends on
+    // the value of their loop counter. There should be at least one of these. Other loops are
+    // executed block by block, so should have a fixed number of iterations.
+    auto& loopBehaviors = metaLoopAnalysis->loopBehaviors();
+    auto anchorLoop = std::find_if(loopBehaviors.begin(), loopBehaviors.end(),
+                                   [](auto& behavior) {
+        return behavior.loopAnalysis()->dataPointerDelta() == 0;
+    });
+    if (anchorLoop == loopBehaviors.end()) {
+        return false;
+    }
+
+    _metaLoopAnalysis = metaLoopAnalysis;
+    _anchorRunBlockIndex = metaLoopAnalysis->firstRunBlockIndex() + anchorLoop->sequenceIndex();
+    _hasSnapshot = false;
+    _numFailedAttempts = 0;
+
+    return true;
+}
+
+int CounterHangChecker::valueAt(const Snapshot& snapshot, int dpOffset) const {
+    return snapshot.values[dpOffset + maxWindowRadius];
+}
+
+void CounterHangChecker::takeSnapshot(const ExecutionState& executionState,
+                                      Snapshot& snapshot) const {
+    auto& data = executionState.getData();
+
+    snapshot.historySize = (int)executionState.getRunHistory().size();
+    snapshot.values.clear();
+    for (int dpOffset = -maxWindowRadius; dpOffset <= maxWindowRadius; dpOffset++) {
+        snapshot.values.push_back(data.valueAt(dpOffset));
+    }
+}
+
+void CounterHangChecker::setSegments(const ExecutionState& executionState) {
+    auto& runSummary = executionState.getRunSummary();
+    auto& runHistory = executionState.getRunHistory();
+    int numRunBlocks = runSummary.getNumRunBlocks();
+
+    _numSegments = _metaLoopAnalysis->loopSize();
+    if (_segments.size() < _numSegments) {
+        _segments.resize(_numSegments);
+    }
+
+    for (int i = 0; i < _numSegments; i++) {
+        int runBlockIndex = numRunBlocks - _numSegments + i;
+        auto runBlock = runSummary.runBlockAt(runBlockIndex);
+        int endIndex = (runBlockIndex + 1 < numRunBlocks
+                        ? runSummary.runBlockAt(runBlockIndex + 1)->getStartIndex()
+                        : (int)runHistory.size());
+        auto begin = &runHistory[runBlock->getStartIndex()];
+        auto end = begin + (endIndex - runBlock->getStartIndex());
+        Segment& segment = _segments[i];
+
+        // Only stationary loops are executed symbolically, other loops are unrolled
+        int period = runBlock->isLoop() ? runBlock->getLoopPeriod() : 0;
+        if (period > 0 && end - begin >= period && isStationary(begin, begin + period)) {
+            segment.blocks.assign(begin, begin + period);
+            segment.loopExitIndex = (int)((end - 1 - begin) % period);
+        } else {
+            segment.blocks.assign(begin, end);
+            segment.loopExitIndex = -1;
+        }
+    }
+}
+
+bool CounterHangChecker::determineRange() {
+    int dp = 0;
+
+    _minDp = 0;
+    _maxDp = 0;
+    auto shift = [this](const ProgramBlock* block, int& dp) {
+        if (!block->isDelta()) {
+            dp += block->getInstructionAmount();
+            _minDp = std::min(_minDp, dp);
+            _maxDp = std::max(_maxDp, dp);
+        }
+        return -_minDp <= maxWindowRadius && _maxDp <= maxWindowRadius;
+    };
+
+    for (int i = 0; i < _numSegments; i++) {
+        const Segment& segment = _segments[i];
+        if (segment.loopExitIndex >= 0) {
+            int loopDp = dp;
+            for (int k = 0; k < segment.blocks.size(); k++) {
+                if (!shift(segment.blocks[k], loopDp)) {
+                    return false;
+                }
+                if (k == segment.loopExitIndex) {
+                    dp = loopDp;
+                }
+            }
+        } else {
+            for (const ProgramBlock* block : segment.blocks) {
+                if (!shift(block, dp)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    _dpShift = dp;
+
+    return true;
+}
+
+bool CounterHangChecker::fitTemplate(const Snapshot& previous, const Snapshot& current) {
+    // The cell that changed least determines t, as the changes of all other cells should be a
+    // multiple of its change
+    int minDelta = 0;
+    for (int dp = _minDp; dp <= _maxDp; dp++) {
+        int delta = valueAt(current, dp) - valueAt(previous, dp);
+        if (delta != 0 && (minDelta == 0 || abs(delta) < abs(minDelta))) {
+            minDelta = delta;
+            _driverDp = dp;
+        }
+    }
+    if (minDelta == 0) {
+        // The data does not change, which is a periodic hang
+        return false;
+    }
+
+    _driverSign = signOfValue(minDelta);
+    _t = _driverSign * valueAt(current, _driverDp);
+    int deltaT = abs(minDelta);
+
+    _template.clear();
+    for (int dp = _minDp; dp <= _maxDp; dp++) {
+        int delta = valueAt(current, dp) - valueAt(previous, dp);
+        if (delta % deltaT != 0) {
+            return false;
+        }
+
+        long factor = delta / deltaT;
+        _template.push_back(Affine { .factor = factor,
+                                     .offset = valueAt(current, dp) - factor * _t });
+    }
+
+    return true;
+}
+
+int CounterHangChecker::signOf(const Affine& value) const {
+    if (value.factor == 0) {
+        return signOfValue(value.offset);
+    }
+
+    // The value is monotonic in t, so its sign is constant when it moves away from zero
+    int sign = signOfValue(value.at(_t));
+    return (sign == signOfValue(value.factor)) ? sign : 2;
+}
+
+bool CounterHangChecker::checkBranch(const ProgramBlock* block, const ProgramBlock* next, int dp) {
+    if (block->zeroBlock() == next && block->nonZeroBlock() == next) {
+        return true;
+    }
+
+    int sign = signOf(cellAt(dp));
+    if (block->zeroBlock() == next) {
+        return sign == 0;
+    }
+    if (block->nonZeroBlock() == next) {
+        return sign == 1 || sign == -1;
+    }
+
+    return false;
+}
+
+bool CounterHangChecker::executeSequence(const Segment& segment, const ProgramBlock* next,
+                                         int& dp) {
+    auto& blocks = segment.blocks;
+    for (int i = 0; i < blocks.size(); i++) {
+        const ProgramBlock* block = blocks[i];
+        if (block->isDelta()) {
+            cellAt(dp).offset += block->getInstructionAmount();
+        } else {
+            dp += block->getInstructionAmount();
+        }
+
+        if (!checkBranch(block, i + 1 < blocks.size() ? blocks[i + 1] : next, dp)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CounterHangChecker::executeLoop(const Segment& segment, int& dp,
+                                     const ProgramBlock*& exitBlock) {
+    auto& blocks = segment.blocks;
+    int period = (int)blocks.size();
+    int exitIndex = segment.loopExitIndex;
+
+    // Determine the effect of a single iteration, and the partial effects within an iteration
+    _loopDeltas.assign(_cells.size(), 0);
+    _dpAt.clear();
+    _partialDeltaAt.clear();
+    int loopDp = dp;
+    for (int k = 0; k < period; k++) {
+        const ProgramBlock* block = blocks[k];
+        if (block->isDelta()) {
+            _loopDeltas[loopDp - _minDp] += block->getInstructionAmount();
+        } else {
+            loopDp += block->getInstructionAmount();
+        }
+        _dpAt.push_back(loopDp);
+        _partialDeltaAt.push_back(_loopDeltas[loopDp - _minDp]);
+
+        if (k == exitIndex) {
+            _exitDeltas = _loopDeltas;
+        }
+    }
+
+    // The loop should only exit at the exit instruction, when its counter reaches zero
+    const ProgramBlock* exitInstruction = blocks[exitIndex];
+    const ProgramBlock* continueBlock = blocks[(exitIndex + 1) % period];
+    if (exitInstruction->nonZeroBlock() != continueBlock
+        || exitInstruction->zeroBlock() == continueBlock) {
+        return false;
+    }
+
+    // Determine the number of full iterations n before the loop exits
+    int counterDp = _dpAt[exitIndex];
+    Affine counter = cellAt(counterDp);
+    counter.offset += _partialDeltaAt[exitIndex];
+    long delta = _loopDeltas[counterDp - _minDp];
+    Affine n = { .factor = 0, .offset = 0 };
+    if (delta == 0) {
+        if (!counter.isZero()) {
+            return false;
+        }
+    } else {
+        if (counter.factor % delta != 0 || counter.offset % delta != 0) {
+            return false;
+        }
+        n = Affine { .factor = -counter.factor / delta, .offset = -counter.offset / delta };
+        if (n.factor < 0 || n.at(_t) < 0) {
+            return false;
+        }
+    }
+
+    // All other instructions should continue the loop. As values change linearly with each
+    // iteration, it suffices to check the first and last iteration.
+    for (int k = 0; k < period; k++) {
+        const ProgramBlock* block = blocks[k];
+        const ProgramBlock* next = blocks[(k + 1) % period];
+        if (k == exitIndex || (block->zeroBlock() == next && block->nonZeroBlock() == next)) {
+            continue;
+        }
+
+        Affine lastIteration = n;
+        if (k > exitIndex) {
+            // The instruction is not executed in the last iteration
+            if (n.isZero()) {
+                continue;
+            }
+            if (n.at(_t) < 1) {
+                return false;
+            }
+            lastIteration.offset -= 1;
+        }
+
+        long kDelta = _loopDeltas[_dpAt[k] - _minDp];
+        Affine first = cellAt(_dpAt[k]);
+        first.offset += _partialDeltaAt[k];
+        Affine last = { .factor = first.factor + lastIteration.factor * kDelta,
+                        .offset = first.offset + lastIteration.offset * kDelta };
+
+        int sign = signOf(first);
+        if (signOf(last) != sign) {
+            return false;
+        }
+        if (block->zeroBlock() == next ? sign != 0 : (block->nonZeroBlock() != next
+                                                      || (sign != 1 && sign != -1))) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < _cells.size(); i++) {
+        _cells[i].factor += n.factor * _loopDeltas[i];
+        _cells[i].offset += n.offset * _loopDeltas[i] + _exitDeltas[i];
+    }
+    dp = counterDp;
+    exitBlock = exitInstruction->zeroBlock();
+
+    return true;
+}
+
+bool CounterHangChecker::executeIteration() {
+    int dp = 0;
+
+    _cells = _template;
+    for (int i = 0; i < _numSegments; i++) {
+        const Segment& segment = _segments[i];
+
+        // After the last segment, the next iteration of the meta-loop should start
+        const ProgramBlock* next = _segments[(i + 1) % _numSegments].blocks[0];
+
+        if (segment.loopExitIndex >= 0) {
+            const ProgramBlock* exitBlock;
+            if (!executeLoop(segment, dp, exitBlock) || exitBlock != next) {
+                return false;
+            }
+        } else if (!executeSequence(segment, next, dp)) {
+            return false;
+        }
+    }
+    assert(dp == _dpShift);
+
+    return true;
+}
+
+bool CounterHangChecker::checkClosure() {
+    auto inRange = [this](int dp) { return dp >= _minDp && dp <= _maxDp; };
+
+    // Determine t for the next iteration
+    if (!inRange(_driverDp + _dpShift)) {
+        return false;
+    }
+    const Affine& driver = cellAt(_driverDp + _dpShift);
+    long a = _driverSign * driver.factor;
+    long b = _driverSign * driver.offset;
+    if (a < 0 || a * _t + b < _t) {
+        // The next value of t should remain in the range for which the iteration is proven
+        return false;
+    }
+
+    // The data should match the template for the next value of t
+    for (int dp = _minDp; dp <= _maxDp; dp++) {
+        const Affine& expected = _template[dp - _minDp];
+        if (inRange(dp + _dpShift)) {
+            const Affine& actual = cellAt(dp + _dpShift);
+            if (actual.factor != expected.factor * a
+                || actual.offset != expected.factor * b + expected.offset) {
+                return false;
+            }
+        } else if (!expected.isZero()) {
+            // The cell is not yet visited, so is zero
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CounterHangChecker::checkZerosAhead(const Data& data) const {
+    if (_dpShift == 0) {
+        return true;
+    }
+
+    DataPointer dp = data.getDataPointer();
+    return (_dpShift > 0
+            ? data.onlyZerosAhead(dp + _maxDp, true)
+            : data.onlyZerosAhead(dp + _minDp, false));
+}
+
+Trilian CounterHangChecker::proofHang(const ExecutionState& executionState) {
+    // The first loop of the meta-loop should just have finished
+    auto& runSummary = executionState.getRunSummary();
+    int loopSize = _metaLoopAnalysis->loopSize();
+    if (executionState.getLoopRunState() != LoopRunState::ENDED
+        || (runSummary.getNumRunBlocks() - _anchorRunBlockIndex) % loopSize != 1) {
+        return Trilian::MAYBE;
+    }
+
+    std::swap(_previous, _current);
+    takeSnapshot(executionState, _current);
+    bool hadSnapshot = _hasSnapshot;
+    _hasSnapshot = true;
+
+    int numRunBlocks = runSummary.getNumRunBlocks();
+    int startIndex = runSummary.runBlockAt(numRunBlocks - loopSize)->getStartIndex();
+    if (!hadSnapshot || _previous.historySize != startIndex) {
+        // The snapshots should be of consecutive iterations
+        return Trilian::MAYBE;
+    }
+
+    setSegments(executionState);
+    if (!determineRange()) {
+        return Trilian::NO;
+    }
+
+    if (fitTemplate(_previous, _current)
+        && executeIteration()
+        && checkClosure()
+        && checkZerosAhead(executionState.getData())) {
+        _proofSteps = executionState.numSteps();
+        return Trilian::YES;
+    }
+
+    return (++_numFailedAttempts < maxFailedAttempts) ? Trilian::MAYBE : Trilian::NO;
+}
+
+void CounterHangChecker::getCertificate(CounterCertificate& certificate) const {
+    certificate.numSteps = _proofSteps;
+    certificate.segments.resize(_numSegments);
+    for (int i = 0; i < _numSegments; i++) {
+        auto& segment = _segments[i];
+        certificate.segments[i].loopExitIndex = segment.loopExitIndex;
+        certificate.segments[i].blocks.clear();
+        for (const ProgramBlock* block : segment.blocks) {
+            certificate.segments[i].blocks.push_back(block->getStartIndex());
+        }
+    }
+    certificate.minDp = _minDp;
+    certificate.cells = _template;
+    certificate.driverDp = _driverDp;
+    certificate.driverSign = _driverSign;
+}
+
+bool CounterHangChecker::checkInduction(const InterpretedProgram& program,
+                                        const CounterCertificate& certificate, long minT) {
+    _numSegments = (int)certificate.segments.size();
+    if (_numSegments == 0) {
+        return false;
+    }
+    if (_segments.size() < _numSegments) {
+        _segments.resize(_numSegments);
+    }
+    for (int i = 0; i < _numSegments; i++) {
+        auto& source = certificate.segments[i];
+        Segment& segment = _segments[i];
+        segment.blocks.clear();
+        for (int startIndex : source.blocks) {
+            const ProgramBlock* block = findBlock(program, startIndex);
+            if (!block || !block->isFinalized() || block->isExit() || block->isHang()) {
+                return false;
+            }
+            segment.blocks.push_back(block);
+        }
+        segment.loopExitIndex = source.loopExitIndex;
+
+        if (segment.blocks.empty() || segment.loopExitIndex >= (int)segment.blocks.size()
+            || segment.loopExitIndex < -1
+            || (segment.loopExitIndex >= 0
+                && !isStationary(segment.blocks.begin(), segment.blocks.end()))) {
+            return false;
+        }
+    }
+
+    if (!determineRange()
+        || _minDp != certificate.minDp || _maxDp - _minDp + 1 != certificate.cells.size()
+        || certificate.driverDp < _minDp || certificate.driverDp > _maxDp
+        || (certificate.driverSign != 1 && certificate.driverSign != -1)) {
+        return false;
+    }
+    _template = certificate.cells;
+    _driverDp = certificate.driverDp;
+    _driverSign = certificate.driverSign;
+    _t = minT;
+
+    return executeIteration() && checkClosure();
+}
@@ -0,0 +1,156 @@
+//
+//  CounterHangChecker.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "HangChecker.h"
+#include "MetaLoopAnalysis.h"
+
+class InterpretedProgram;
+
+// Value of the form factor * t + offset
+struct Affine {
+    long factor;
+    long offset;
+
+    bool isZero() const { return factor == 0 && offset == 0; }
+    long at(long t) const { return factor * t + offset; }
+};
+
+// A part of an iteration of a meta-loop, whose blocks are identified by their start index.
+struct CounterSegment {
+    std::vector<int> blocks;
+    // The index in blocks of the instruction where the loop exits. It is -1 for a sequence.
+    int loopExitIndex;
+};
+
+/* The proof of a counter hang. After numSteps the data around DP matches the template for some
+ * t = T. The iteration maps each state that matches the template for a t >= T to one that matches
+ * it for a t' >= T.
+ */
+struct CounterCertificate {
+    long numSteps;
+    std::vector<CounterSegment> segments;
+
+    // The template of the cells at DP offsets [minDp, minDp + cells.size())
+    int minDp;
+    std::vector<Affine> cells;
+    // The cell that defines t, which is its value times driverSign
+    int driverDp, driverSign;
+
+    void write(std::ostream& os) const;
+    bool read(std::istream& is);
+};
+
+/* Checks hangs of meta-loops whose loop iteration counts follow an affine recurrence. Examples are
+ * exponential counters, where counters are doubled each meta-loop iteration, and slow gliders
+ * whose counters are tripled at each step.
+ *
+ * Each iteration of the meta-loop, the data around DP is captured. From two consecutive snapshots
+ * it derives a template where each cell is an affine function of a single parameter t. It then
+ * symbolically executes one iteration of the meta-loop for all t >= T, where T is the current
+ * value. Stationary loops are executed in one go, other loops block by block. When all branches
+ * go the same way for all t and the resulting data matches the template for t' = a * t + b, with
+ * t' >= T, the program hangs by induction.
+ *
+ * Binary counters are not supported, as their carry loops do not have a single loop counter.
+ */
+class CounterHangChecker : public HangChecker {
+    // A part of an iteration of the meta-loop. Either a stationary loop, which is executed
+    // symbolically, or a sequence of blocks, which are executed one by one.
+    struct Segment {
+        std::vector<const ProgramBlock*> blocks;
+        // The index in blocks of the instruction where the loop exits. It is -1 for a sequence.
+        int loopExitIndex;
+    };
+
+    // The data around DP at the end of an iteration of the meta-loop
+    struct Snapshot {
+        // The size of the run history at the time of the snapshot
+        int historySize;
+        // The values at DP offsets [-maxWindowRadius, maxWindowRadius]
+        std::vector<int> values;
+    };
+
+    const MetaLoopAnalysis* _metaLoopAnalysis;
+
+    // The run block index of the first loop in the meta-loop
+    int _anchorRunBlockIndex;
+
+    Snapshot _previous, _current;
+    bool _hasSnapshot;
+    int _numFailedAttempts;
+
+    // The last iteration of the meta-loop
+    std::vector<Segment> _segments;
+    int _numSegments;
+
+    // The DP range accessed by an iteration of the meta-loop, and the DP shift it causes
+    int _minDp, _maxDp, _dpShift;
+
+    // The template value for each DP offset in [_minDp, _maxDp]
+    std::vector<Affine> _template;
+    // The cell that defines t, which is its value times _driverSign
+    int _driverDp, _driverSign;
+    // The current value of the template parameter
+    long _t;
+    // The number of steps when the hang was proven
+    long _proofSteps;
+
+    // The symbolic values during execution
+    std::vector<Affine> _cells;
+    // Helper buffers for symbolically executing loops. The deltas are indexed like the cells.
+    std::vector<int> _loopDeltas, _exitDeltas;
+    std::vector<int> _dpAt, _partialDeltaAt;
+
+    Affine& cellAt(int dpOffset) { return _cells[dpOffset - _minDp]; }
+    int valueAt(const Snapshot& snapshot, int dpOffset) const;
+
+    void takeSnapshot(const ExecutionState& executionState, Snapshot& snapshot) const;
+
+    void setSegments(const ExecutionState& executionState);
+    // Determines the DP range of the iteration. Fails when the range is too large.
+    bool determineRange();
+    bool fitTemplate(const Snapshot& previous, const Snapshot& current);
+
+    // Returns the sign of the value for all t >= _t. Returns zero when it is zero for all t and
+    // two when its sign is not constant.
+    int signOf(const Affine& value) const;
+    bool checkBranch(const ProgramBlock* block, const ProgramBlock* next, int dp);
+
+    bool executeSequence(const Segment& segment, const ProgramBlock* next, int& dp);
+    bool executeLoop(const Segment& segment, int& dp, const ProgramBlock*& exitBlock);
+    bool executeIteration();
+    // Checks that the iteration maps the template onto itself
+    bool checkClosure();
+    // Checks that the data beyond the window that the next iterations visit is zero
+    bool checkZerosAhead(const Data& data) const;
+
+public:
+    static const int maxWindowRadius = 16;
+    // The number of iterations where a proof may fail before the checker gives up. Failures can
+    // be caused by behavior that is not yet regular.
+    static const int maxFailedAttempts = 3;
+
+    bool init(const MetaLoopAnalysis* metaLoopAnalysis, const ExecutionState& executionState);
+
+    Trilian proofHang(const ExecutionState& executionState) override;
+
+    // Sets the certificate of the last proven hang
+    void getCertificate(CounterCertificate& certificate) const;
+
+    // The DP shift of the meta-loop iteration
+    int dpShift() const { return _dpShift; }
+
+    // Checks the induction step of the certificate for all t >= minT. The state at the start of
+    // the induction should be checked separately.
+    bool checkInduction(const InterpretedProgram& program, const CounterCertificate& certificate,
+                        long minT);
+};
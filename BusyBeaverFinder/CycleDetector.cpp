@@ -0,0 +1,70 @@
+//
+//  CycleDetector.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "CycleDetector.h"
+
+#include <algorithm>
+
+namespace {
+
+// Shrinks the range so that it starts and ends with a non-zero value. It is empty when all values
+// are zero.
+template <typename Cell>
+void trimZeros(const Cell*& begin, const Cell*& end) {
+    while (begin < end && *begin == 0) begin++;
+    while (end > begin && *(end - 1) == 0) end--;
+}
+
+}
+
+void CycleDetector::reset() {
+    _power = 1;
+    _lambda = 0;
+    _savedBlock = nullptr;
+    _savedFingerprint = 0;
+    _savedData.clear();
+    _savedDataPointer = 0;
+}
+
+template <typename Cell>
+void CycleDetector::saveState(const ProgramBlock* block, uint64_t fingerprint,
+                              const Cell* begin, const Cell* end, const Cell* dataP) {
+    trimZeros(begin, end);
+
+    _savedBlock = block;
+    _savedFingerprint = fingerprint;
+    _savedData.assign(begin, end);
+    _savedDataPointer = dataP - begin;
+}
+
+template <typename Cell>
+bool CycleDetector::equalsSavedState(const Cell* begin, const Cell* end,
+                                     const Cell* dataP) const {
+    trimZeros(begin, end);
+
+    if (static_cast<size_t>(end - begin) != _savedData.size()) {
+        return false;
+    }
+
+    // Without non-zero values the position of the data pointer is irrelevant
+    return (_savedData.empty()
+            || (dataP - begin == _savedDataPointer
+                && std::equal(begin, end, _savedData.begin())));
+}
+
+template void CycleDetector::saveState(const ProgramBlock*, uint64_t,
+                                       const int*, const int*, const int*);
+template void CycleDetector::saveState(const ProgramBlock*, uint64_t,
+                                       const int16_t*, const int16_t*, const int16_t*);
+template void CycleDetector::saveState(const ProgramBlock*, uint64_t,
+                                       const int8_t*, const int8_t*, const int8_t*);
+template bool CycleDetector::equalsSavedState(const int*, const int*, const int*) const;
+template bool CycleDetector::equalsSavedState(const int16_t*, const int16_t*,
+                                              const int16_t*) const;
+template bool CycleDetector::equalsSavedState(const int8_t*, const int8_t*,
+                                              const int8_t*) const;
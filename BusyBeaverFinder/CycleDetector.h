@@ -0,0 +1,144 @@
+//
+//  CycleDetector.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+class ProgramBlock;
+
+// Returns the multiplicative inverse modulo 2^64 of the given odd number
+constexpr uint64_t multiplicativeInverse(uint64_t x) {
+    // Newton iteration doubles the number of correct low bits each step. As x*x = 1 (mod 8) for
+    // odd x, x is its own inverse for the lowest three bits.
+    uint64_t y = x;
+    for (int i = 0; i < 5; i++) {
+        y *= 2 - x * y;
+    }
+    return y;
+}
+
+/* Fingerprint of the non-zero values on a data tape, relative to the data pointer. Each value is
+ * hashed (Zobrist-style) and weighted by a power of a constant that depends on its position. As
+ * the weight of each position is a power of the same constant, moving the data pointer only
+ * rescales the fingerprint. So it is updated in constant time, both when a value changes and when
+ * the data pointer moves.
+ */
+class TapeFingerprint {
+    // The odd base of the position weights, and its multiplicative inverse (modulo 2^64)
+    static constexpr uint64_t base = 0x9E3779B97F4A7C15ull;
+    static constexpr uint64_t inverseBase = multiplicativeInverse(base);
+    static_assert(base * inverseBase == 1);
+
+    // The sum of the keys of all values times the weight of their position
+    uint64_t _hash;
+    // The weight of the position of the data pointer, and its inverse
+    uint64_t _weight;
+    uint64_t _inverseWeight;
+
+    // Key of the value. It is zero for zero, so that zero-valued cells do not contribute.
+    static uint64_t key(int value) { return mix(value) - mix(0); }
+
+    static uint64_t mix(int value) {
+        // Finalizer of SplitMix64
+        uint64_t z = static_cast<uint64_t>(static_cast<int64_t>(value)) + 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+public:
+    TapeFingerprint() { reset(); }
+
+    void reset() {
+        _hash = 0;
+        _weight = 1;
+        _inverseWeight = 1;
+    }
+
+    // Should be invoked when the value at the data pointer changes
+    void change(int oldValue, int newValue) {
+        _hash += (key(newValue) - key(oldValue)) * _weight;
+    }
+
+    // Should be invoked when the data pointer moves
+    void shift(int amount) {
+        for (; amount > 0; amount--) {
+            _weight *= base;
+            _inverseWeight *= inverseBase;
+        }
+        for (; amount < 0; amount++) {
+            _weight *= inverseBase;
+            _inverseWeight *= base;
+        }
+    }
+
+    // The fingerprint relative to the data pointer. It is the same for tapes that only differ by a
+    // translation.
+    uint64_t value() const { return _hash * _inverseWeight; }
+};
+
+/* Detects when the execution state repeats, using Brent's cycle detection algorithm. The state
+ * consists of the program block and the non-zero data values relative to the data pointer. A
+ * repeated state implies that the program hangs, either in place or as it travels along the tape.
+ *
+ * The state is saved at exponentially increasing intervals. Each update only compares the
+ * fingerprint of the current state with that of the saved state. Only when these match, the data
+ * is compared exactly.
+ */
+class CycleDetector {
+    // The number of updates before the state is saved again, and the number since it was saved
+    long _power;
+    long _lambda;
+
+    const ProgramBlock* _savedBlock;
+    uint64_t _savedFingerprint;
+    // The non-zero data window, and the position of the data pointer relative to its start
+    std::vector<int> _savedData;
+    long _savedDataPointer;
+
+    long _numComparisons {};
+
+    template <typename Cell>
+    void saveState(const ProgramBlock* block, uint64_t fingerprint,
+                   const Cell* begin, const Cell* end, const Cell* dataP);
+    template <typename Cell>
+    bool equalsSavedState(const Cell* begin, const Cell* end, const Cell* dataP) const;
+
+public:
+    CycleDetector() { reset(); }
+
+    void reset();
+
+    // Should be invoked after each executed program block, with the next block to execute. The
+    // data range should include all non-zero values and may include zeros. Returns true when the
+    // current state equals an earlier state, apart from a possible translation.
+    template <typename Cell>
+    bool update(const ProgramBlock* block, uint64_t fingerprint,
+                const Cell* begin, const Cell* end, const Cell* dataP) {
+        bool repeated = false;
+        if (block == _savedBlock && fingerprint == _savedFingerprint) {
+            _numComparisons++;
+            repeated = equalsSavedState(begin, end, dataP);
+        }
+
+        if (++_lambda == _power) {
+            saveState(block, fingerprint, begin, end, dataP);
+            _power *= 2;
+            _lambda = 0;
+        }
+
+        return repeated;
+    }
+
+    // The number of times the data needed to be compared exactly
+    long numComparisons() const { return _numComparisons; }
+
+    // The number of updates since the state was saved. It is zero when the last update saved it.
+    long numUpdatesSinceSave() const { return _lambda; }
+};
@@ -0,0 +1,55 @@
+//
+//  CycleHangDetector.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "CycleHangDetector.h"
+
+#include "HangCertificate.h"
+
+void CycleHangDetector::reset() {
+    HangDetector::reset();
+
+    _cycleDetector.reset();
+    _savedSteps = 0;
+}
+
+bool CycleHangDetector::checkBlock(const ProgramBlock* block) {
+    const Data& data = _execution.getData();
+    long numComparisons = _cycleDetector.numComparisons();
+    long numSteps = _execution.numSteps();
+
+    bool repeated = _cycleDetector.update(block, data.getFingerprint(),
+                                          data.getMinBoundP(), data.getMaxBoundP() + 1,
+                                          data.getDataPointer());
+    if (repeated) {
+        _cycleStart = _savedSteps;
+        _cyclePeriod = numSteps - _savedSteps;
+    }
+    if (_cycleDetector.numUpdatesSinceSave() == 0) {
+        _savedSteps = numSteps;
+    }
+
+    _blockStats.numInvocations++;
+    if (_cycleDetector.numComparisons() != numComparisons) {
+        _blockStats.numProofAttempts++;
+        _blockStats.numProofsYes += repeated;
+        _blockStats.numProofsNo += !repeated;
+    }
+
+    return repeated;
+}
+
+bool CycleHangDetector::getCertificate(HangCertificate& certificate) const {
+    certificate.type = CertificateType::CYCLE;
+    certificate.cycle = CycleCertificate { .numSteps = _cycleStart, .period = _cyclePeriod };
+
+    return true;
+}
+
+void CycleHangDetector::dump() const {
+    std::cout << "CycleHangDetector" << std::endl;
+}
@@ -0,0 +1,39 @@
+//
+//  CycleHangDetector.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include "HangDetector.h"
+
+#include "CycleDetector.h"
+
+/* Detects hangs where the execution state repeats exactly, possibly translated along the tape. This
+ * is cheap to check after each block, as it only compares fingerprints of the state, which the
+ * data maintains incrementally.
+ */
+class CycleHangDetector : public BlockHangDetector {
+    CycleDetector _cycleDetector;
+
+    // The number of steps when the cycle detector last saved the state, and the cycle that was
+    // detected
+    long _savedSteps;
+    long _cycleStart, _cyclePeriod;
+
+public:
+    CycleHangDetector(const ExecutionState& execution) : BlockHangDetector(execution) {}
+
+    HangType hangType() const override { return HangType::PERIODIC; }
+    const char* name() const override { return "Cycle"; }
+
+    void reset() override;
+
+    bool checkBlock(const ProgramBlock* block) override;
+
+    bool getCertificate(HangCertificate& certificate) const override;
+
+    void dump() const override;
+};
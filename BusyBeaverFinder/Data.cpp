@@ -34,6 +34,7 @@ void Data::resetPointers() {
     _dataP = _midDataP;
     _minBoundP = _midDataP;
     _maxBoundP = _minBoundP - 1; // Empty bounds
+    _fingerprint.reset();
 }
 
 void Data::reset() {
@@ -79,6 +80,7 @@ bool Data::onlyZerosAhead(DataPointer dp, bool atRight) const {
 }
 
 void Data::delta(int delta) {
+    _fingerprint.change(*_dataP, *_dataP + delta);
     (*_dataP) += delta;
     if (_undoEnabled) _undoStack.push_back(delta << 1 | (int8_t)DataOp::DELTA);
     updateBounds();
@@ -86,6 +88,7 @@ void Data::delta(int delta) {
 
 bool Data::shift(int shift) {
     _dataP += shift;
+    _fingerprint.shift(shift);
     if (_undoEnabled) _undoStack.push_back(shift << 1 | (int8_t)DataOp::SHIFT);
     return _dataP > _minDataP && _dataP < _maxDataP;
 }
@@ -98,7 +101,9 @@ void Data::undo(size_t targetSize) {
         _undoStack.pop_back();
         if (undo & (int8_t)DataOp::SHIFT) {
             _dataP -= (undo >> 1);
+            _fingerprint.shift(-(undo >> 1));
         } else {
+            _fingerprint.change(*_dataP, *_dataP - (undo >> 1));
             (*_dataP) -= (undo >> 1);
             updateBounds();
         }
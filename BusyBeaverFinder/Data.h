@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <vector>
 
+#include "CycleDetector.h"
 #include "Types.h"
 
 class Data {
@@ -21,6 +22,9 @@ class Data {
 
     std::vector<int> _data;
 
+    // Incrementally updated fingerprint of the non-zero data, relative to DP
+    TapeFingerprint _fingerprint;
+
     bool _undoEnabled {true};
     std::vector<int8_t> _undoStack;
 
@@ -57,6 +61,10 @@ public:
 
     int valueAt(int dpOffset) const { return valueAt(_dataP, dpOffset); }
 
+    // Returns a fingerprint of the data relative to DP. It is the same for data that only differs
+    // by a translation (and very likely different otherwise).
+    uint64_t getFingerprint() const { return _fingerprint.value(); }
+
     bool onlyZerosAhead(DataPointer dp, bool atRight) const;
 
     void delta(int delta);
@@ -11,34 +11,64 @@
 #include <iostream>
 #include <sstream>
 #include <assert.h>
+#include <map>
 
+#include "HangCertificate.h"
+#include "HangDetector.h"
 #include "Utils.h"
 
 Ins validInstructions[] = { Ins::NOOP, Ins::DATA, Ins::TURN };
 
+// Weights used to score partial programs, relative to the number of steps
+constexpr int dataSpanWeight = 4;
+constexpr int loopGrowthWeight = 8;
+
 Ins targetStack[] = {
     Ins::DATA, Ins::TURN, Ins::DATA, Ins::DATA, Ins::TURN, Ins::NOOP, Ins::NOOP, Ins::DATA,
     Ins::TURN, Ins::DATA, Ins::TURN, Ins::DATA, Ins::TURN, Ins::NOOP, Ins::TURN, Ins::DATA,
     Ins::DATA, Ins::NOOP, Ins::NOOP, Ins::TURN, Ins::TURN, Ins::NOOP, Ins::TURN, Ins::UNSET
 };
 
-ExhaustiveSearcher::ExhaustiveSearcher(SearchSettings settings) :
+template <int maxProgramSize, int programWidth>
+BasicExhaustiveSearcher<maxProgramSize, programWidth>::BasicExhaustiveSearcher(
+    SearchSettings settings
+) :
     _settings(settings),
     _program(settings.size),
-    _programBuilder(std::make_shared<InterpretedProgramBuilder>()),
+    _programBuilder(std::make_shared<ProgramBuilder>()),
     _exitFinder(_program, *_programBuilder),
+    _transpositionTable(settings.transpositionTableSize),
     _hangExecutor(settings.dataSize, settings.maxHangDetectionSteps),
     _fastExecutor(settings.dataSize)
 {
+    assert(ProgramBuilder::supportsSize(settings.size));
+    assert(programWidth == 0 || programWidth == settings.size.width);
+
     _fastExecutor.setMaxSteps(_settings.maxSteps);
+    _fastExecutor.setCellWidth(_settings.fastExecCellWidth);
+    _fastExecutor.setDetectCycles(_settings.fastExecCycleDetection);
+    _fastExecutor.setSampleCycles(_settings.fastExecCycleSampling);
     _hangExecutor.setMaxSteps(_settings.maxSearchSteps);
     _hangExecutor.addDefaultHangDetectors();
+    _hangExecutor.setMeasureDetectorTime(_settings.profileHangDetection);
+
+    if (_settings.testHangDetection && _settings.numVerificationThreads > 0) {
+        _verificationPool = std::make_unique<HangVerificationPool>(
+            _settings, _settings.numVerificationThreads);
+    }
+
+    if (_settings.subTreeProfileDepth > 0) {
+        _profiler = std::make_unique<SubTreeProfiler>(_settings.subTreeProfileDepth);
+    }
 
     // Set default search mode
     _searchMode = SearchMode::FULL_TREE;
 }
 
-bool ExhaustiveSearcher::instructionStackEquals(Ins* reference) const {
+template <int maxProgramSize, int programWidth>
+bool BasicExhaustiveSearcher<maxProgramSize, programWidth>::instructionStackEquals(
+    Ins* reference
+) const {
     auto p1 = _instructionStack.begin();
     Ins* p2 = reference;
 
@@ -50,36 +80,68 @@ bool ExhaustiveSearcher::instructionStackEquals(Ins* reference) const {
     return (p1 == _instructionStack.end() && *p2 == Ins::UNSET);
 }
 
-bool ExhaustiveSearcher::atTargetProgram() {
+template <int maxProgramSize, int programWidth>
+bool BasicExhaustiveSearcher<maxProgramSize, programWidth>::atTargetProgram() {
     return instructionStackEquals(targetStack);
 }
 
-void ExhaustiveSearcher::dumpInstructionStack(const std::string& sep) const {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::dumpInstructionStack(
+    const std::string& sep
+) const {
     ::dumpInstructionStack(_instructionStack, sep.size() ? sep : ",");
 }
 
-void ExhaustiveSearcher::dumpSearchProgress(std::ostream &os) const {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::dumpSearchProgress(
+    std::ostream &os
+) const {
     os << "Stack=";
     ::dumpInstructionStack(_instructionStack, os, ",");
     os << ", Program=" << getProgramSpec();
 }
 
-void ExhaustiveSearcher::dumpSettings(std::ostream &os) const {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::dumpHangDetectionProfile(
+    std::ostream &os
+) const {
+    for (auto hangDetector : _hangExecutor.hangDetectors()) {
+        hangDetector->dumpStats(os);
+    }
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::dumpSettings(std::ostream &os) const {
     os
     << "Size = " << _program.getSize()
     << ", DataSize = " << _settings.dataSize
     << ", MaxSteps = " << _settings.maxHangDetectionSteps
       << "/" << _settings.maxSearchSteps
       << "/" << _settings.maxSteps
+    << ", CellWidth = " << static_cast<int>(_settings.fastExecCellWidth)
+    << ", CycleDetection = " << _settings.fastExecCycleDetection
+    << ", CycleSampling = " << _settings.fastExecCycleSampling
     << ", TestHangDetection = " << _settings.testHangDetection
+    << ", VerificationThreads = " << _settings.numVerificationThreads
     << std::endl;
 }
 
-void ExhaustiveSearcher::dump() {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::dump() {
     _program.dump(_pp.p);
 }
 
-void ExhaustiveSearcher::verifyHang() {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::verifyHang(HangType hangType) {
+    if (_verificationPool) {
+        // The verification runs on a copy of the program, so that the search can move on
+        _verificationPool->submit(_program.toString(), hangType);
+        _tracker->reportQueuedVerification();
+
+        reportVerifiedHangs(false);
+        return;
+    }
+
     RunResult result = _fastExecutor.execute(_programBuilder);
     switch (result) {
         case RunResult::SUCCESS:
@@ -100,14 +162,38 @@ void ExhaustiveSearcher::verifyHang() {
     }
 }
 
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::reportVerifiedHangs(bool waitForAll) {
+    if (!_verificationPool) return;
 
-void ExhaustiveSearcher::extendBlock() {
+    _verificationPool->collect(_finishedVerifications, waitForAll);
+    for (auto& verification : _finishedVerifications) {
+        _tracker->reportVerifiedHang(verification.programSpec, verification.hangType,
+                                     verification.result, verification.numSteps);
+    }
+    _finishedVerifications.clear();
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::extendBlock() {
     while (true) {
         InstructionPointer ip;
         Ins ins;
         do {
+            // Skip NOOPs in one go. Their steps count towards the limit as usual.
+            int noops = noopsAhead(_pp);
+            if (noops > 0) {
+                if (_programBuilder->getNumSteps() + noops > maxProgramSize * maxProgramSize) {
+                    _programBuilder->finalizeHangBlock();
+                    run();
+                    return;
+                }
+                _programBuilder->addSteps(noops);
+                _pp.p = nextInstructionPointer(_pp, noops);
+            }
+
             ip = nextInstructionPointer(_pp);
-            ins = _program.getInstruction(ip);
+            ins = instructionAt(ip);
 
             switch (ins) {
                 case Ins::DONE:
@@ -129,7 +215,13 @@ void ExhaustiveSearcher::extendBlock() {
                         ) {
                             _tracker->reportDetectedHang(HangType::NO_EXIT,
                                                          _settings.testHangDetection);
-                            if (_settings.testHangDetection) verifyHang();
+                            if (_settings.testHangDetection) verifyHang(HangType::NO_EXIT);
+                        } else if (!_settings.disableStaticHangAnalysis &&
+                                   _staticHangAnalyzer.provesHang(block)
+                        ) {
+                            _tracker->reportStaticHang(_staticHangAnalyzer.lastRule(),
+                                                       _settings.testHangDetection);
+                            if (_settings.testHangDetection) verifyHang(HangType::NO_EXIT);
                         } else {
                             run();
                         }
@@ -150,7 +242,7 @@ void ExhaustiveSearcher::extendBlock() {
         _pp.p = ip;
         _programBuilder->incSteps();
 
-        if (_programBuilder->getNumSteps() > 64) {
+        if (_programBuilder->getNumSteps() > maxProgramSize * maxProgramSize) {
             _programBuilder->finalizeHangBlock();
             run();
             return;
@@ -158,7 +250,8 @@ void ExhaustiveSearcher::extendBlock() {
     }
 }
 
-void ExhaustiveSearcher::buildBlock(const ProgramBlock* block) {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::buildBlock(const ProgramBlock* block) {
     assert(!block->isFinalized());
     TurnDirection td0 = _td;
 
@@ -171,15 +264,73 @@ void ExhaustiveSearcher::buildBlock(const ProgramBlock* block) {
     _td = td0;
 }
 
-void ExhaustiveSearcher::branch() {
-    bool abortSearch = (_searchMode == SearchMode::FIND_ONE
-                        || (_searchMode == SearchMode::SUB_TREE && _resumer));
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::updateProbeTime() {
+    auto now = std::chrono::steady_clock::now();
+    _probeTime += _probeWeight * std::chrono::duration<double>(now - _probeClock).count();
+    _probeClock = now;
+}
+
+template <int maxProgramSize, int programWidth>
+Ins BasicExhaustiveSearcher<maxProgramSize, programWidth>::selectProbeInstruction(bool pruneData) {
+    updateProbeTime();
+
+    // The DATA variant is not searched when it is pruned
+    int numOptions = pruneData ? 2 : 3;
+    _probeWeight *= numOptions;
+
+    int index = std::uniform_int_distribution<int>(0, numOptions - 1)(*_random);
+    if (pruneData && validInstructions[index] == Ins::DATA) {
+        index = numOptions;
+    }
+
+    return validInstructions[index];
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::branch() {
+    // Programs are only added to the frontier when the hang executor reached the current block,
+    // as it is used for scoring. Until then, they are expanded further.
+    if (_searchMode == SearchMode::EXPAND && _instructionStack.size() > _expandFrom
+        && _hangExecutor.isExecuting()) {
+        _frontier->push_back({ _instructionStack, scoreExecution() });
+        return;
+    }
+
     InstructionPointer ip = nextInstructionPointer(_pp);
-    Ins resumeIns = _resumer ? _resumer->popNextInstruction(ip) : Ins::UNSET;
+    // The resume stack can run out before the fast executor hands over to the hang executor
+    Ins resumeIns = (_resumer && !_resumer->isDone()) ? _resumer->popNextInstruction(ip)
+                                                      : Ins::UNSET;
+    bool abortSearch = (_searchMode == SearchMode::FIND_ONE
+                        || (_searchMode != SearchMode::FULL_TREE && resumeIns != Ins::UNSET));
+
+    // The sub-trees on the path to the resume point are only partially searched
+    bool partialSubTree = (resumeIns != Ins::UNSET && !_resumer->isDone());
+    if (resumeIns != Ins::UNSET && !partialSubTree) {
+        _profileBaseDepth = _instructionStack.size();
+    }
+    bool profileSubTree = (_profiler
+                           && (partialSubTree || (_instructionStack.size()
+                                                  < _profileBaseDepth + _profiler->getMaxDepth())));
+
+    // When the program exits via this instruction, a DATA instruction is equivalent to a NOOP. This
+    // is the first and also the last time that the instruction is visited. Both variants take one
+    // step, and the change to the data does not matter as the program terminates. So only the NOOP
+    // variant is searched. This requires that its sub-tree is searched completely.
+    bool pruneData = (!_settings.disableEquivalencePruning && resumeIns == Ins::UNSET
+                      && instructionAt(nextInstructionPointer({ .p = ip, .dir = _pp.dir }))
+                         == Ins::DONE);
+    long totalAtStart = _tracker->getTotal();
+    Ins probeIns = ((_searchMode == SearchMode::PROBE && resumeIns == Ins::UNSET)
+                    ? selectProbeInstruction(pruneData) : Ins::UNSET);
 
     for (int i = 0; i < 3; i++) {
         Ins ins = validInstructions[i];
 
+        if (probeIns != Ins::UNSET && ins != probeIns) {
+            continue;
+        }
+
         if (resumeIns != Ins::UNSET) {
             if (ins == resumeIns) {
                 resumeIns = Ins::UNSET; // Let search continue in FULL_TREE search mode
@@ -188,9 +339,16 @@ void ExhaustiveSearcher::branch() {
             }
         }
 
+        if (ins == Ins::DATA && pruneData) {
+            // The NOOP variant comes first, so its sub-tree has just been searched
+            _tracker->reportEquivalentPrograms(_tracker->getTotal() - totalAtStart);
+            continue;
+        }
+
         _program.setInstruction(ip, ins);
         _instructionStack.push_back(ins);
         _programBuilder->push();
+        _exitFinder.push();
         ProgramPointer pp0 = _pp;
 
 //        if (atTargetProgram()) {
@@ -201,10 +359,13 @@ void ExhaustiveSearcher::branch() {
 //        }
 //        std::cout << _program.toString() << std::endl;
 
+        if (profileSubTree) _profiler->enterSubTree(*_tracker);
         extendBlock();
+        if (profileSubTree) _profiler->leaveSubTree(_instructionStack, !partialSubTree, *_tracker);
 
         _program.clearInstruction(ip);
         _instructionStack.pop_back();
+        _exitFinder.pop();
         _programBuilder->pop();
         _pp = pp0;
 
@@ -214,7 +375,8 @@ void ExhaustiveSearcher::branch() {
     }
 }
 
-void ExhaustiveSearcher::switchToHangExecutor() {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::switchToHangExecutor() {
     // The program should be resuming
     assert(_resumer);
 
@@ -235,7 +397,96 @@ void ExhaustiveSearcher::switchToHangExecutor() {
     // Copy data from fast executor and only start data-undo stack from this moment
 }
 
-void ExhaustiveSearcher::run() {
+template <int maxProgramSize, int programWidth>
+int BasicExhaustiveSearcher<maxProgramSize, programWidth>::scoreExecution() const {
+    const Data& data = _hangExecutor.getData();
+    int dataSpan = static_cast<int>(data.getMaxBoundP() - data.getMinBoundP()) + 1;
+
+    // The run summary only covers the execution since the resume point
+    const RunSummary& runSummary = _hangExecutor.getRunSummary();
+    std::map<int, int> lastIterations;
+    int loopGrowth = 0;
+    for (int i = 0; i < runSummary.getNumRunBlocks(); i++) {
+        const RunBlock* runBlock = runSummary.runBlockAt(i);
+        if (!runBlock->isLoop()) continue;
+
+        int iterations = runSummary.getRunBlockLength(i) / runBlock->getLoopPeriod();
+        auto result = lastIterations.insert({runBlock->getSequenceId(), iterations});
+        if (!result.second) {
+            loopGrowth += std::max(0, iterations - result.first->second);
+            result.first->second = iterations;
+        }
+    }
+
+    return (_hangExecutor.numSteps()
+            + dataSpanWeight * dataSpan
+            + loopGrowthWeight * loopGrowth);
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::reportFastExecutionResult(
+    RunResult result, int numSteps, HangType hangType
+) {
+    switch (result) {
+        case RunResult::SUCCESS:
+            _tracker->reportDone(numSteps);
+            break;
+        case RunResult::PROGRAM_ERROR:
+            _tracker->reportLateEscape(numSteps);
+            break;
+        case RunResult::DATA_ERROR:
+            _tracker->reportError();
+            break;
+        case RunResult::ASSUMED_HANG:
+            _tracker->reportAssumedHang();
+            break;
+        case RunResult::DETECTED_HANG:
+            _tracker->reportDetectedHang(hangType, false);
+            break;
+        case RunResult::UNKNOWN:
+            assert(false);
+    }
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::fastExecute() {
+    const ProgramBlock* block = _hangExecutor.lastProgramBlock();
+    int startSteps = _hangExecutor.numSteps();
+    int maxSteps = _settings.maxSteps - startSteps;
+    bool useCache = _transpositionTable.capacity() > 0;
+    RunResult result;
+    int numSteps;
+    HangType hangType;
+
+    if (useCache) {
+        _transpositionTable.createKey(block, _hangExecutor.getData(), _executionKey);
+        if (_transpositionTable.lookup(_executionKey, maxSteps, result, numSteps, hangType)) {
+            _tracker->reportCachedFastExecution();
+            reportFastExecutionResult(result, startSteps + numSteps, hangType);
+            return;
+        }
+    }
+
+    _fastExecutor.setMaxSteps(_settings.maxSteps);
+    _fastExecutor.resumeFrom(block, _hangExecutor.getData(), startSteps);
+    _programExecutor = &_fastExecutor;
+
+    result = _fastExecutor.execute(_programBuilder);
+    numSteps = _fastExecutor.numSteps();
+    hangType = (result == RunResult::DETECTED_HANG
+                ? _fastExecutor.detectedHangType() : HangType::UNDETECTED);
+    if (useCache) {
+        _transpositionTable.store(_executionKey, maxSteps, result, numSteps - startSteps,
+                                  hangType);
+    }
+    reportFastExecutionResult(result, numSteps, hangType);
+
+    _fastExecutor.pop();
+    _programExecutor = &_hangExecutor;
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::run() {
     ProgramExecutor *executor = _programExecutor;
     switch (executor->execute(_programBuilder)) {
         case RunResult::SUCCESS: {
@@ -270,15 +521,7 @@ void ExhaustiveSearcher::run() {
                 // Hang detection is finished. Switch to fast execution
 
                 _tracker->reportFastExecution();
-                _fastExecutor.setMaxSteps(_settings.maxSteps);
-                _fastExecutor.resumeFrom(_hangExecutor.lastProgramBlock(),
-                                         _hangExecutor.getData(),
-                                         _hangExecutor.numSteps());
-                _programExecutor = &_fastExecutor;
-
-                run();
-
-                _programExecutor = &_hangExecutor;
+                fastExecute();
             } else {
                 _tracker->reportAssumedHang();
             }
@@ -289,14 +532,23 @@ void ExhaustiveSearcher::run() {
             HangType hangType = executor->detectedHangType();
             bool testHang = _settings.testHangDetection && (hangType == HangType::REGULAR_SWEEP ||
                                                             hangType == HangType::IRREGULAR_SWEEP ||
-                                                            hangType == HangType::APERIODIC_GLIDER);
-            if (hangType == HangType::NO_DATA_LOOP) {
+                                                            hangType == HangType::APERIODIC_GLIDER ||
+                                                            hangType == HangType::AFFINE_COUNTER);
+            if (executor != &_hangExecutor || hangType == HangType::NO_DATA_LOOP) {
                 _tracker->reportDetectedHang(hangType, testHang);
             } else {
                 _tracker->reportDetectedHang(_hangExecutor.detectedHang(), testHang);
             }
             if (testHang) {
-                verifyHang();
+                HangCertificate certificate;
+                if (executor == &_hangExecutor
+                    && _hangExecutor.detectedHang()->getCertificate(certificate)
+                    && verifyHangCertificate(*_programBuilder, certificate)) {
+                    // The certificate proves the hang, so it does not need to be executed
+                    _tracker->reportAssumedHang();
+                } else {
+                    verifyHang(hangType);
+                }
             }
             break;
         }
@@ -306,16 +558,21 @@ void ExhaustiveSearcher::run() {
     executor->pop();
 }
 
-void ExhaustiveSearcher::search() {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::search() {
     _programExecutor = &_hangExecutor;
+    _profileBaseDepth = 0;
 
     run();
 }
 
-void ExhaustiveSearcher::search(std::unique_ptr<Resumer> resumer, int fromSteps) {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::search(std::unique_ptr<Resumer> resumer,
+                                                     int fromSteps) {
     _resumer = std::move(resumer);
     _fastExecutor.setMaxSteps(fromSteps ? fromSteps : _settings.maxSteps);
     _programExecutor = &_fastExecutor;
+    _profileBaseDepth = 0;
 
     run();
 
@@ -325,7 +582,10 @@ void ExhaustiveSearcher::search(std::unique_ptr<Resumer> resumer, int fromSteps)
     }
 }
 
-void ExhaustiveSearcher::searchSubTree(const std::vector<Ins> &resumeFrom, int fromSteps) {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::searchSubTree(
+    const std::vector<Ins> &resumeFrom, int fromSteps
+) {
     std::cout << "Resuming from: ";
     ::dumpInstructionStack(resumeFrom);
 
@@ -334,7 +594,10 @@ void ExhaustiveSearcher::searchSubTree(const std::vector<Ins> &resumeFrom, int f
     _searchMode = SearchMode::FULL_TREE;
 }
 
-void ExhaustiveSearcher::searchSubTree(const std::string& programSpec, int fromSteps) {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::searchSubTree(
+    const std::string& programSpec, int fromSteps
+) {
     std::cout << "Resuming from: " << programSpec << std::endl;
 
     _searchMode = SearchMode::SUB_TREE;
@@ -343,14 +606,58 @@ void ExhaustiveSearcher::searchSubTree(const std::string& programSpec, int fromS
 }
 
 
-void ExhaustiveSearcher::findOne() {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::findOne() {
     _searchMode = SearchMode::FIND_ONE;
     search();
     _searchMode = SearchMode::FULL_TREE;
 }
 
-void ExhaustiveSearcher::findOne(const std::vector<Ins> &resumeFrom) {
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::findOne(
+    const std::vector<Ins> &resumeFrom
+) {
     _searchMode = SearchMode::FIND_ONE;
     search(std::make_unique<ResumeFromStack>(resumeFrom));
     _searchMode = SearchMode::FULL_TREE;
 }
+
+template <int maxProgramSize, int programWidth>
+void BasicExhaustiveSearcher<maxProgramSize, programWidth>::expand(
+    const std::vector<Ins> &partialProgram, std::vector<PartialProgram> &frontier
+) {
+    _searchMode = SearchMode::EXPAND;
+    _frontier = &frontier;
+    _expandFrom = partialProgram.size();
+    search(std::make_unique<ResumeFromStack>(partialProgram));
+    _frontier = nullptr;
+    _searchMode = SearchMode::FULL_TREE;
+}
+
+template <int maxProgramSize, int programWidth>
+ProbeResult BasicExhaustiveSearcher<maxProgramSize, programWidth>::probe(
+    const std::vector<Ins> &resumeFrom, std::mt19937& random
+) {
+    _searchMode = SearchMode::PROBE;
+    _random = &random;
+    _probeWeight = 1;
+    _probeTime = 0;
+    _probeClock = std::chrono::steady_clock::now();
+    long lateEscapesAtStart = _tracker->getTotalLateEscapes();
+
+    search(std::make_unique<ResumeFromStack>(resumeFrom));
+    updateProbeTime();
+
+    _random = nullptr;
+    _searchMode = SearchMode::FULL_TREE;
+
+    // The tracker does not include late escapes in its total, so neither does the estimate. The
+    // time spent on them is still included.
+    bool lateEscape = _tracker->getTotalLateEscapes() > lateEscapesAtStart;
+    return { .numPrograms = lateEscape ? 0 : _probeWeight, .searchTime = _probeTime };
+}
+
+template class BasicExhaustiveSearcher<8>;
+template class BasicExhaustiveSearcher<8, 6>;
+template class BasicExhaustiveSearcher<8, 7>;
+template class BasicExhaustiveSearcher<16>;
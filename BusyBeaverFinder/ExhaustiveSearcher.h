@@ -8,7 +8,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <chrono>
 #include <iterator>
+#include <random>
 #include <vector>
 
 #include "Searcher.h"
@@ -18,15 +20,39 @@
 #include "InterpretedProgramBuilder.h"
 #include "FastExecutor.h"
 #include "HangExecutor.h"
+#include "HangVerificationPool.h"
 
 #include "ProgressTracker.h"
 
 #include "ExitFinder.h"
+#include "StaticHangAnalyzer.h"
+#include "SubTreeProfiler.h"
+#include "TranspositionTable.h"
 
 enum class SearchMode : int8_t {
     FULL_TREE = 0,
     SUB_TREE = 1,
     FIND_ONE = 2,
+    // Only searches one instruction beyond the resume point. The partial programs that are then
+    // still running are added to a frontier instead of being searched further.
+    EXPAND = 3,
+    // Follows a single random path through the search tree
+    PROBE = 4,
+};
+
+// A program that is not yet fully searched, with a score that estimates how promising it is
+struct PartialProgram {
+    std::vector<Ins> instructions;
+    int score;
+};
+
+// Knuth's estimate of the size of a search tree, obtained from a single random probe
+struct ProbeResult {
+    // The estimated number of programs in the tree. Like the tracker's total, it excludes late
+    // escapes.
+    double numPrograms;
+    // The estimated time in seconds it takes to search the tree
+    double searchTime;
 };
 
 struct SearchSettings : public BaseSearchSettings {
@@ -39,10 +65,33 @@ struct SearchSettings : public BaseSearchSettings {
 
 
     bool testHangDetection = false;
+    // When hang detection is tested, verifies the detected hangs on this many background threads,
+    // so that the search does not wait for them. Zero verifies them synchronously.
+    int numVerificationThreads = 0;
     bool disableNoExitHangDetection = false;
+    bool disableStaticHangAnalysis = false;
+    // When set, programs are also searched when they are equivalent to programs already searched
+    bool disableEquivalencePruning = false;
+
+    // The maximum number of fast execution results to cache. Zero disables caching.
+    int transpositionTableSize = 4096;
+
+    // Measures the time spent by hang detectors, in addition to their call counts
+    bool profileHangDetection = false;
+
+    // Profiles the sub-trees up to this depth below the resume point. Zero disables profiling.
+    int subTreeProfileDepth = 0;
 };
 
-class ExhaustiveSearcher : public Searcher {
+/* Searches programs up to the given maximum size. When a program width is specified, the searcher
+ * only supports programs of that width. This enables the compiler to optimize the look-up of
+ * instructions in the inner loop of the search. These specializations are only instantiated for
+ * the program sizes where search performance matters.
+ */
+template <int maxProgramSize, int programWidth = 0>
+class BasicExhaustiveSearcher : public Searcher {
+    using ProgramBuilder = BasicInterpretedProgramBuilder<maxProgramSize>;
+
     SearchSettings _settings;
     Program _program;
 
@@ -51,6 +100,21 @@ class ExhaustiveSearcher : public Searcher {
 
     std::unique_ptr<Resumer> _resumer;
 
+    // Only used in EXPAND mode
+    std::vector<PartialProgram>* _frontier;
+    size_t _expandFrom;
+
+    // Only used in PROBE mode. The weight is the product of the branching factors so far. The
+    // time spent at each node of the probe is weighted by it.
+    std::mt19937* _random;
+    double _probeWeight;
+    double _probeTime;
+    std::chrono::steady_clock::time_point _probeClock;
+
+    // Accounts the time since the previous call to the current node of the probe
+    void updateProbeTime();
+    Ins selectProbeInstruction(bool pruneData);
+
     TurnDirection _td;
     ProgramPointer _pp;
 
@@ -58,16 +122,37 @@ class ExhaustiveSearcher : public Searcher {
     std::vector<Ins> _instructionStack;
 
     // An interpreted representation of the program
-    std::shared_ptr<InterpretedProgramBuilder> _programBuilder;
+    std::shared_ptr<ProgramBuilder> _programBuilder;
 
     FastExecutor _fastExecutor;
     HangExecutor _hangExecutor;
     // Points to the active executor
     ProgramExecutor* _programExecutor;
 
-    ExitFinder _exitFinder;
+    BasicExitFinder<maxProgramSize> _exitFinder;
+    BasicStaticHangAnalyzer<maxProgramSize> _staticHangAnalyzer;
+
+    TranspositionTable _transpositionTable;
+    ExecutionKey _executionKey;
 
-    void verifyHang();
+    // Only set when detected hangs are verified asynchronously
+    std::unique_ptr<HangVerificationPool> _verificationPool;
+    std::vector<HangVerification> _finishedVerifications;
+
+    // Only set when sub-trees are profiled
+    std::unique_ptr<SubTreeProfiler> _profiler;
+    // The depth of the instruction stack at the resume point
+    size_t _profileBaseDepth = 0;
+
+    void verifyHang(HangType hangType);
+    // Reports the asynchronous verifications that finished. When waitForAll is set, it first waits
+    // for the pending ones.
+    void reportVerifiedHangs(bool waitForAll);
+
+    // Continues execution of the current program, after hang detection, with the fast executor.
+    // Results are cached, so that executions are not repeated for programs that behave the same.
+    void fastExecute();
+    void reportFastExecutionResult(RunResult result, int numSteps, HangType hangType);
 
     void run();
     void branch();
@@ -76,8 +161,27 @@ class ExhaustiveSearcher : public Searcher {
 
     void switchToHangExecutor();
 
+    // Scores the execution of the current program until it reached the unset instruction. It
+    // rewards steps, data cells in use, and loops whose iteration counts grow.
+    int scoreExecution() const;
+
+    Ins instructionAt(InstructionPointer insP) const {
+        if constexpr (programWidth > 0) {
+            return _program.getInstructionBuffer()[Program::indexFor(insP, programWidth)];
+        } else {
+            return _program.getInstruction(insP);
+        }
+    }
+    int noopsAhead(ProgramPointer pp) const {
+        if constexpr (programWidth > 0) {
+            return _program.noopsAhead(Program::indexFor(pp.p, programWidth), pp.dir);
+        } else {
+            return _program.noopsAhead(pp);
+        }
+    }
+
 public:
-    ExhaustiveSearcher(SearchSettings settings);
+    BasicExhaustiveSearcher(SearchSettings settings);
 
     bool getHangDetectionTestMode() const { return _settings.testHangDetection; }
 
@@ -111,11 +215,29 @@ public:
     void findOne();
     void findOne(const std::vector<Ins> &resumeFrom);
 
+    // Searches the programs that add one instruction to the given partial program. Programs that
+    // terminate or hang are reported as usual. The others are added to the frontier.
+    void expand(const std::vector<Ins> &partialProgram, std::vector<PartialProgram> &frontier);
+
+    // Estimates the size of the sub-tree that starts from the given instruction stack by following
+    // a single random path from it. The estimate is unbiased, but has a large variance, so it
+    // should be averaged over many probes.
+    ProbeResult probe(const std::vector<Ins> &resumeFrom, std::mt19937& random);
+
     void dumpInstructionStack(const std::string& sep = {}) const;
     bool instructionStackEquals(Ins* reference) const;
 
     void dumpSearchProgress(std::ostream &os) const override;
+    void dumpHangDetectionProfile(std::ostream &os) const override;
+    const SubTreeProfile* getSubTreeProfile() const override {
+        return _profiler ? &_profiler->getProfile() : nullptr;
+    }
+
+    void finishPendingWork() override { reportVerifiedHangs(true); }
 
     void dumpSettings(std::ostream &os) const override;
     void dump();
 };
+
+// Searches programs of at most 8x8, which covers all sizes where an exhaustive search is feasible.
+using ExhaustiveSearcher = BasicExhaustiveSearcher<8>;
@@ -16,12 +16,15 @@
 // infinite recursion without explicitly checking if it has entered a loop.
 const int maxBacktrackDepth = 4;
 
-ExitFinder::ExitFinder(Program& program, InterpretedProgramBuilder& interpretedProgramBuilder) :
+template <int maxProgramSize>
+BasicExitFinder<maxProgramSize>::BasicExitFinder(Program& program,
+                                                 ProgramBuilder& interpretedProgramBuilder) :
     _program(program),
     _programBuilder(interpretedProgramBuilder)
 {
     for (int i = 0; i < maxProgramBlocks; i++) {
         _visited[i] = false;
+        _unsetInstruction[i] = -1;
     }
 
     // Bound on the maximum number of steps to execute within a block without processing a DATA
@@ -31,8 +34,9 @@ ExitFinder::ExitFinder(Program& program, InterpretedProgramBuilder& interpretedP
     _maxSteps = (program.getSize().width - 1) * (program.getSize().height - 1);
 }
 
-bool ExitFinder::isPossibleExitValue(const ProgramBlock* block, bool zeroValue, int delta,
-                                     int depth) {
+template <int maxProgramSize>
+bool BasicExitFinder<maxProgramSize>::isPossibleExitValue(const ProgramBlock* block,
+                                                          bool zeroValue, int delta, int depth) {
     if ( !block->isDelta() ) {
         // The block performs a shift. We cannot conclude anything about its exit value
         return true;
@@ -73,7 +77,8 @@ bool ExitFinder::isPossibleExitValue(const ProgramBlock* block, bool zeroValue,
     return false;
 }
 
-bool ExitFinder::isReachable(const ProgramBlock* block) {
+template <int maxProgramSize>
+bool BasicExitFinder<maxProgramSize>::isReachable(const ProgramBlock* block) {
     for (int i = block->numEntryBlocks(); --i >= 0; ) {
         const ProgramBlock* entryBlock = block->entryBlock(i);
 
@@ -93,7 +98,46 @@ bool ExitFinder::isReachable(const ProgramBlock* block) {
     return false;
 }
 
-void ExitFinder::visitBlock(const ProgramBlock* block) {
+template <int maxProgramSize>
+void BasicExitFinder<maxProgramSize>::push() {
+    _unsetInstructionLogStart.push_back(_unsetInstructionLog.size());
+}
+
+template <int maxProgramSize>
+void BasicExitFinder<maxProgramSize>::pop() {
+    size_t logStart = _unsetInstructionLogStart.back();
+    _unsetInstructionLogStart.pop_back();
+
+    while (_unsetInstructionLog.size() > logStart) {
+        auto [blockIndex, oldValue] = _unsetInstructionLog.back();
+        _unsetInstruction[blockIndex] = oldValue;
+        _unsetInstructionLog.pop_back();
+    }
+}
+
+template <int maxProgramSize>
+const ProgramBlock* BasicExitFinder<maxProgramSize>::finalizeBlock(const ProgramBlock* block) {
+    int blockIndex = block->getStartIndex();
+    int unsetIndex = _unsetInstruction[blockIndex];
+    if (unsetIndex >= 0 && _program.getInstructionBuffer()[unsetIndex] == Ins::UNSET) {
+        // The block still ends at the same unset instruction
+        return nullptr;
+    }
+
+    InstructionPointer unsetP;
+    _programBuilder.enterBlock(block);
+    const ProgramBlock* finalizedBlock = _programBuilder.buildActiveBlock(_program, &unsetP);
+
+    if (finalizedBlock == nullptr) {
+        _unsetInstructionLog.emplace_back(blockIndex, unsetIndex);
+        _unsetInstruction[blockIndex] = _program.indexFor(unsetP);
+    }
+
+    return finalizedBlock;
+}
+
+template <int maxProgramSize>
+void BasicExitFinder<maxProgramSize>::visitBlock(const ProgramBlock* block) {
     if (block == nullptr                         // This is a block that cannot be entered
         || _visited[block->getStartIndex()]) {   // Already visited this block
         return;
@@ -102,8 +146,7 @@ void ExitFinder::visitBlock(const ProgramBlock* block) {
     _visited[block->getStartIndex()] = true;
 
     if (!block->isFinalized()) {
-        _programBuilder.enterBlock(block);
-        const ProgramBlock* finalizedBlock = _programBuilder.buildActiveBlock(_program);
+        const ProgramBlock* finalizedBlock = finalizeBlock(block);
 
         if (finalizedBlock == nullptr) {
             // Can escape from this block
@@ -123,7 +166,8 @@ void ExitFinder::visitBlock(const ProgramBlock* block) {
     _visitStack.push_back(block);
 }
 
-bool ExitFinder::canExitFrom(const ProgramBlock* block) {
+template <int maxProgramSize>
+bool BasicExitFinder<maxProgramSize>::canExitFrom(const ProgramBlock* block) {
     assert(block->isFinalized());
 
     _visitStack.clear();
@@ -156,3 +200,6 @@ bool ExitFinder::canExitFrom(const ProgramBlock* block) {
 
     return canEscape;
 }
+
+template class BasicExitFinder<8>;
+template class BasicExitFinder<16>;
@@ -12,9 +12,13 @@
 #include "Program.h"
 #include "InterpretedProgramBuilder.h"
 
-class ExitFinder {
+template <int maxProgramSize>
+class BasicExitFinder {
+    using ProgramBuilder = BasicInterpretedProgramBuilder<maxProgramSize>;
+    static constexpr int maxProgramBlocks = ProgramBuilder::maxProgramBlocks;
+
     Program& _program;
-    InterpretedProgramBuilder& _programBuilder;
+    ProgramBuilder& _programBuilder;
     int _maxSteps;
 
     // Tracks if the block with the given index has been visited already
@@ -26,6 +30,17 @@ class ExitFinder {
     // The possible exits
     std::vector<const ProgramBlock*> _exits;
 
+    // For blocks that could not be finalized, the (index of the) unset instruction that prevented
+    // this, or -1 if unknown. As long as this instruction remains unset, the block cannot be
+    // finalized, so it does not need to be built again. This is maintained incrementally as the
+    // search progresses, and updates are undone on back-tracking.
+    int _unsetInstruction[maxProgramBlocks];
+
+    // Log of updates to _unsetInstruction (block index and the old value), and the size of the log
+    // at the start of each search level.
+    std::vector<std::pair<int, int>> _unsetInstructionLog;
+    std::vector<size_t> _unsetInstructionLogStart;
+
     // Recursively checks if a given value (zero or non-zero) can be obtained via at least one
     // possible entry path.
     bool isPossibleExitValue(const ProgramBlock* block, bool zeroValue, int delta, int depth);
@@ -33,10 +48,18 @@ class ExitFinder {
     // Performs a simple analysis to check if the given block can be reached.
     bool isReachable(const ProgramBlock* block);
 
+    // Tries to finalize the block. Returns nullptr if this is not (yet) possible.
+    const ProgramBlock* finalizeBlock(const ProgramBlock* block);
+
     void visitBlock(const ProgramBlock* block);
 
 public:
-    ExitFinder(Program& program, InterpretedProgramBuilder& programBuilder);
+    BasicExitFinder(Program& program, ProgramBuilder& programBuilder);
+
+    // Should be invoked alongside the corresponding methods of the program builder, so that state
+    // that is maintained across invocations remains valid on back-tracking.
+    void push();
+    void pop();
 
     // Checks if it is possible to exit from the loop that starts with the given block. It will
     // finalize blocks that are not yet finalized but which can be finalized given the instructions
@@ -46,3 +69,5 @@ public:
     // not yet finalized)
     bool canExitFrom(const ProgramBlock* block);
 };
+
+using ExitFinder = BasicExitFinder<8>;
@@ -13,6 +13,9 @@ FastExecSearcher::FastExecSearcher(BaseSearchSettings settings) :
     _executor(settings.dataSize)
 {
     _executor.setMaxSteps(settings.maxSteps);
+    _executor.setCellWidth(settings.fastExecCellWidth);
+    _executor.setDetectCycles(settings.fastExecCycleDetection);
+    _executor.setSampleCycles(settings.fastExecCycleSampling);
 }
 
 void FastExecSearcher::run(const std::string& programSpec,
@@ -35,6 +38,10 @@ void FastExecSearcher::run(const std::string& programSpec,
         case RunResult::ASSUMED_HANG:
             _tracker->reportAssumedHang();
             return;
+        case RunResult::DETECTED_HANG:
+            // Only when cycle detection or sampling is enabled
+            _tracker->reportDetectedHang(_executor.detectedHangType(), false);
+            return;
         case RunResult::PROGRAM_ERROR:
             _tracker->reportLateEscape(_executor.numSteps());
             return;
@@ -49,6 +56,9 @@ void FastExecSearcher::dumpSettings(std::ostream &os) const {
     << "Size = " << _settings.size
     << ", DataSize = " << _settings.dataSize
     << ", MaxSteps = " << _settings.maxSteps
+    << ", CellWidth = " << static_cast<int>(_settings.fastExecCellWidth)
+    << ", CycleDetection = " << _settings.fastExecCycleDetection
+    << ", CycleSampling = " << _settings.fastExecCycleSampling
     << std::endl;
 }
 
@@ -9,7 +9,9 @@
 #include "FastExecutor.h"
 
 #include <string.h>
+#include <algorithm>
 #include <iostream>
+#include <type_traits>
 
 #include "InterpretedProgram.h"
 #include "ProgramBlock.h"
@@ -18,23 +20,67 @@ constexpr int maxShiftSize = 8;
 constexpr int loopUnrollCount = 8;
 constexpr int sentinelSize = maxShiftSize * loopUnrollCount;
 
-FastExecutor::FastExecutor(int dataSize)
-    : _dataBufSize(dataSize + 2 * sentinelSize), _data(_dataBufSize)
-{
-    _minDataP = &_data[sentinelSize]; // Inclusive
-    _maxDataP = _minDataP + dataSize; // Exclusive
-    _midDataP = &_data[_dataBufSize / 2];
+// When sampling for cycles, the first sample is taken at this step count. The step count doubles
+// for each next sample. Each sample checks for a cycle for a fraction of the steps executed so far.
+constexpr long firstSampleSteps = 1024;
+constexpr int sampleLengthDivider = 16;
 
+template <typename Cell>
+void FastExecutionTape<Cell>::init(int dataSize, int sentinelSize) {
+    int bufSize = dataSize + 2 * sentinelSize;
+    data.resize(bufSize);
+
+    minDataP = &data[sentinelSize];
+    maxDataP = minDataP + dataSize;
+    midDataP = &data[bufSize / 2];
+    dataP = midDataP;
+}
+
+template <typename Cell>
+void FastExecutionTape<Cell>::clear() {
+    std::fill(data.begin(), data.end(), 0);
+}
+
+FastExecutor::FastExecutor(int dataSize) : _dataSize(dataSize) {
+    _tape.init(dataSize, sentinelSize);
+
+    _canResume = false;
+}
+
+void FastExecutor::setCellWidth(CellWidth cellWidth) {
+    _cellWidth = cellWidth;
+    _canResume = false;
+
+    if (_cellWidth == CellWidth::NARROW_16 && !_tape16.isAllocated()) {
+        _tape16.init(_dataSize, sentinelSize);
+    }
+    if (_cellWidth == CellWidth::NARROW_8 && !_tape8.isAllocated()) {
+        _tape8.init(_dataSize, sentinelSize);
+    }
+}
+
+void FastExecutor::setDetectCycles(bool enabled) {
+    _detectCycles = enabled;
+    _canResume = false;
+}
+
+void FastExecutor::setSampleCycles(bool enabled) {
+    _sampleCycles = enabled;
     _canResume = false;
 }
 
 void FastExecutor::resetData() {
-    _data.clear();
-    _data.resize(_dataBufSize);
+    _activeCellWidth = _detectCycles ? CellWidth::WIDE : _cellWidth;
+
+    switch (_activeCellWidth) {
+        case CellWidth::NARROW_8: _tape8.clear(); break;
+        case CellWidth::NARROW_16: _tape16.clear(); break;
+        case CellWidth::WIDE: _tape.clear(); break;
+    }
 }
 
 // Executes multiple iterations of the loop in between checking the two "slow" exit criteria:
-// Too close to the limit of the data tape or exceeded the maximum number of steps.
+// Too close to the limit of the data tape or exceeded the step limit.
 //
 // Note: This optimization cannot be achieved by a compiler loop unroll, as they compiler cannot
 // know that the "slow conditions" can be checked less frequently.
@@ -44,97 +90,224 @@ void FastExecutor::resetData() {
 // will still always remain within allocated memory. The execution overhead of this slight
 // overshoot is negligible compared to the gains when searching for long-running programs.
 //
+// The execution state is copied to local variables. Otherwise, as writes to the tape may alias
+// them, they need to be reloaded after each step. This is in particular the case for 8-bit cells.
+//
+// The first numUncheckedSteps steps are executed without slow checks. This is used to complete
+// the unrolled iteration that was interrupted by a cell overflow after switching to wide cells.
+// This way the overshoot, and therefore the number of steps executed, does not depend on the
+// cell width.
+//
 // Returns true if execution terminated because a slow criteria was violated, and false otherwise
-// (when a terminating instruction was encountered).
-bool FastExecutor::fastRun() {
-    int amount;
-    while (_dataP >= _minDataP && _dataP < _maxDataP && _numSteps <= _maxSteps) {
-        // Step 1
-        if (_block->interruptsRun()) return false;
-        _numSteps += _block->getNumSteps();
-        amount = _block->getInstructionAmount();
-        if (_block->isDelta()) { *_dataP += amount; } else { _dataP += amount; }
-        _block = (*_dataP == 0) ? _block->zeroBlock() : _block->nonZeroBlock();
-
-        // Step 2
-        if (_block->interruptsRun()) return false;
-        _numSteps += _block->getNumSteps();
-        amount = _block->getInstructionAmount();
-        if (_block->isDelta()) { *_dataP += amount; } else { _dataP += amount; }
-        _block = (*_dataP == 0) ? _block->zeroBlock() : _block->nonZeroBlock();
+// (when a terminating instruction was encountered, or when a value did not fit in a cell).
+template <typename Cell>
+bool FastExecutor::fastRun(FastExecutionTape<Cell>& tape, int numUncheckedSteps,
+                           long stepLimit) {
+    constexpr bool isNarrow = !std::is_same_v<Cell, int>;
+    const ProgramBlock* block = _block;
+    Cell* dataP = tape.dataP;
+    int numSteps = _numSteps;
+    int stepsInIteration = 0;
 
-        // Step 3
-        if (_block->interruptsRun()) return false;
-        _numSteps += _block->getNumSteps();
-        amount = _block->getInstructionAmount();
-        if (_block->isDelta()) { *_dataP += amount; } else { _dataP += amount; }
-        _block = (*_dataP == 0) ? _block->zeroBlock() : _block->nonZeroBlock();
+    auto step = [&]() {
+        if (block->interruptsRun()) return false;
 
-        // Step 4
-        if (_block->interruptsRun()) return false;
-        _numSteps += _block->getNumSteps();
-        amount = _block->getInstructionAmount();
-        if (_block->isDelta()) { *_dataP += amount; } else { _dataP += amount; }
-        _block = (*_dataP == 0) ? _block->zeroBlock() : _block->nonZeroBlock();
+        int amount = block->getInstructionAmount();
+        if (block->isDelta()) {
+            int value = *dataP + amount;
+            if constexpr (isNarrow) {
+                // Leave the state as it was before the step, so that execution can continue on
+                // the wide tape.
+                if (!FastExecutionTape<Cell>::canHold(value)) return false;
+            }
+            *dataP = value;
+        } else {
+            dataP += amount;
+        }
+        numSteps += block->getNumSteps();
+        block = (*dataP == 0) ? block->zeroBlock() : block->nonZeroBlock();
 
-        // Step 5
-        if (_block->interruptsRun()) return false;
-        _numSteps += _block->getNumSteps();
-        amount = _block->getInstructionAmount();
-        if (_block->isDelta()) { *_dataP += amount; } else { _dataP += amount; }
-        _block = (*_dataP == 0) ? _block->zeroBlock() : _block->nonZeroBlock();
+        if constexpr (isNarrow) stepsInIteration++;
+        return true;
+    };
 
-        // Step 6
-        if (_block->interruptsRun()) return false;
-        _numSteps += _block->getNumSteps();
-        amount = _block->getInstructionAmount();
-        if (_block->isDelta()) { *_dataP += amount; } else { _dataP += amount; }
-        _block = (*_dataP == 0) ? _block->zeroBlock() : _block->nonZeroBlock();
+    bool slowCheckFailed = true;
+    while (numUncheckedSteps > 0) {
+        if (!step()) {
+            slowCheckFailed = false;
+            break;
+        }
+        numUncheckedSteps--;
+    }
 
-        // Step 7
-        if (_block->interruptsRun()) return false;
-        _numSteps += _block->getNumSteps();
-        amount = _block->getInstructionAmount();
-        if (_block->isDelta()) { *_dataP += amount; } else { _dataP += amount; }
-        _block = (*_dataP == 0) ? _block->zeroBlock() : _block->nonZeroBlock();
+    while (slowCheckFailed && tape.contains(dataP) && numSteps <= stepLimit) {
+        static_assert(loopUnrollCount == 8);
+        stepsInIteration = 0;
+        if (!step() || !step() || !step() || !step() ||
+            !step() || !step() || !step() || !step()) {
+            slowCheckFailed = false;
+            break;
+        }
+    }
 
-        // Step 8
-        if (_block->interruptsRun()) return false;
-        _numSteps += _block->getNumSteps();
-        amount = _block->getInstructionAmount();
-        if (_block->isDelta()) { *_dataP += amount; } else { _dataP += amount; }
-        _block = (*_dataP == 0) ? _block->zeroBlock() : _block->nonZeroBlock();
+    _block = block;
+    tape.dataP = dataP;
+    _numSteps = numSteps;
+    if constexpr (isNarrow) {
+        _numUncheckedSteps = loopUnrollCount - stepsInIteration;
     }
-    return true;
+
+    return slowCheckFailed;
 }
 
-RunResult FastExecutor::run() {
-    _canResume = false;
+template <typename Cell>
+void FastExecutor::widenTape(FastExecutionTape<Cell>& tape) {
+    // Both tapes have the same layout, so positions can be mapped using their offset
+    std::copy(tape.data.begin(), tape.data.end(), _tape.data.begin());
+    _tape.dataP = _tape.midDataP + (tape.dataP - tape.midDataP);
 
-    if (fastRun()) {
+    _activeCellWidth = CellWidth::WIDE;
+}
+
+long FastExecutor::fastRunStepLimit() const {
+    return _sampleCycles ? std::min(static_cast<long>(_maxSteps), _nextSampleSteps) : _maxSteps;
+}
+
+template <typename Cell>
+RunResult FastExecutor::run(FastExecutionTape<Cell>& tape, int numUncheckedSteps) {
+    while (fastRun(tape, numUncheckedSteps, fastRunStepLimit())) {
         if (_numSteps > _maxSteps) {
             return RunResult::ASSUMED_HANG;
         }
-        if (_dataP < _minDataP || _dataP >= _maxDataP) {
+        if (!tape.contains(tape.dataP)) {
             return RunResult::DATA_ERROR;
         }
 
-        assert(false);
-    } else {
-        if (!_block->isFinalized()) {
-            _canResume = true;
-            return RunResult::PROGRAM_ERROR;
-        }
-        if (_block->isHang()) {
+        // The next sample is due
+        assert(_sampleCycles);
+        if (detectCycle(tape, std::min(_maxSteps, _numSteps + _numSteps / sampleLengthDivider))) {
+            _detectedHangType = HangType::PERIODIC;
             return RunResult::DETECTED_HANG;
         }
-        if (_block->isExit()) {
-            _numSteps += _block->getNumSteps();
-            return RunResult::SUCCESS;
+
+        while (_nextSampleSteps <= _numSteps) {
+            _nextSampleSteps *= 2;
+        }
+        numUncheckedSteps = 0;
+    }
+
+    if (!_block->interruptsRun()) {
+        // The value of the current block did not fit in a narrow cell. Continue execution from
+        // this block on the wide tape.
+        widenTape(tape);
+        return run(_tape, _numUncheckedSteps);
+    }
+
+    return interruptedRunResult();
+}
+
+RunResult FastExecutor::interruptedRunResult() {
+    if (!_block->isFinalized()) {
+        _canResume = true;
+        return RunResult::PROGRAM_ERROR;
+    }
+    if (_block->isHang()) {
+        return RunResult::DETECTED_HANG;
+    }
+    if (_block->isExit()) {
+        _numSteps += _block->getNumSteps();
+        return RunResult::SUCCESS;
+    }
+
+    assert(false);
+    return RunResult::UNKNOWN;
+}
+
+// The fingerprint of the data is initialized from the tape, and updated incrementally after that.
+// Cells outside the range that was visited are known to be zero, so they are not compared.
+template <typename Cell>
+bool FastExecutor::detectCycle(FastExecutionTape<Cell>& tape, long stepLimit) {
+    constexpr bool isNarrow = !std::is_same_v<Cell, int>;
+
+    // The range that contains all non-zero values. It always includes the data pointer.
+    auto isNonZero = [](Cell value) { return value != 0; };
+    Cell* minP = std::min(tape.dataP, std::find_if(tape.minDataP, tape.dataP, isNonZero));
+    Cell* maxP = std::max(tape.dataP,
+                          std::find_if(std::reverse_iterator(tape.maxDataP),
+                                       std::reverse_iterator(tape.dataP), isNonZero).base() - 1);
+
+    TapeFingerprint fingerprint;
+    fingerprint.shift(static_cast<int>(minP - tape.dataP));
+    for (Cell* p = minP; p <= maxP; p++) {
+        fingerprint.change(0, *p);
+        fingerprint.shift(1);
+    }
+    fingerprint.shift(static_cast<int>(tape.dataP - (maxP + 1)));
+
+    _cycleDetector.reset();
+    while (!_block->interruptsRun() && _numSteps <= stepLimit && tape.contains(tape.dataP)) {
+        int amount = _block->getInstructionAmount();
+        if (_block->isDelta()) {
+            int value = *tape.dataP + amount;
+            if constexpr (isNarrow) {
+                if (!FastExecutionTape<Cell>::canHold(value)) return false;
+            }
+            fingerprint.change(*tape.dataP, value);
+            *tape.dataP = value;
+        } else {
+            tape.dataP += amount;
+            fingerprint.shift(amount);
+            minP = std::min(minP, tape.dataP);
+            maxP = std::max(maxP, tape.dataP);
+        }
+        _numSteps += _block->getNumSteps();
+        _block = (*tape.dataP == 0) ? _block->zeroBlock() : _block->nonZeroBlock();
+
+        if (_cycleDetector.update(_block, fingerprint.value(), minP, maxP + 1, tape.dataP)) {
+            return true;
         }
+    }
+
+    return false;
+}
+
+// Executes step by step on the wide tape, checking for a repeated execution state after each
+// step.
+RunResult FastExecutor::runDetectingCycles() {
+    assert(_activeCellWidth == CellWidth::WIDE);
+
+    if (detectCycle(_tape, _maxSteps)) {
+        _detectedHangType = HangType::PERIODIC;
+        return RunResult::DETECTED_HANG;
+    }
+    if (_block->interruptsRun()) {
+        return interruptedRunResult();
+    }
+
+    return (_numSteps > _maxSteps) ? RunResult::ASSUMED_HANG : RunResult::DATA_ERROR;
+}
+
+RunResult FastExecutor::run() {
+    _canResume = false;
+    _detectedHangType = HangType::NO_DATA_LOOP;
+
+    if (_detectCycles) {
+        return runDetectingCycles();
+    }
+
+    _nextSampleSteps = firstSampleSteps;
+    while (_nextSampleSteps <= _numSteps) {
+        _nextSampleSteps *= 2;
+    }
 
-        assert(false);
+    switch (_activeCellWidth) {
+        case CellWidth::NARROW_8: return run(_tape8, 0);
+        case CellWidth::NARROW_16: return run(_tape16, 0);
+        case CellWidth::WIDE: return run(_tape, 0);
     }
+
+    assert(false);
+    return RunResult::UNKNOWN;
 }
 
 RunResult FastExecutor::execute(std::shared_ptr<const InterpretedProgram> program) {
@@ -144,47 +317,73 @@ RunResult FastExecutor::execute(std::shared_ptr<const InterpretedProgram> progra
 
         resetData();
 
-        _dataP = _midDataP;
+        _tape.dataP = _tape.midDataP;
+        _tape16.dataP = _tape16.midDataP;
+        _tape8.dataP = _tape8.midDataP;
         _block = program->getEntryBlock();
     }
 
     return run();
 }
 
-void FastExecutor::resumeFrom(const ProgramBlock* block, const Data& data, int numSteps) {
-    // Copy the data
-    resetData();
+// Returns false if a data value does not fit in the cells of the tape.
+template <typename Cell>
+bool FastExecutor::loadTape(FastExecutionTape<Cell>& tape, const Data& data) {
+    tape.clear();
+
     DataPointer srcP = data.getMinDataP();
-    int* dstP = _midDataP - (data.getMidDataP() - data.getMinDataP());
+    Cell* dstP = tape.midDataP - (data.getMidDataP() - data.getMinDataP());
     while (srcP <= data.getMaxDataP()) {
+        if (!FastExecutionTape<Cell>::canHold(*srcP)) {
+            return false;
+        }
         *dstP++ = *srcP++;
     }
 
+    tape.dataP = tape.midDataP - (data.getMidDataP() - data.getDataPointer());
+
+    return true;
+}
+
+void FastExecutor::resumeFrom(const ProgramBlock* block, const Data& data, int numSteps) {
+    // Copy the data
+    _activeCellWidth = _detectCycles ? CellWidth::WIDE : _cellWidth;
+    bool loaded = false;
+    switch (_activeCellWidth) {
+        case CellWidth::NARROW_8: loaded = loadTape(_tape8, data); break;
+        case CellWidth::NARROW_16: loaded = loadTape(_tape16, data); break;
+        case CellWidth::WIDE: break;
+    }
+    if (!loaded) {
+        _activeCellWidth = CellWidth::WIDE;
+        loadTape(_tape, data);
+    }
+
     _block = block;
     _numSteps = numSteps;
-    _dataP = _midDataP - (data.getMidDataP() - data.getDataPointer());
 
     _canResume = true;
 }
 
-void FastExecutor::dump() const {
+template <typename Cell>
+void FastExecutor::dumpTape(const FastExecutionTape<Cell>& tape) const {
     // Find end
-    int *max = _maxDataP - 1;
-    while (max > _dataP && *max == 0) {
+    const Cell *max = tape.maxDataP - 1;
+    while (max > tape.dataP && *max == 0) {
         max--;
     }
     // Find start
-    int *p = _minDataP;
-    while (p < _dataP && *p == 0) {
+    const Cell *p = tape.minDataP;
+    while (p < tape.dataP && *p == 0) {
         p++;
     }
 
     std::cout << "Data: ";
     while (1) {
-        if (p == _dataP) {
-            std::cout << "[" << *p << "]";
+        if (p == tape.dataP) {
+            std::cout << "[" << (int)*p << "]";
         } else {
-            std::cout << *p;
+            std::cout << (int)*p;
         }
         if (p < max) {
             p++;
@@ -195,3 +394,11 @@ void FastExecutor::dump() const {
     }
     std::cout << std::endl;
 }
+
+void FastExecutor::dump() const {
+    switch (_activeCellWidth) {
+        case CellWidth::NARROW_8: dumpTape(_tape8); break;
+        case CellWidth::NARROW_16: dumpTape(_tape16); break;
+        case CellWidth::WIDE: dumpTape(_tape); break;
+    }
+}
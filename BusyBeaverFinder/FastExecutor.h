@@ -9,38 +9,121 @@
 
 #include <vector>
 
+#include "CycleDetector.h"
 #include "ProgramExecutor.h"
 #include "Types.h"
 #include "Data.h"
 
+// A data tape for the fast executor. The cell type is a template parameter so that the executor
+// can run on narrow cells, which fit more cells in a cache line, as long as values remain small.
+template <typename Cell>
+struct FastExecutionTape {
+    std::vector<Cell> data;
+
+    Cell* minDataP {}; // Inclusive
+    Cell* midDataP {};
+    Cell* maxDataP {}; // Exclusive
+
+    Cell* dataP {};
+
+    // Allocates the tape. Narrow tapes are only allocated when used.
+    void init(int dataSize, int sentinelSize);
+    void clear();
+
+    bool isAllocated() const { return !data.empty(); }
+    bool contains(const Cell* p) const { return p >= minDataP && p < maxDataP; }
+
+    static bool canHold(int value) {
+        return static_cast<Cell>(value) == value;
+    }
+};
+
 class FastExecutor : public ProgramExecutor {
-    int _dataBufSize;
-    std::vector<int> _data;
+    int _dataSize;
 
-    int* _minDataP;
-    int* _midDataP;
-    int* _maxDataP;
+    // The wide tape. It is always available, as execution switches to it when a value does not
+    // fit in a narrow cell.
+    FastExecutionTape<int> _tape;
+    FastExecutionTape<int16_t> _tape16;
+    FastExecutionTape<int8_t> _tape8;
 
-    int* _dataP;
+    // The configured cell width, and the width of the tape used by the current execution.
+    CellWidth _cellWidth {CellWidth::WIDE};
+    CellWidth _activeCellWidth {CellWidth::WIDE};
+
+    // The number of steps that remained in the unrolled loop iteration when a narrow cell
+    // overflowed.
+    int _numUncheckedSteps {};
 
     bool _canResume;
 
-    bool fastRun();
+    // Optionally, execution checks for repeated execution states. This proves some hangs that
+    // would otherwise be assumed, but it makes execution slower.
+    bool _detectCycles {};
+    CycleDetector _cycleDetector;
+    HangType _detectedHangType {HangType::NO_DATA_LOOP};
+
+    // Optionally, execution only checks for repeated execution states in short bursts, which
+    // start at exponentially increasing step counts. This has little overhead.
+    bool _sampleCycles {};
+    long _nextSampleSteps;
+
+    template <typename Cell> bool fastRun(FastExecutionTape<Cell>& tape, int numUncheckedSteps,
+                                          long stepLimit);
+    template <typename Cell> RunResult run(FastExecutionTape<Cell>& tape, int numUncheckedSteps);
+    // The number of steps after which fastRun should return, which is when the next sample is due
+    long fastRunStepLimit() const;
+
+    // Executes step by step until the execution state repeats, which returns true, or until
+    // execution should be continued by fastRun. The latter is the case when the step limit is
+    // exceeded, execution is interrupted, DP leaves the tape, or a value does not fit in a cell.
+    template <typename Cell> bool detectCycle(FastExecutionTape<Cell>& tape, long stepLimit);
+    RunResult runDetectingCycles();
     RunResult run();
 
+    // Returns the result of a run that ended at a block that interrupts it
+    RunResult interruptedRunResult();
+
+    // Copies the contents of the narrow tape to the wide tape, and continues execution on the
+    // latter.
+    template <typename Cell> void widenTape(FastExecutionTape<Cell>& tape);
+
+    template <typename Cell> bool loadTape(FastExecutionTape<Cell>& tape, const Data& data);
+    template <typename Cell> void dumpTape(const FastExecutionTape<Cell>& tape) const;
+
     void resetData();
 
 public:
     FastExecutor(int dataSize);
     ~FastExecutor() override {}
 
+    // Sets the width of the cells to start executing with. It can be changed only in between
+    // program executions.
+    void setCellWidth(CellWidth cellWidth);
+    CellWidth getCellWidth() const { return _cellWidth; }
+
+    // The cell width used by the last execution. It differs from the configured width when the
+    // execution needed to switch to wide cells.
+    CellWidth getActiveCellWidth() const { return _activeCellWidth; }
+
+    // Enables checking for repeated execution states. Execution then always uses wide cells. It
+    // can be changed only in between program executions.
+    void setDetectCycles(bool enabled);
+    bool getDetectCycles() const { return _detectCycles; }
+
+    // Enables sampling for repeated execution states. It detects hangs that settle down after
+    // hang detection ended, without the cost of checking each step. It has no effect when cycles
+    // are already detected at each step.
+    void setSampleCycles(bool enabled);
+    bool getSampleCycles() const { return _sampleCycles; }
+
     void pop() override { _canResume = false; };
 
     RunResult execute(std::shared_ptr<const InterpretedProgram> program) override;
 
     void resumeFrom(const ProgramBlock* resumeFrom, const Data& data, int numSteps);
 
-    HangType detectedHangType() const override { return HangType::NO_DATA_LOOP; }
+    HangType detectedHangType() const override { return _detectedHangType; }
 
     void dump() const override;
 };
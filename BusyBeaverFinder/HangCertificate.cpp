@@ -0,0 +1,285 @@
+//
+//  HangCertificate.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "HangCertificate.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "InterpretedProgram.h"
+#include "InterpretedProgramBuilder.h"
+#include "Program.h"
+
+namespace {
+
+const char* certificateTypeNames[] = { "CYCLE", "AFFINE_COUNTER", "CLOSED_TAPE" };
+constexpr int numCertificateTypes = 3;
+
+/* Executes a program on a tape that grows as needed. It is deliberately independent of the
+ * executors used by the search, so that certificates are checked without relying on these.
+ */
+class TapeRunner {
+    const ProgramBlock* _block;
+    // The values at positions [_firstPos, _firstPos + _tape.size())
+    std::vector<int> _tape;
+    long _firstPos;
+    long _dp;
+    long _numSteps;
+
+    // The range of positions that DP visited since the last reset
+    long _minVisited, _maxVisited;
+
+    int& cell(long pos) {
+        if (pos < _firstPos) {
+            size_t amount = std::max(_tape.size(), static_cast<size_t>(_firstPos - pos));
+            _tape.insert(_tape.begin(), amount, 0);
+            _firstPos -= amount;
+        } else if (pos >= _firstPos + (long)_tape.size()) {
+            size_t amount = std::max(_tape.size(),
+                                     static_cast<size_t>(pos - _firstPos) + 1 - _tape.size());
+            _tape.insert(_tape.end(), amount, 0);
+        }
+        return _tape[pos - _firstPos];
+    }
+
+public:
+    TapeRunner(const InterpretedProgram& program)
+    : _block(program.getEntryBlock()), _tape(64), _firstPos(-32),
+      _dp(0), _numSteps(0), _minVisited(0), _maxVisited(0) {}
+
+    const ProgramBlock* block() const { return _block; }
+    long dp() const { return _dp; }
+    long firstPos() const { return _firstPos; }
+    long lastPos() const { return _firstPos + (long)_tape.size() - 1; }
+    long minVisited() const { return _minVisited; }
+    long maxVisited() const { return _maxVisited; }
+
+    int valueAt(long pos) const {
+        return (pos < _firstPos || pos > lastPos()) ? 0 : _tape[pos - _firstPos];
+    }
+
+    void resetVisited() {
+        _minVisited = _dp;
+        _maxVisited = _dp;
+    }
+
+    // Executes until the given number of steps. Returns false when execution does not stop
+    // exactly there, or leaves the program.
+    bool run(long numSteps) {
+        while (_numSteps < numSteps) {
+            if (!_block->isFinalized() || _block->isExit() || _block->isHang()) {
+                return false;
+            }
+
+            _numSteps += _block->getNumSteps();
+            if (_block->isDelta()) {
+                cell(_dp) += _block->getInstructionAmount();
+            } else {
+                _dp += _block->getInstructionAmount();
+                _minVisited = std::min(_minVisited, _dp);
+                _maxVisited = std::max(_maxVisited, _dp);
+            }
+
+            _block = (cell(_dp) == 0) ? _block->zeroBlock() : _block->nonZeroBlock();
+        }
+
+        return _numSteps == numSteps;
+    }
+};
+
+bool verifyCycleCertificate(const InterpretedProgram& program,
+                            const CycleCertificate& certificate) {
+    if (certificate.numSteps < 0 || certificate.period <= 0) {
+        return false;
+    }
+
+    TapeRunner runner(program);
+    if (!runner.run(certificate.numSteps)) {
+        return false;
+    }
+
+    TapeRunner start = runner;
+    runner.resetVisited();
+    if (!runner.run(certificate.numSteps + certificate.period)
+        || runner.block() != start.block()) {
+        return false;
+    }
+
+    // The next period only visits the translated range, which repeats the first period when its
+    // values are the same. When the execution travels, it moves into the data ahead. That should
+    // therefore be the same as well.
+    long shift = runner.dp() - start.dp();
+    long from = runner.minVisited();
+    long to = runner.maxVisited();
+    if (shift > 0) {
+        to = std::max(start.lastPos(), runner.lastPos() - shift);
+    } else if (shift < 0) {
+        from = std::min(start.firstPos(), runner.firstPos() - shift);
+    }
+
+    for (long pos = from; pos <= to; pos++) {
+        if (start.valueAt(pos) != runner.valueAt(pos + shift)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool verifyCounterCertificate(const InterpretedProgram& program,
+                              const CounterCertificate& certificate) {
+    if (certificate.numSteps < 0 || certificate.segments.empty()
+        || certificate.segments[0].blocks.empty() || certificate.cells.empty()) {
+        return false;
+    }
+    int maxDp = certificate.minDp + (int)certificate.cells.size() - 1;
+    if (certificate.driverDp < certificate.minDp || certificate.driverDp > maxDp) {
+        return false;
+    }
+
+    TapeRunner runner(program);
+    if (!runner.run(certificate.numSteps)
+        || runner.block()->getStartIndex() != certificate.segments[0].blocks[0]) {
+        return false;
+    }
+
+    // The data should match the template
+    long dp = runner.dp();
+    long t = certificate.driverSign * runner.valueAt(dp + certificate.driverDp);
+    for (int i = 0; i < certificate.cells.size(); i++) {
+        if (certificate.cells[i].at(t) != runner.valueAt(dp + certificate.minDp + i)) {
+            return false;
+        }
+    }
+
+    CounterHangChecker checker;
+    if (!checker.checkInduction(program, certificate, t)) {
+        return false;
+    }
+
+    // The data that the next iterations visit should be zero
+    long from = checker.dpShift() > 0 ? dp + maxDp + 1 : runner.firstPos();
+    long to = checker.dpShift() < 0 ? dp + certificate.minDp - 1 : runner.lastPos();
+    if (checker.dpShift() != 0) {
+        for (long pos = from; pos <= to; pos++) {
+            if (runner.valueAt(pos) != 0) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+void HangCertificate::write(std::ostream &os) const {
+    os << certificateTypeNames[(int)type] << " ";
+
+    switch (type) {
+        case CertificateType::CYCLE:
+            os << cycle.numSteps << " " << cycle.period << std::endl;
+            break;
+        case CertificateType::AFFINE_COUNTER:
+            counter.write(os);
+            break;
+        case CertificateType::CLOSED_TAPE:
+            closedTape.write(os);
+            break;
+    }
+}
+
+bool HangCertificate::read(std::istream &is) {
+    std::string typeName;
+    if (!(is >> typeName)) {
+        return false;
+    }
+
+    auto it = std::find(certificateTypeNames, certificateTypeNames + numCertificateTypes,
+                        typeName);
+    if (it == certificateTypeNames + numCertificateTypes) {
+        return false;
+    }
+    type = (CertificateType)(it - certificateTypeNames);
+
+    switch (type) {
+        case CertificateType::CYCLE:
+            return static_cast<bool>(is >> cycle.numSteps >> cycle.period);
+        case CertificateType::AFFINE_COUNTER:
+            return counter.read(is);
+        case CertificateType::CLOSED_TAPE:
+            return closedTape.read(is);
+    }
+
+    return false;
+}
+
+bool verifyHangCertificate(const InterpretedProgram& program, const HangCertificate& certificate) {
+    switch (certificate.type) {
+        case CertificateType::CYCLE:
+            return verifyCycleCertificate(program, certificate.cycle);
+        case CertificateType::AFFINE_COUNTER:
+            return verifyCounterCertificate(program, certificate.counter);
+        case CertificateType::CLOSED_TAPE:
+            return verifyClosedTapeCertificate(program, certificate.closedTape);
+    }
+
+    return false;
+}
+
+void writeCertifiedHangs(std::ostream& os, const std::vector<CertifiedHang>& hangs) {
+    for (auto& hang : hangs) {
+        os << hang.programSpec << std::endl;
+        hang.certificate.write(os);
+    }
+}
+
+bool readCertifiedHangs(std::istream& is, std::vector<CertifiedHang>& hangs) {
+    CertifiedHang hang;
+    while (is >> hang.programSpec) {
+        if (!hang.certificate.read(is)) {
+            return false;
+        }
+        hangs.push_back(hang);
+    }
+
+    return is.eof();
+}
+
+std::vector<bool> verifyCertifiedHangs(const std::vector<CertifiedHang>& hangs, int numThreads) {
+    // Use chars, as elements of a vector<bool> cannot be set concurrently
+    std::vector<char> valid(hangs.size());
+    std::atomic<size_t> next = 0;
+
+    auto verify = [&]() {
+        size_t i;
+        while ((i = next++) < hangs.size()) {
+            Program program = Program::fromString(hangs[i].programSpec);
+            auto interpretedProgram = buildInterpretedProgram(program);
+
+            valid[i] = (interpretedProgram
+                        && verifyHangCertificate(*interpretedProgram, hangs[i].certificate));
+        }
+    };
+
+    numThreads = std::max(1, std::min(numThreads, (int)hangs.size()));
+    if (numThreads == 1) {
+        verify();
+    } else {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numThreads; i++) {
+            threads.emplace_back(verify);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    return std::vector<bool>(valid.begin(), valid.end());
+}
@@ -0,0 +1,63 @@
+//
+//  HangCertificate.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ClosedTapeDecider.h"
+#include "CounterHangChecker.h"
+
+class InterpretedProgram;
+
+enum class CertificateType : int8_t {
+    CYCLE = 0,
+    AFFINE_COUNTER = 1,
+    CLOSED_TAPE = 2,
+};
+
+/* The execution state after numSteps recurs period steps later, possibly translated. Only the data
+ * that execution visits in between, and the data beyond it in the direction of the translation,
+ * needs to match.
+ */
+struct CycleCertificate {
+    long numSteps;
+    long period;
+};
+
+/* The proof that a program hangs, as provided by a hang detector or decider. It is checked by
+ * executing the program up to the point where the proof applies, and then checking the proof.
+ * This does not depend on any of the analysis that found it.
+ */
+struct HangCertificate {
+    CertificateType type;
+
+    // Only the certificate that matches the type is set
+    CycleCertificate cycle;
+    CounterCertificate counter;
+    ClosedTapeCertificate closedTape;
+
+    void write(std::ostream& os) const;
+    bool read(std::istream& is);
+};
+
+bool verifyHangCertificate(const InterpretedProgram& program, const HangCertificate& certificate);
+
+struct CertifiedHang {
+    std::string programSpec;
+    HangCertificate certificate;
+};
+
+// Each hang is written as its program spec, followed by its certificate
+void writeCertifiedHangs(std::ostream& os, const std::vector<CertifiedHang>& hangs);
+bool readCertifiedHangs(std::istream& is, std::vector<CertifiedHang>& hangs);
+
+// Verifies the certificates of the hangs using the given number of threads. For each hang it
+// returns if its certificate is valid.
+std::vector<bool> verifyCertifiedHangs(const std::vector<CertifiedHang>& hangs, int numThreads);
@@ -24,8 +24,10 @@ void HangDetector::reset() {
     clearAnalysis();
 }
 
-bool HangDetector::detectHang() {
-    if (!shouldCheckNow()) {
+bool HangDetector::detectHang(HangDetectionEvents events) {
+    _stats.numInvocations++;
+
+    if (!shouldCheckNow(events)) {
         return false;
     }
 
@@ -38,7 +40,7 @@ bool HangDetector::detectHang() {
 
     if (_analysisCheckPoint != now) {
         // We have not yet analysed the current situation
-        if (!analyzeHangBehaviour()) {
+        if (!trackAnalysis(_stats, [this]() { return analyzeHangBehaviour(); })) {
             _lastFailedCheckPoint = now;
             clearAnalysis();
             return false;
@@ -46,7 +48,7 @@ bool HangDetector::detectHang() {
         _analysisCheckPoint = now;
     }
 
-    Trilian result = proofHang();
+    Trilian result = trackProof(_stats, [this]() { return proofHang(); });
     if (result == Trilian::MAYBE) {
         return false;
     }
@@ -58,3 +60,43 @@ bool HangDetector::detectHang() {
 
     return true;
 }
+
+void HangDetector::dumpStats(std::ostream &os) const {
+    os << name() << ": " << _stats << std::endl;
+}
+
+void BlockHangDetector::dumpStats(std::ostream &os) const {
+    os << name() << ": " << _blockStats << std::endl;
+}
+
+HangDetectorStats& HangDetectorStats::operator+=(const HangDetectorStats& other) {
+    numInvocations += other.numInvocations;
+    numAnalyses += other.numAnalyses;
+    numSuccessfulAnalyses += other.numSuccessfulAnalyses;
+    numProofAttempts += other.numProofAttempts;
+    numProofsYes += other.numProofsYes;
+    numProofsNo += other.numProofsNo;
+    analysisTime += other.analysisTime;
+    proofTime += other.proofTime;
+
+    return *this;
+}
+
+std::ostream &operator<<(std::ostream &os, const HangDetectorStats &stats) {
+    auto toSeconds = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double>(d).count();
+    };
+
+    long numProofsMaybe = stats.numProofAttempts - stats.numProofsYes - stats.numProofsNo;
+    double successRate = (stats.numAnalyses > 0
+                          ? 100.0 * stats.numSuccessfulAnalyses / stats.numAnalyses : 0);
+
+    os << "#Invocations=" << stats.numInvocations
+    << ", #Analyses=" << stats.numSuccessfulAnalyses << "/" << stats.numAnalyses
+    << " (" << (int)successRate << "%)"
+    << ", #Proofs(YES/NO/MAYBE)=" << stats.numProofsYes << "/" << stats.numProofsNo
+    << "/" << numProofsMaybe
+    << ", Time=" << toSeconds(stats.analysisTime) << "+" << toSeconds(stats.proofTime);
+
+    return os;
+}
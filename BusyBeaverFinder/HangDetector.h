@@ -7,10 +7,58 @@
 //
 #pragma once
 
+#include <chrono>
+#include <iostream>
+
 #include "Types.h"
 #include "ExhaustiveSearcher.h"
 #include "RunSummary.h"
 
+struct HangCertificate;
+
+// Events that occur while executing with hang detection. Hang detectors subscribe to these, and
+// are only invoked when one of their events occurs. Multiple events can occur at the same time.
+typedef uint8_t HangDetectionEvents;
+
+// A loop has just been entered
+constexpr HangDetectionEvents LOOP_STARTED_EVENT = 0x01;
+// A loop completed an iteration and continues running
+constexpr HangDetectionEvents LOOP_ITERATION_EVENT = 0x02;
+// A loop has just been exited
+constexpr HangDetectionEvents LOOP_ENDED_EVENT = 0x04;
+// A loop has just been entered, which is part of a meta-loop
+constexpr HangDetectionEvents META_LOOP_STARTED_EVENT = 0x08;
+// A loop that is part of a meta-loop has just been exited
+constexpr HangDetectionEvents META_LOOP_ENDED_EVENT = 0x10;
+// The meta-loop completed an iteration and continues running
+constexpr HangDetectionEvents META_LOOP_ITERATION_EVENT = 0x20;
+// A checkpoint was reached, i.e. a run block was added to the run summary. Unlike the other
+// events, it also occurs outside loops.
+constexpr HangDetectionEvents CHECKPOINT_EVENT = 0x40;
+
+// Cost accounting of a hang detector. It is accumulated across program executions.
+struct HangDetectorStats {
+    // The number of times the detector was invoked for an event it subscribed to
+    long numInvocations {};
+
+    // The number of times it analyzed hang behavior, and how often this was successful
+    long numAnalyses {};
+    long numSuccessfulAnalyses {};
+
+    // The number of hang proof attempts and their outcomes
+    long numProofAttempts {};
+    long numProofsYes {};
+    long numProofsNo {};
+
+    // Time spent in analysis and in proof attempts. Only measured when enabled.
+    std::chrono::steady_clock::duration analysisTime {};
+    std::chrono::steady_clock::duration proofTime {};
+
+    HangDetectorStats& operator+=(const HangDetectorStats& other);
+};
+
+std::ostream &operator<<(std::ostream &os, const HangDetectorStats &stats);
+
 class HangDetector {
     // When last hang proof attempt was done that failed
     int _lastFailedCheckPoint;
@@ -18,6 +66,11 @@ class HangDetector {
     // When last analysis was performed
     int _analysisCheckPoint;
 
+    HangDetectorStats _stats;
+
+    // Measuring time is opt-in, as it adds overhead to each analysis and proof attempt
+    bool _measureTime {};
+
 protected:
     const ExecutionState& _execution;
 
@@ -28,7 +81,8 @@ protected:
     // hang that is being detected.
     int currentCheckPoint() { return _execution.getRunSummary().getNumRunBlocks(); }
 
-    virtual bool shouldCheckNow() const = 0;
+    // Invoked for subscribed events. It can be overridden to further limit when to check.
+    virtual bool shouldCheckNow(HangDetectionEvents events) const { return true; }
 
     // Checks if the run summary and possibly meta-run summary exhibits the characteristic behaviour
     // for the hang that is being detected. Returns true iff this is the case. It should then also
@@ -52,23 +106,108 @@ protected:
     // succeed.
     virtual Trilian proofHang() = 0;
 
+    // Invoke the given analysis or proof function, and record its outcome (and when enabled, the
+    // time it took) in the given stats. Detectors can use these to track costs at a finer
+    // granularity, e.g. per hang checker.
+    template <typename Fun> bool trackAnalysis(HangDetectorStats& stats, Fun analyze) const;
+    template <typename Fun> Trilian trackProof(HangDetectorStats& stats, Fun proof) const;
+
 public:
     HangDetector(const ExecutionState& execution);
     virtual ~HangDetector() {}
 
     virtual HangType hangType() const { return HangType::UNKNOWN; };
+    virtual const char* name() const { return "HangDetector"; }
+
+    // Returns the events that the detector should be invoked for.
+    virtual HangDetectionEvents subscribedEvents() const = 0;
+
+    const HangDetectorStats& stats() const { return _stats; }
+    void setMeasureTime(bool enabled) { _measureTime = enabled; }
 
     virtual void reset();
 
-    // Returns true if a hang is detected. It is only executed when the program is inside a loop.
-    // The execution state indicates if the loop just started, is continuing, or just finished.
+    // Returns true if a hang is detected. It is only invoked when one or more of the subscribed
+    // events occurred, which are passed as argument.
     //
     // Most detectors only analyze behavior when a loop just finished, but for some hangs (e.g.
     // simple periodic hangs) the loop will never exit.
     //
     // After analysis, to verify that the program really is hanging, it can also be useful to
     // examing the data at the start of a loop, e.g. to see if a sweep continues forever.
-    bool detectHang();
+    bool detectHang(HangDetectionEvents events);
+
+    // Sets the certificate that proves the hang it detected. Returns false when the detector does
+    // not provide certificates.
+    virtual bool getCertificate(HangCertificate& certificate) const { return false; }
+
+    // Dumps the stats. Detectors that track stats at a finer granularity should also dump these.
+    virtual void dumpStats(std::ostream &os) const;
 
     virtual void dump() const = 0;
 };
+
+/* Hang detector that is invoked after each executed program block, instead of for loop events. It
+ * therefore does not rely on the run summaries. Its checks should be cheap.
+ */
+class BlockHangDetector : public HangDetector {
+protected:
+    // The invocations are the blocks that were checked. A proof attempt is a more costly check,
+    // which is only done when a cheap check passed.
+    HangDetectorStats _blockStats;
+
+    // Not used, as hangs are detected by checkBlock
+    bool analyzeHangBehaviour() override { return false; }
+    Trilian proofHang() override { return Trilian::NO; }
+
+public:
+    BlockHangDetector(const ExecutionState& execution) : HangDetector(execution) {}
+
+    HangDetectionEvents subscribedEvents() const override { return 0; }
+
+    // Returns true if hangs that it detects during the hang detection window should only be
+    // reported at the end of the window. This way the loop-based detectors can classify the hang
+    // first, and it only serves as a last resort before the hang is assumed.
+    virtual bool defersDetection() const { return false; }
+
+    // Should be invoked after each executed block, with the next block to execute. Returns true
+    // when a hang is detected.
+    virtual bool checkBlock(const ProgramBlock* block) = 0;
+
+    void dumpStats(std::ostream &os) const override;
+};
+
+template <typename Fun>
+bool HangDetector::trackAnalysis(HangDetectorStats& stats, Fun analyze) const {
+    bool result;
+    if (_measureTime) {
+        auto startTime = std::chrono::steady_clock::now();
+        result = analyze();
+        stats.analysisTime += std::chrono::steady_clock::now() - startTime;
+    } else {
+        result = analyze();
+    }
+
+    stats.numAnalyses++;
+    stats.numSuccessfulAnalyses += result;
+
+    return result;
+}
+
+template <typename Fun>
+Trilian HangDetector::trackProof(HangDetectorStats& stats, Fun proof) const {
+    Trilian result;
+    if (_measureTime) {
+        auto startTime = std::chrono::steady_clock::now();
+        result = proof();
+        stats.proofTime += std::chrono::steady_clock::now() - startTime;
+    } else {
+        result = proof();
+    }
+
+    stats.numProofAttempts++;
+    stats.numProofsYes += (result == Trilian::YES);
+    stats.numProofsNo += (result == Trilian::NO);
+
+    return result;
+}
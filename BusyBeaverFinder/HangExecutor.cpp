@@ -7,8 +7,10 @@
 //
 #include "HangExecutor.h"
 
+#include "CycleHangDetector.h"
 #include "MetaLoopHangDetector.h"
 #include "PeriodicHangDetector.h"
+#include "TranslatedCycleHangDetector.h"
 
 #include "ProgramBlock.h"
 
@@ -16,10 +18,9 @@ HangExecutor::HangExecutor(int dataSize, int maxHangDetectionSteps) :
     _hangDetectionStart(0),
     _maxHangDetectionSteps(maxHangDetectionSteps),
     _data(dataSize),
-    _zArrayHelperBuf(maxHangDetectionSteps / 2),
-    _runSummary(_runHistory, _zArrayHelperBuf.data()),
-    _metaRunSummary(_runSummary.getRunBlocks(), _zArrayHelperBuf.data()),
-    _metaMetaRunSummary(_metaRunSummary.getRunBlocks(), _zArrayHelperBuf.data()),
+    _runSummary(_runHistory, _zArrayHelperBuf),
+    _metaRunSummary(_runSummary.getRunBlocks(), _zArrayHelperBuf),
+    _metaMetaRunSummary(_metaRunSummary.getRunBlocks(), _zArrayHelperBuf),
     _runBlockTransitions(_runSummary)
 {
     _runSummary.setIdentifyShortLoops(true);
@@ -27,8 +28,33 @@ HangExecutor::HangExecutor(int dataSize, int maxHangDetectionSteps) :
 }
 
 void HangExecutor::addDefaultHangDetectors() {
-    _hangDetectors.push_back(std::make_shared<PeriodicHangDetector>(*this));
-    _hangDetectors.push_back(std::make_shared<MetaLoopHangDetector>(*this));
+    addHangDetector(std::make_shared<PeriodicHangDetector>(*this));
+    addHangDetector(std::make_shared<MetaLoopHangDetector>(*this));
+    addHangDetector(std::make_shared<CycleHangDetector>(*this));
+    addHangDetector(std::make_shared<TranslatedCycleHangDetector>(*this));
+}
+
+void HangExecutor::addHangDetector(std::shared_ptr<HangDetector> hangDetector) {
+    HangDetectionEvents events = hangDetector->subscribedEvents();
+
+    _hangDetectors.push_back(hangDetector);
+    _hangDetectorEvents.push_back(events);
+    _subscribedEvents |= events;
+
+    auto blockHangDetector = std::dynamic_pointer_cast<BlockHangDetector>(hangDetector);
+    if (blockHangDetector) {
+        _blockHangDetectors.push_back(blockHangDetector);
+    }
+
+    hangDetector->setMeasureTime(_measureDetectorTime);
+}
+
+void HangExecutor::setMeasureDetectorTime(bool enabled) {
+    _measureDetectorTime = enabled;
+
+    for (auto hangDetector : _hangDetectors) {
+        hangDetector->setMeasureTime(enabled);
+    }
 }
 
 void HangExecutor::resetHangDetection() {
@@ -37,11 +63,30 @@ void HangExecutor::resetHangDetection() {
     _metaRunSummary.reset();
     _metaMetaRunSummary.reset();
     _runBlockTransitions.reset();
+    _metaLoopIteration = 0;
 
     for (auto hangDetector : _hangDetectors) {
         hangDetector->reset();
     }
     _detectedHang = nullptr;
+    _deferredHang = nullptr;
+}
+
+int HangExecutor::firstReferencedProgramBlock() const {
+    // Map the first referenced run unit at each level down to the level below it
+    int first = _metaMetaRunSummary.firstReferencedRunUnit();
+    int firstAtLevel = _metaRunSummary.firstReferencedRunUnit();
+    if (first < _metaRunSummary.getNumRunBlocks()) {
+        firstAtLevel = std::min(firstAtLevel, _metaRunSummary.runBlockAt(first)->getStartIndex());
+    }
+
+    first = firstAtLevel;
+    firstAtLevel = _runSummary.firstReferencedRunUnit();
+    if (first < _runSummary.getNumRunBlocks()) {
+        firstAtLevel = std::min(firstAtLevel, _runSummary.runBlockAt(first)->getStartIndex());
+    }
+
+    return firstAtLevel;
 }
 
 HangType HangExecutor::detectedHangType() const {
@@ -78,6 +123,46 @@ RunResult HangExecutor::executeBlock() {
     return RunResult::UNKNOWN;
 }
 
+HangDetectionEvents HangExecutor::determineEvents(bool runBlockAdded,
+                                                  bool metaLoopIterated) const {
+    HangDetectionEvents events = 0;
+
+    if (runBlockAdded) {
+        events = CHECKPOINT_EVENT;
+    }
+    if (metaLoopIterated) {
+        events |= META_LOOP_ITERATION_EVENT;
+    }
+
+    if (!_runSummary.isInsideLoop()) {
+        return events & _subscribedEvents;
+    }
+
+    switch (_loopRunState) {
+        case LoopRunState::STARTED:
+            events |= LOOP_STARTED_EVENT;
+            if ((_subscribedEvents & META_LOOP_STARTED_EVENT) && _metaRunSummary.isInsideLoop()) {
+                events |= META_LOOP_STARTED_EVENT;
+            }
+            break;
+        case LoopRunState::RUNNING:
+            if ((_subscribedEvents & LOOP_ITERATION_EVENT) && _runSummary.isAtEndOfLoop()) {
+                events |= LOOP_ITERATION_EVENT;
+            }
+            break;
+        case LoopRunState::ENDED:
+            events |= LOOP_ENDED_EVENT;
+            if ((_subscribedEvents & META_LOOP_ENDED_EVENT) && _metaRunSummary.isInsideLoop()) {
+                events |= META_LOOP_ENDED_EVENT;
+            }
+            break;
+        case LoopRunState::NO_LOOP:
+            break;
+    }
+
+    return events & _subscribedEvents;
+}
+
 RunResult HangExecutor::executeWithoutHangDetection(int stepLimit) {
     RunResult result = RunResult::UNKNOWN;
 
@@ -88,19 +173,53 @@ RunResult HangExecutor::executeWithoutHangDetection(int stepLimit) {
     return result;
 }
 
+bool HangExecutor::detectBlockHang(bool duringHangDetection) {
+    for (auto& hangDetector : _blockHangDetectors) {
+        if (hangDetector == _deferredHang || !hangDetector->checkBlock(_block)) {
+            continue;
+        }
+
+        if (duringHangDetection && hangDetector->defersDetection()) {
+            if (!_deferredHang) {
+                _deferredHang = hangDetector;
+            }
+        } else {
+            _detectedHang = hangDetector;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 RunResult HangExecutor::executeWithHangDetection(int stepLimit) {
     resetHangDetection();
 
+    bool runBlockAdded = false;
     while (_numSteps < stepLimit) {
+        if (runBlockAdded && _boundRunHistory) {
+            // The summaries only move on when run blocks are added. Do so before the summaries
+            // are updated, so that detectors can still access the history of a loop that ended.
+            _runHistory.discardBefore(firstReferencedProgramBlock());
+        }
+
         // Record block before executing it. This way, when signalling a loop exit, the value
         // that triggered this, which typically is zero, is still present in the data values.
         _runHistory.push_back(_block);
-        bool runBlockAdded = _runSummary.processNewRunUnits();
+        runBlockAdded = _runSummary.processNewRunUnits();
+        bool metaLoopIterated = false;
         if (runBlockAdded) {
             _runBlockTransitions.processNewRunBlocks();
             if (_metaRunSummary.processNewRunUnits()) {
                 _metaMetaRunSummary.processNewRunUnits();
             }
+
+            // Run blocks can be added in pairs, so check if the iteration count increased instead
+            // of checking if the meta-loop is at the end of an iteration
+            int iteration = (_metaRunSummary.isInsideLoop()
+                             ? _metaRunSummary.getLoopIteration() : 0);
+            metaLoopIterated = iteration > _metaLoopIteration;
+            _metaLoopIteration = iteration;
         }
 
         RunResult result = executeBlock();
@@ -114,14 +233,46 @@ RunResult HangExecutor::executeWithHangDetection(int stepLimit) {
                              : (runBlockAdded
                                 ? LoopRunState::STARTED
                                 : LoopRunState::RUNNING));
+        }
 
-            for (auto hangDetector : _hangDetectors) {
-                if (hangDetector->detectHang()) {
-                    _detectedHang = hangDetector;
+        HangDetectionEvents events = determineEvents(runBlockAdded, metaLoopIterated);
+        if (events) {
+            for (int i = 0; i < _hangDetectors.size(); i++) {
+                if ((_hangDetectorEvents[i] & events)
+                    && _hangDetectors[i]->detectHang(events & _hangDetectorEvents[i])) {
+                    _detectedHang = _hangDetectors[i];
                     return RunResult::DETECTED_HANG;
                 }
             }
         }
+
+        if (detectBlockHang(true)) {
+            return RunResult::DETECTED_HANG;
+        }
+    }
+
+    if (_deferredHang) {
+        _detectedHang = _deferredHang;
+        return RunResult::DETECTED_HANG;
+    }
+
+    return RunResult::UNKNOWN;
+}
+
+RunResult HangExecutor::executeWithBlockHangDetection(int stepLimit) {
+    if (_blockHangDetectors.empty()) {
+        return executeWithoutHangDetection(stepLimit);
+    }
+
+    while (_numSteps < stepLimit) {
+        RunResult result = executeBlock();
+        if (result != RunResult::UNKNOWN) {
+            return result;
+        }
+
+        if (detectBlockHang(false)) {
+            return RunResult::DETECTED_HANG;
+        }
     }
 
     return RunResult::UNKNOWN;
@@ -135,8 +286,9 @@ RunResult HangExecutor::run() {
     result = executeWithHangDetection(std::min(_numSteps + _maxHangDetectionSteps, _maxSteps));
     if (result != RunResult::UNKNOWN) return result;
 
-    // Run without hang detection, but still with a data-undo stack (so search can continue)
-    result = executeWithoutHangDetection(_maxSteps);
+    // Run without the loop-based hang detection, but still with a data-undo stack (so search can
+    // continue)
+    result = executeWithBlockHangDetection(_maxSteps);
     if (result != RunResult::UNKNOWN) return result;
 
     return RunResult::ASSUMED_HANG;
@@ -175,12 +327,12 @@ RunResult HangExecutor::execute(std::shared_ptr<const InterpretedProgram> progra
 
 RunResult HangExecutor::execute(std::string programSpec) {
     Program program = Program::fromString(programSpec);
-    auto programBuilder = std::make_shared<InterpretedProgramBuilder>();
-    programBuilder->buildFromProgram(program);
+    auto interpretedProgram = buildInterpretedProgram(program);
+    assert(interpretedProgram);
 
     std::cout << "Executing: " << programSpec << std::endl;
 
-    return execute(programBuilder);
+    return execute(interpretedProgram);
 }
 
 void HangExecutor::dump() const {
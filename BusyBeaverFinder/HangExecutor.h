@@ -17,7 +17,9 @@
 #include "RunSummary.h"
 #include "Types.h"
 
+class BlockHangDetector;
 class HangDetector;
+typedef uint8_t HangDetectionEvents;
 
 struct ExecutionStackFrame {
     ExecutionStackFrame(const ProgramBlock* programBlock, size_t dataStackSize, int numSteps)
@@ -30,6 +32,18 @@ struct ExecutionStackFrame {
 
 class HangExecutor : public ProgramExecutor, public ExecutionState {
     std::vector<std::shared_ptr<HangDetector>> _hangDetectors;
+    // The events each hang detector subscribed to (same order as _hangDetectors), and all events
+    // that any detector subscribed to.
+    std::vector<HangDetectionEvents> _hangDetectorEvents;
+    HangDetectionEvents _subscribedEvents {};
+    bool _measureDetectorTime {};
+
+    // The detectors that are invoked after each block. They are also included in _hangDetectors,
+    // but as they do not subscribe to any events, they are invoked separately.
+    std::vector<std::shared_ptr<BlockHangDetector>> _blockHangDetectors;
+    // A hang detected during the hang detection window that is only reported at the end of it
+    std::shared_ptr<BlockHangDetector> _deferredHang;
+
     std::vector<ExecutionStackFrame> _executionStack;
 
     int _hangDetectionStart;
@@ -46,20 +60,39 @@ class HangExecutor : public ProgramExecutor, public ExecutionState {
     // in the first summary.
     RunHistory _runHistory;
     std::vector<int> _zArrayHelperBuf;
+    // When set, the run history only retains the blocks that the summaries may refer to
+    bool _boundRunHistory = true;
     RunSummary _runSummary;
     MetaRunSummary _metaRunSummary;
     MetaRunSummary _metaMetaRunSummary;
     RunBlockTransitions _runBlockTransitions;
     LoopRunState _loopRunState;
+    // The number of completed iterations of the current meta-loop, zero when there is none
+    int _metaLoopIteration {};
 
     bool _verbose {};
 
     void resetHangDetection();
 
+    // Returns the index of the first block in the run history that the run summaries may still
+    // refer to. The detectors only analyze the loops and meta-loops that these refer to.
+    int firstReferencedProgramBlock() const;
+
     RunResult executeBlock();
 
+    // Determines the hang detection events that occurred when executing the last block. Only
+    // determines those that any detector subscribed to.
+    HangDetectionEvents determineEvents(bool runBlockAdded, bool metaLoopIterated) const;
+
     RunResult executeWithoutHangDetection(int stepLimit);
     RunResult executeWithHangDetection(int stepLimit);
+    // Executes without the loop-based hang detectors, but continues to invoke the block hang
+    // detectors
+    RunResult executeWithBlockHangDetection(int stepLimit);
+
+    // Invokes the block hang detectors. Returns true when one detected a hang, which is then set
+    // as the detected hang.
+    bool detectBlockHang(bool duringHangDetection);
 
     RunResult run();
 
@@ -68,12 +101,19 @@ public:
     ~HangExecutor() override {};
 
     void addDefaultHangDetectors();
-    void addHangDetector(std::shared_ptr<HangDetector> hangDetector) {
-        _hangDetectors.push_back(hangDetector);
+    void addHangDetector(std::shared_ptr<HangDetector> hangDetector);
+    const std::vector<std::shared_ptr<HangDetector>>& hangDetectors() const {
+        return _hangDetectors;
     }
 
+    // Enables measuring the time spent by each hang detector
+    void setMeasureDetectorTime(bool enabled);
+
     void setVerbose(bool setting) { _verbose = setting; }
 
+    // Lets the run history retain all blocks, instead of only those that are still referred to
+    void setBoundRunHistory(bool flag) { _boundRunHistory = flag; }
+
     // Only applies to the next invocation of execute, after which it is reset to zero.
     void setHangDetectionStart(int numSteps) { _hangDetectionStart = numSteps; }
 
@@ -82,6 +122,10 @@ public:
 
     void pop() override;
 
+    // Returns true when the current execution state results from an execution that has not yet
+    // been popped. Otherwise it may be stale.
+    bool isExecuting() const { return !_executionStack.empty(); }
+
     RunResult execute(std::shared_ptr<const InterpretedProgram> program) override;
     RunResult execute(std::string programSpec);
 
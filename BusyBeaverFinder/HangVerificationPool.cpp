@@ -0,0 +1,123 @@
+//
+//  HangVerificationPool.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "HangVerificationPool.h"
+
+#include "FastExecutor.h"
+#include "InterpretedProgramBuilder.h"
+#include "Program.h"
+
+namespace {
+
+constexpr size_t batchSize = 64;
+
+}
+
+HangVerificationPool::HangVerificationPool(const BaseSearchSettings& settings, int numThreads)
+: _settings(settings), _maxQueued(4 * numThreads),
+  _hasFinished(false), _numActive(0), _stop(false) {
+    _batch.reserve(batchSize);
+
+    for (int i = 0; i < numThreads; i++) {
+        _workers.emplace_back(&HangVerificationPool::work, this);
+    }
+}
+
+HangVerificationPool::~HangVerificationPool() {
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _workAvailable.notify_all();
+
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void HangVerificationPool::work() {
+    FastExecutor fastExecutor(_settings.dataSize);
+    fastExecutor.setMaxSteps(_settings.maxSteps);
+    fastExecutor.setCellWidth(_settings.fastExecCellWidth);
+    fastExecutor.setDetectCycles(_settings.fastExecCycleDetection);
+    fastExecutor.setSampleCycles(_settings.fastExecCycleSampling);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _workAvailable.wait(lock, [this]() { return _stop || !_queue.empty(); });
+        if (_queue.empty()) {
+            // Only stop once all work is done
+            return;
+        }
+
+        Batch batch = std::move(_queue.front());
+        _queue.pop_front();
+        _numActive++;
+        lock.unlock();
+        _workFinished.notify_all();
+
+        for (auto& verification : batch) {
+            Program program = Program::fromString(verification.programSpec);
+            verification.result = fastExecutor.execute(buildInterpretedProgram(program));
+            verification.numSteps = fastExecutor.numSteps();
+            fastExecutor.pop();
+        }
+
+        lock.lock();
+        _numActive--;
+        _finished.insert(_finished.end(), std::make_move_iterator(batch.begin()),
+                         std::make_move_iterator(batch.end()));
+        _hasFinished = true;
+        _workFinished.notify_all();
+    }
+}
+
+void HangVerificationPool::flush() {
+    if (_batch.empty()) return;
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _workFinished.wait(lock, [this]() { return _queue.size() < _maxQueued; });
+
+        _queue.push_back(std::move(_batch));
+    }
+    _workAvailable.notify_one();
+
+    _batch = Batch();
+    _batch.reserve(batchSize);
+}
+
+void HangVerificationPool::submit(const std::string& programSpec, HangType hangType) {
+    _batch.push_back(HangVerification {
+        .programSpec = programSpec, .hangType = hangType,
+        .result = RunResult::UNKNOWN, .numSteps = 0
+    });
+
+    if (_batch.size() == batchSize) {
+        flush();
+    }
+}
+
+void HangVerificationPool::collect(std::vector<HangVerification>& finished, bool waitForAll) {
+    if (waitForAll) {
+        flush();
+    } else if (!_hasFinished) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (waitForAll) {
+        _workFinished.wait(lock, [this]() { return _queue.empty() && _numActive == 0; });
+    }
+
+    finished.insert(finished.end(), std::make_move_iterator(_finished.begin()),
+                    std::make_move_iterator(_finished.end()));
+    _finished.clear();
+    _hasFinished = false;
+}
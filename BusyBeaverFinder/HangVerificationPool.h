@@ -0,0 +1,71 @@
+//
+//  HangVerificationPool.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Searcher.h"
+#include "Types.h"
+
+struct HangVerification {
+    std::string programSpec;
+    HangType hangType;
+
+    // Only set when the verification has finished
+    RunResult result;
+    int numSteps;
+};
+
+/* Verifies detected hangs on background threads, so that the search does not need to wait for
+ * them. Each verification runs its own copy of the program with a fast executor, up to the maximum
+ * number of steps. The search collects the finished verifications at its convenience.
+ *
+ * Verifications are handed over in batches. Most only take a few hundred steps, so handing them
+ * over one by one would cost more than their execution.
+ */
+class HangVerificationPool {
+    using Batch = std::vector<HangVerification>;
+
+    BaseSearchSettings _settings;
+    // The maximum number of queued batches. When reached, submissions block.
+    size_t _maxQueued;
+
+    // The batch that is being filled. It is only accessed by the submitting thread.
+    Batch _batch;
+
+    std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::condition_variable _workFinished;
+    std::deque<Batch> _queue;
+    Batch _finished;
+    // Lets collect skip locking when there is nothing to collect
+    std::atomic<bool> _hasFinished;
+    int _numActive;
+    bool _stop;
+
+    std::vector<std::thread> _workers;
+
+    void work();
+    void flush();
+
+public:
+    HangVerificationPool(const BaseSearchSettings& settings, int numThreads);
+    ~HangVerificationPool();
+
+    void submit(const std::string& programSpec, HangType hangType);
+
+    // Moves the finished verifications to the given vector. When waitForAll is set, it first waits
+    // until all submitted verifications have finished.
+    void collect(std::vector<HangVerification>& finished, bool waitForAll);
+};
@@ -21,7 +21,8 @@ constexpr uint8_t INSTRUCTION_SET_BIT = 0x01;
 // Set when instruction is a Delta (otherwise it is a Shift)
 constexpr uint8_t INSTRUCTION_TYPE_BIT = 0x02;
 
-InterpretedProgramBuilder::InterpretedProgramBuilder() :
+template <int maxProgramSize>
+BasicInterpretedProgramBuilder<maxProgramSize>::BasicInterpretedProgramBuilder() :
     _blocks(create_indexed_array<ProgramBlock, maxProgramBlocks>())
 {
     _finalizedStack.reserve(_blocks.size());
@@ -30,7 +31,8 @@ InterpretedProgramBuilder::InterpretedProgramBuilder() :
     reset();
 }
 
-void InterpretedProgramBuilder::reset() {
+template <int maxProgramSize>
+void BasicInterpretedProgramBuilder<maxProgramSize>::reset() {
     while (!_state.empty()) {
         pop();
     }
@@ -40,7 +42,8 @@ void InterpretedProgramBuilder::reset() {
     enterBlock(InstructionPointer { .col = 0, .row = 0 }, TurnDirection::COUNTERCLOCKWISE);
 }
 
-void InterpretedProgramBuilder::buildFromProgram(Program& program) {
+template <int maxProgramSize>
+void BasicInterpretedProgramBuilder<maxProgramSize>::buildFromProgram(Program& program) {
     reset();
 
     std::vector<const ProgramBlock*> stack;
@@ -71,7 +74,8 @@ void InterpretedProgramBuilder::buildFromProgram(Program& program) {
     }
 }
 
-void InterpretedProgramBuilder::addDataInstruction(Dir dir) {
+template <int maxProgramSize>
+void BasicInterpretedProgramBuilder<maxProgramSize>::addDataInstruction(Dir dir) {
     MutableProgramBlockProps &props = _state.back().activeProps;
 
     props.flags |= INSTRUCTION_SET_BIT;
@@ -89,7 +93,10 @@ void InterpretedProgramBuilder::addDataInstruction(Dir dir) {
     }
 }
 
-const ProgramBlock* InterpretedProgramBuilder::buildActiveBlock(Program& program) {
+template <int maxProgramSize>
+const ProgramBlock* BasicInterpretedProgramBuilder<maxProgramSize>::buildActiveBlock(
+    Program& program, InstructionPointer* unsetP
+) {
     ProgramStack &state = _state.back();
     ProgramBlock *block = state.activeBlock;
     MutableProgramBlockProps &props = state.activeProps;
@@ -101,6 +108,16 @@ const ProgramBlock* InterpretedProgramBuilder::buildActiveBlock(Program& program
         InstructionPointer ip;
         Ins ins;
         do {
+            // Skip NOOPs in one go. Their steps count towards the limit as usual.
+            int noops = program.noopsAhead(pp);
+            if (noops > 0) {
+                if (props.numSteps + noops > maxBlockSteps) {
+                    return finalizeHangBlock();
+                }
+                props.numSteps += noops;
+                pp.p = nextInstructionPointer(pp, noops);
+            }
+
             ip = nextInstructionPointer(pp);
             ins = program.getInstruction(ip);
 
@@ -109,6 +126,7 @@ const ProgramBlock* InterpretedProgramBuilder::buildActiveBlock(Program& program
                     props.numSteps++;
                     return finalizeExitBlock();
                 case Ins::UNSET:
+                    if (unsetP) *unsetP = ip;
                     return nullptr;
                 case Ins::NOOP:
                     break;
@@ -129,18 +147,20 @@ const ProgramBlock* InterpretedProgramBuilder::buildActiveBlock(Program& program
         } while (ins == Ins::TURN);
 
         pp.p = ip;
-    } while (props.numSteps++ < 127);
+    } while (props.numSteps++ < maxBlockSteps);
 
     return finalizeHangBlock();
 }
 
-void InterpretedProgramBuilder::push() {
+template <int maxProgramSize>
+void BasicInterpretedProgramBuilder<maxProgramSize>::push() {
     ProgramStack &state = _state.back();
     _state.emplace_back(_activatedStack.size(), _finalizedStack.size(),
                         state.activeBlock, state.activeProps);
 }
 
-void InterpretedProgramBuilder::pop() {
+template <int maxProgramSize>
+void BasicInterpretedProgramBuilder<maxProgramSize>::pop() {
     // Pop state from stack
     ProgramStack &state = _state.back();
 
@@ -159,7 +179,10 @@ void InterpretedProgramBuilder::pop() {
     _state.pop_back();
 }
 
-InstructionPointer InterpretedProgramBuilder::startInstructionForBlock(const ProgramBlock* block) {
+template <int maxProgramSize>
+InstructionPointer BasicInterpretedProgramBuilder<maxProgramSize>::startInstructionForBlock(
+    const ProgramBlock* block
+) {
     int val = block->getStartIndex() >> 1;
     int8_t col = val % maxProgramSize;
     int8_t row = (val - col) / maxProgramSize;
@@ -167,12 +190,17 @@ InstructionPointer InterpretedProgramBuilder::startInstructionForBlock(const Pro
     return InstructionPointer { .col = col, .row = row };
 }
 
-TurnDirection InterpretedProgramBuilder::turnDirectionForBlock(const ProgramBlock* block) {
+template <int maxProgramSize>
+TurnDirection BasicInterpretedProgramBuilder<maxProgramSize>::turnDirectionForBlock(
+    const ProgramBlock* block
+) {
     return static_cast<TurnDirection>(block->getStartIndex() & 0x01);
 }
 
-ProgramPointer InterpretedProgramBuilder::getStartProgramPointer(const ProgramBlock* block,
-                                                                 Program& program) {
+template <int maxProgramSize>
+ProgramPointer BasicInterpretedProgramBuilder<maxProgramSize>::getStartProgramPointer(
+    const ProgramBlock* block, Program& program
+) {
     ProgramPointer pp;
 
     if (block == getEntryBlock()) {
@@ -191,7 +219,9 @@ ProgramPointer InterpretedProgramBuilder::getStartProgramPointer(const ProgramBl
     return pp;
 }
 
-ProgramBlock* InterpretedProgramBuilder::getBlock(InstructionPointer insP, TurnDirection turn) {
+template <int maxProgramSize>
+ProgramBlock* BasicInterpretedProgramBuilder<maxProgramSize>::getBlock(InstructionPointer insP,
+                                                                TurnDirection turn) {
     int lookupIndex = ((insP.col + insP.row * maxProgramSize) << 1) + static_cast<int>(turn);
     ProgramBlock* block = &_blocks[lookupIndex];
 
@@ -204,24 +234,29 @@ ProgramBlock* InterpretedProgramBuilder::getBlock(InstructionPointer insP, TurnD
     return block;
 }
 
-bool InterpretedProgramBuilder::isInstructionSet() {
+template <int maxProgramSize>
+bool BasicInterpretedProgramBuilder<maxProgramSize>::isInstructionSet() {
     return (_state.back().activeProps.flags & INSTRUCTION_SET_BIT) != 0;
 }
 
-bool InterpretedProgramBuilder::isDeltaInstruction() {
+template <int maxProgramSize>
+bool BasicInterpretedProgramBuilder<maxProgramSize>::isDeltaInstruction() {
     assert(isInstructionSet());
     return (_state.back().activeProps.flags & INSTRUCTION_TYPE_BIT) != 0;
 }
 
-int InterpretedProgramBuilder::getAmount() {
+template <int maxProgramSize>
+int BasicInterpretedProgramBuilder<maxProgramSize>::getAmount() {
     return _state.back().activeProps.amount;
 }
 
-int InterpretedProgramBuilder::getNumSteps() {
+template <int maxProgramSize>
+int BasicInterpretedProgramBuilder<maxProgramSize>::getNumSteps() {
     return _state.back().activeProps.numSteps;
 }
 
-const ProgramBlock* InterpretedProgramBuilder::finalizeExitBlock() {
+template <int maxProgramSize>
+const ProgramBlock* BasicInterpretedProgramBuilder<maxProgramSize>::finalizeExitBlock() {
     ProgramBlock* block = _state.back().activeBlock;
     assert( !block->isFinalized() );
 
@@ -231,7 +266,8 @@ const ProgramBlock* InterpretedProgramBuilder::finalizeExitBlock() {
     return block;
 }
 
-const ProgramBlock* InterpretedProgramBuilder::finalizeHangBlock() {
+template <int maxProgramSize>
+const ProgramBlock* BasicInterpretedProgramBuilder<maxProgramSize>::finalizeHangBlock() {
     ProgramBlock* block = _state.back().activeBlock;
     assert( !block->isFinalized() );
 
@@ -241,7 +277,10 @@ const ProgramBlock* InterpretedProgramBuilder::finalizeHangBlock() {
     return block;
 }
 
-const ProgramBlock* InterpretedProgramBuilder::finalizeBlock(InstructionPointer endP) {
+template <int maxProgramSize>
+const ProgramBlock* BasicInterpretedProgramBuilder<maxProgramSize>::finalizeBlock(
+    InstructionPointer endP
+) {
     ProgramBlock* block = _state.back().activeBlock;
     assert( !block->isFinalized() );
 
@@ -264,7 +303,10 @@ const ProgramBlock* InterpretedProgramBuilder::finalizeBlock(InstructionPointer
     return block;
 }
 
-const ProgramBlock* InterpretedProgramBuilder::enterBlock(const ProgramBlock* block) {
+template <int maxProgramSize>
+const ProgramBlock* BasicInterpretedProgramBuilder<maxProgramSize>::enterBlock(
+    const ProgramBlock* block
+) {
     ProgramStack &state = _state.back();
     state.activeBlock = &_blocks[block->getStartIndex()]; // Look-up non-const instance
 
@@ -281,7 +323,27 @@ const ProgramBlock* InterpretedProgramBuilder::enterBlock(const ProgramBlock* bl
     return block;
 }
 
-const ProgramBlock* InterpretedProgramBuilder::enterBlock(InstructionPointer startP,
-                                                          TurnDirection turnDir) {
+template <int maxProgramSize>
+const ProgramBlock* BasicInterpretedProgramBuilder<maxProgramSize>::enterBlock(
+    InstructionPointer startP, TurnDirection turnDir
+) {
     return enterBlock(getBlock(startP, turnDir));
 }
+
+template class BasicInterpretedProgramBuilder<8>;
+template class BasicInterpretedProgramBuilder<16>;
+
+std::shared_ptr<InterpretedProgram> buildInterpretedProgram(Program& program) {
+    if (InterpretedProgramBuilder::supportsSize(program.getSize())) {
+        auto programBuilder = std::make_shared<InterpretedProgramBuilder>();
+        programBuilder->buildFromProgram(program);
+        return programBuilder;
+    }
+    if (LargeInterpretedProgramBuilder::supportsSize(program.getSize())) {
+        auto programBuilder = std::make_shared<LargeInterpretedProgramBuilder>();
+        programBuilder->buildFromProgram(program);
+        return programBuilder;
+    }
+
+    return nullptr;
+}
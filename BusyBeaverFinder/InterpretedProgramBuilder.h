@@ -8,20 +8,17 @@
 #pragma once
 
 #include <array>
+#include <memory>
 
 #include "InterpretedProgram.h"
 #include "Types.h"
 #include "Program.h"
 #include "ProgramBlock.h"
 
-// A power of two for efficient indexing
-constexpr int maxProgramSize = 8;
-constexpr int maxProgramBlocks = maxProgramSize * maxProgramSize * 2;
-
 struct MutableProgramBlockProps {
     uint8_t flags;
-    int8_t amount;
-    int8_t numSteps;
+    int16_t amount;
+    int16_t numSteps;
 };
 
 struct ProgramStack {
@@ -44,9 +41,25 @@ struct ProgramStack {
 
 /* Maintains an InterpretedProgram for the program state as it is during the search. It updates it
  * as the search expands and backtracks.
+ *
+ * The maximum program size determines how blocks are indexed. It should be a power of two for
+ * efficient indexing. Programs of at most 8x8 (which includes all that are searched) use the
+ * smallest instantiation, so that its arrays remain compact.
  */
-class InterpretedProgramBuilder : public InterpretedProgram {
-    ProgramSize _size;
+template <int maxProgramSize>
+class BasicInterpretedProgramBuilder : public InterpretedProgram {
+public:
+    static constexpr int maxProgramBlocks = maxProgramSize * maxProgramSize * 2;
+
+    // The number of steps after which a block that has not encountered a DATA instruction is
+    // considered to hang.
+    static constexpr int maxBlockSteps = maxProgramBlocks - 1;
+
+    static bool supportsSize(ProgramSize size) {
+        return size.width <= maxProgramSize && size.height <= maxProgramSize;
+    }
+
+private:
 
     // All program blocks. They are indexed by startIndex. Initially none are finalized. They are
     // finalized as needed.
@@ -72,7 +85,7 @@ class InterpretedProgramBuilder : public InterpretedProgram {
     bool isDeltaInstruction();
 
 public:
-    InterpretedProgramBuilder();
+    BasicInterpretedProgramBuilder();
 
     // Helper method to build the interpreted program from the supplied program
     void buildFromProgram(Program& program);
@@ -95,12 +108,15 @@ public:
     // Update current block
     void addDataInstruction(Dir dir);
     int incSteps() { return _state.back().activeProps.numSteps++; }
+    void addSteps(int numSteps) { _state.back().activeProps.numSteps += numSteps; }
 
     bool isInstructionSet();
     int getAmount();
     int getNumSteps();
 
-    const ProgramBlock* buildActiveBlock(Program& program);
+    // Builds the active block. Returns nullptr if it cannot be finalized yet, as it encountered an
+    // unset instruction. When requested, the location of this instruction is returned.
+    const ProgramBlock* buildActiveBlock(Program& program, InstructionPointer* unsetP = nullptr);
 
     const ProgramBlock* finalizeExitBlock();
     const ProgramBlock* finalizeHangBlock();
@@ -113,3 +129,10 @@ public:
     TurnDirection turnDirectionForBlock(const ProgramBlock* block);
     ProgramPointer getStartProgramPointer(const ProgramBlock* block, Program& program);
 };
+
+using InterpretedProgramBuilder = BasicInterpretedProgramBuilder<8>;
+using LargeInterpretedProgramBuilder = BasicInterpretedProgramBuilder<16>;
+
+// Builds the interpreted program using the smallest builder that supports the program's size.
+// Returns nullptr when the program is too large.
+std::shared_ptr<InterpretedProgram> buildInterpretedProgram(Program& program);
@@ -24,18 +24,20 @@ int InterpretedProgramCanonizer::canonicalStartIndexForBlock(const ProgramBlock*
         return -3;
     }
 
+    // The fields are wide enough for programs built by LargeInterpretedProgramBuilder, whose
+    // blocks take at most 511 steps.
     int value = 0;
     if (block->zeroBlock()) {
-        value |= prog.indexOf(block->zeroBlock()) & 0xff;
+        value |= prog.indexOf(block->zeroBlock()) & 0x3ff;
     }
-    value <<= 8;
+    value <<= 10;
 
     if (block->nonZeroBlock()) {
-        value |= prog.indexOf(block->nonZeroBlock()) & 0xff;
+        value |= prog.indexOf(block->nonZeroBlock()) & 0x3ff;
     }
-    value <<= 6;
+    value <<= 9;
 
-    value |= abs(block->getInstructionAmount()) & 0x3f;
+    value |= abs(block->getInstructionAmount()) & 0x1ff;
     value <<= 1;
 
     value |= ((block->getInstructionAmount() > 0) & 0x1);
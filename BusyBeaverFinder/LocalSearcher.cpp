@@ -0,0 +1,309 @@
+//
+//  LocalSearcher.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "LocalSearcher.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+#include "HangDetector.h"
+
+constexpr Ins mutationInstructions[] = { Ins::NOOP, Ins::DATA, Ins::TURN };
+
+std::unique_ptr<ProgressTracker> createLocalSearchTracker() {
+    auto tracker = std::make_unique<ProgressTracker>();
+
+    // Progress is reported by the local searcher
+    tracker->setDumpStatsPeriod(INT_MAX);
+    tracker->setDumpSuccessStepsLimit(INT_MAX);
+
+    return tracker;
+}
+
+LocalSearchWorker::LocalSearchWorker(LocalSearcher& searcher, SearchSettings settings,
+                                     unsigned int randomSeed) :
+    _searcher(searcher),
+    _settings(settings),
+    _hangExecutor(settings.dataSize, settings.maxHangDetectionSteps),
+    _fastExecutor(settings.dataSize),
+    _builder(std::make_shared<InterpretedProgramBuilder>()),
+    _initialData(settings.dataSize),
+    _random(randomSeed)
+{
+    _hangExecutor.setMaxSteps(_settings.maxHangDetectionSteps);
+    _hangExecutor.addDefaultHangDetectors();
+    _fastExecutor.setMaxSteps(_settings.maxSteps);
+    _fastExecutor.setCellWidth(_settings.fastExecCellWidth);
+    _fastExecutor.setDetectCycles(_settings.fastExecCycleDetection);
+    _fastExecutor.setSampleCycles(_settings.fastExecCycleSampling);
+    _programExecutor = &_hangExecutor;
+
+    attachProgressTracker(createLocalSearchTracker());
+}
+
+std::shared_ptr<InterpretedProgram> LocalSearchWorker::buildInterpretedProgram(Program& program) {
+    if (InterpretedProgramBuilder::supportsSize(program.getSize())) {
+        _builder->buildFromProgram(program);
+        return _builder;
+    }
+
+    if (!LargeInterpretedProgramBuilder::supportsSize(program.getSize())) {
+        return nullptr;
+    }
+    if (!_largeBuilder) {
+        _largeBuilder = std::make_shared<LargeInterpretedProgramBuilder>();
+    }
+    _largeBuilder->buildFromProgram(program);
+    return _largeBuilder;
+}
+
+void LocalSearchWorker::mutate() {
+    ProgramSize size = _candidate.getSize();
+    std::uniform_int_distribution<int> numMutationsDist(
+        1, std::max(1, _searcher._localSettings.maxMutations)
+    );
+    std::uniform_int_distribution<int> colDist(0, size.width - 1);
+    std::uniform_int_distribution<int> rowDist(0, size.height - 1);
+    std::uniform_int_distribution<int> insDist(0, 2);
+
+    for (int i = numMutationsDist(_random); --i >= 0; ) {
+        InstructionPointer insP = {
+            .col = static_cast<int8_t>(colDist(_random)),
+            .row = static_cast<int8_t>(rowDist(_random))
+        };
+        Ins oldIns = _candidate.getInstruction(insP);
+        Ins newIns;
+        do {
+            newIns = mutationInstructions[insDist(_random)];
+        } while (newIns == oldIns);
+
+        _candidate.setInstruction(insP, newIns);
+    }
+}
+
+RunResult LocalSearchWorker::execute(std::shared_ptr<InterpretedProgram> program, int& numSteps,
+                                     HangType& hangType) {
+    _programExecutor = &_hangExecutor;
+    RunResult result = _hangExecutor.execute(program);
+
+    if (result == RunResult::ASSUMED_HANG) {
+        // Hang detection is finished. Continue with fast execution until the step budget is used
+        _tracker->reportFastExecution();
+        _fastExecutor.resumeFrom(_hangExecutor.lastProgramBlock(), _hangExecutor.getData(),
+                                 _hangExecutor.numSteps());
+        _programExecutor = &_fastExecutor;
+        result = _fastExecutor.execute(program);
+        _fastExecutor.pop();
+    }
+    numSteps = _programExecutor->numSteps();
+    hangType = (result == RunResult::DETECTED_HANG
+                ? _programExecutor->detectedHangType() : HangType::UNDETECTED);
+
+    switch (result) {
+        case RunResult::SUCCESS:
+            _tracker->reportDone(numSteps);
+            break;
+        case RunResult::PROGRAM_ERROR:
+            // Not possible, as programs do not contain unset instructions
+            assert(false);
+            break;
+        case RunResult::DATA_ERROR:
+            _tracker->reportError();
+            break;
+        case RunResult::ASSUMED_HANG:
+            _tracker->reportAssumedHang();
+            break;
+        case RunResult::DETECTED_HANG:
+            if (_programExecutor != &_hangExecutor
+                || _programExecutor->detectedHangType() == HangType::NO_DATA_LOOP) {
+                _tracker->reportDetectedHang(_programExecutor->detectedHangType(), false);
+            } else {
+                _tracker->reportDetectedHang(_hangExecutor.detectedHang(), false);
+            }
+            break;
+        case RunResult::UNKNOWN:
+            assert(false);
+    }
+
+    _hangExecutor.pop();
+    _programExecutor = &_hangExecutor;
+
+    return result;
+}
+
+void LocalSearchWorker::setCurrent(const std::string& programSpec) {
+    _current = Program::fromString(programSpec);
+
+    // Programs found by the exhaustive search typically contain unset instructions, for cells that
+    // are never visited. These are equivalent to NOOPs.
+    ProgramSize size = _current.getSize();
+    for (int8_t col = 0; col < size.width; col++) {
+        for (int8_t row = 0; row < size.height; row++) {
+            InstructionPointer insP = { .col = col, .row = row };
+            if (_current.getInstruction(insP) == Ins::UNSET) {
+                _current.setInstruction(insP, Ins::NOOP);
+            }
+        }
+    }
+
+    _current.clone(_candidate);
+}
+
+int LocalSearchWorker::evaluate() {
+    auto program = buildInterpretedProgram(_candidate);
+    RunResult result;
+    int numSteps;
+    HangType hangType;
+    bool cached;
+
+    {
+        std::lock_guard<std::mutex> lock(_searcher._cacheMutex);
+        _searcher._cache.createKey(program->getEntryBlock(), _initialData, _fingerprint);
+        cached = _searcher._cache.lookup(_fingerprint, _settings.maxSteps, result, numSteps);
+    }
+
+    if (!cached) {
+        result = execute(program, numSteps, hangType);
+
+        std::lock_guard<std::mutex> lock(_searcher._cacheMutex);
+        _searcher._cache.store(_fingerprint, _settings.maxSteps, result, numSteps, hangType);
+    }
+
+    return result == RunResult::SUCCESS ? numSteps : 0;
+}
+
+void LocalSearchWorker::run(const std::string& seedProgram) {
+    const LocalSearchSettings& settings = _searcher._localSettings;
+    std::uniform_real_distribution<double> acceptDist(0, 1);
+
+    setCurrent(seedProgram);
+    _currentScore = evaluate();
+    _searcher.checkForRecord(*this);
+
+    int bestScore = _currentScore;
+    int numWithoutImprovement = 0;
+    long candidateIndex;
+
+    while ((candidateIndex = _searcher.claimCandidate()) >= 0) {
+        _current.clone(_candidate);
+        mutate();
+        int score = evaluate();
+        _searcher.checkForRecord(*this);
+
+        double temperature = (settings.initialTemperature
+                              * (1 - candidateIndex / (double)settings.maxCandidates));
+        double delta = std::log(score + 1.0) - std::log(_currentScore + 1.0);
+        if (delta >= 0
+            || (temperature > 0 && acceptDist(_random) < std::exp(delta / temperature))) {
+            _candidate.clone(_current);
+            _currentScore = score;
+            _searcher._numAccepted++;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            numWithoutImprovement = 0;
+        } else if (++numWithoutImprovement >= settings.restartPeriod) {
+            // Restart from the best program found by any of the chains
+            std::string bestProgram = _searcher.getBestProgram();
+            setCurrent(bestProgram.empty() ? seedProgram : bestProgram);
+            _currentScore = evaluate();
+            numWithoutImprovement = 0;
+            _searcher._numRestarts++;
+        }
+    }
+}
+
+LocalSearcher::LocalSearcher(SearchSettings settings, LocalSearchSettings localSettings) :
+    _settings(settings),
+    _localSettings(localSettings),
+    _cache(localSettings.fingerprintCacheSize)
+{
+    for (int i = 0; i < std::max(1, _localSettings.numThreads); i++) {
+        _workers.push_back(std::make_unique<LocalSearchWorker>(
+            *this, _settings, _localSettings.randomSeed + i
+        ));
+    }
+}
+
+long LocalSearcher::claimCandidate() {
+    long index = _numCandidates++;
+    return index < _localSettings.maxCandidates ? index : -1;
+}
+
+void LocalSearcher::checkForRecord(const LocalSearchWorker& worker) {
+    const ProgressTracker* tracker = worker.getProgressTracker();
+
+    std::lock_guard<std::mutex> lock(_recordMutex);
+    if (tracker->getMaxStepsFound() > _maxStepsFound) {
+        _maxStepsFound = tracker->getMaxStepsFound();
+        _bestProgramSpec = tracker->getBestProgramSpec();
+
+        std::cout << "REC " << _maxStepsFound << " " << _bestProgramSpec << std::endl;
+    }
+}
+
+std::string LocalSearcher::getBestProgram() {
+    std::lock_guard<std::mutex> lock(_recordMutex);
+    return _bestProgramSpec;
+}
+
+void LocalSearcher::search(const std::vector<std::string>& seedPrograms) {
+    assert(!seedPrograms.empty());
+    auto seedProgram = [&seedPrograms](int workerIndex) -> const std::string& {
+        return seedPrograms[workerIndex % seedPrograms.size()];
+    };
+
+    if (_workers.size() == 1) {
+        _workers[0]->run(seedProgram(0));
+    } else {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < _workers.size(); i++) {
+            threads.emplace_back([this, i, &seedProgram]() {
+                _workers[i]->run(seedProgram(i));
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    for (auto& worker : _workers) {
+        auto tracker = worker->detachProgressTracker();
+        _tracker->merge(*tracker);
+        worker->attachProgressTracker(createLocalSearchTracker());
+    }
+}
+
+void LocalSearcher::dumpSettings(std::ostream &os) const {
+    os
+    << "DataSize = " << _settings.dataSize
+    << ", MaxSteps = " << _settings.maxHangDetectionSteps << "/" << _settings.maxSteps
+    << ", CellWidth = " << static_cast<int>(_settings.fastExecCellWidth)
+    << ", CycleDetection = " << _settings.fastExecCycleDetection
+    << ", CycleSampling = " << _settings.fastExecCycleSampling
+    << std::endl
+    << "MaxCandidates = " << _localSettings.maxCandidates
+    << ", MaxMutations = " << _localSettings.maxMutations
+    << ", Temperature = " << _localSettings.initialTemperature
+    << ", RestartPeriod = " << _localSettings.restartPeriod
+    << ", Threads = " << _workers.size()
+    << std::endl;
+}
+
+void LocalSearcher::dumpSearchProgress(std::ostream &os) const {
+    os
+    << "Candidates=" << getNumCandidates()
+    << ", Accepted=" << _numAccepted
+    << ", Restarts=" << _numRestarts
+    << ", Cache hits=" << _cache.numHits()
+    << ", Max steps=" << _maxStepsFound;
+}
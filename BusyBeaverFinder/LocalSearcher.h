@@ -0,0 +1,160 @@
+//
+//  LocalSearcher.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Searcher.h"
+#include "ExhaustiveSearcher.h"
+#include "FastExecutor.h"
+#include "HangExecutor.h"
+#include "InterpretedProgramBuilder.h"
+#include "TranspositionTable.h"
+
+struct LocalSearchSettings {
+    // The total number of candidate programs to evaluate
+    long maxCandidates = 100000;
+
+    // The maximum number of cells that are mutated to create a candidate from the current program
+    int maxMutations = 3;
+
+    // The number of threads that search in parallel. Each thread runs its own annealing chain.
+    int numThreads = 1;
+
+    // The temperature at the start of the search. It applies to the difference in the logarithm
+    // of the number of steps, and cools down linearly to zero.
+    double initialTemperature = 0.5;
+
+    // A chain restarts from the best program found when it did not improve for this many
+    // candidates
+    int restartPeriod = 1000;
+
+    // The maximum number of evaluated programs whose result is cached
+    int fingerprintCacheSize = 1 << 20;
+
+    unsigned int randomSeed = 0;
+};
+
+class LocalSearcher;
+
+/* Mutates and evaluates programs for the local searcher. Each thread uses its own worker, with its
+ * own executors and progress tracker.
+ */
+class LocalSearchWorker : public Searcher {
+    LocalSearcher& _searcher;
+    SearchSettings _settings;
+
+    HangExecutor _hangExecutor;
+    FastExecutor _fastExecutor;
+    ProgramExecutor* _programExecutor;
+
+    std::shared_ptr<InterpretedProgramBuilder> _builder;
+    // Only created when a program is encountered that is too large for the default builder
+    std::shared_ptr<LargeInterpretedProgramBuilder> _largeBuilder;
+
+    // Empty data, used to create the fingerprint of a program
+    Data _initialData;
+    ExecutionKey _fingerprint;
+
+    std::mt19937 _random;
+
+    Program _current;
+    int _currentScore = 0;
+    Program _candidate;
+
+    std::shared_ptr<InterpretedProgram> buildInterpretedProgram(Program& program);
+
+    // Sets the current program, as well as the candidate
+    void setCurrent(const std::string& programSpec);
+
+    // Changes the instruction of randomly selected cells of the candidate
+    void mutate();
+
+    // Executes the program and reports the result to the tracker. The hang type is set to
+    // UNDETECTED unless a hang was detected.
+    RunResult execute(std::shared_ptr<InterpretedProgram> program, int& numSteps,
+                      HangType& hangType);
+
+    // Returns the number of steps after which the candidate terminates, or zero when it does not
+    // terminate within the step budget.
+    int evaluate();
+
+public:
+    LocalSearchWorker(LocalSearcher& searcher, SearchSettings settings, unsigned int randomSeed);
+
+    const std::string getProgramSpec() const override { return _candidate.toString(); }
+    int getNumSteps() const override { return _programExecutor->numSteps(); }
+
+    // Runs the annealing chain until the search's candidate budget is used up
+    void run(const std::string& seedProgram);
+
+    void dumpSettings(std::ostream &os) const override {}
+    void dumpSearchProgress(std::ostream &os) const override {}
+};
+
+/* Looks for improvements of known good programs. It repeatedly mutates a few cells of the current
+ * program and evaluates the resulting candidate. Whether the candidate replaces the current
+ * program is decided using simulated annealing.
+ *
+ * Candidates are first executed with hang detection, and then continue with fast execution until
+ * the step budget is used up. Results are cached by the program's fingerprint, which is the same
+ * for programs that only differ in instructions that do not affect their execution.
+ */
+class LocalSearcher : public Searcher {
+    friend class LocalSearchWorker;
+
+    SearchSettings _settings;
+    LocalSearchSettings _localSettings;
+
+    std::vector<std::unique_ptr<LocalSearchWorker>> _workers;
+
+    std::atomic<long> _numCandidates = 0;
+    std::atomic<long> _numAccepted = 0;
+    std::atomic<long> _numRestarts = 0;
+
+    // Guards the fingerprint cache
+    std::mutex _cacheMutex;
+    TranspositionTable _cache;
+
+    // Guards the step record
+    std::mutex _recordMutex;
+    int _maxStepsFound = 0;
+    std::string _bestProgramSpec;
+
+    // Claims a candidate from the budget. Returns its index, or -1 when the budget is used up.
+    long claimCandidate();
+
+    // Reports the best program found by the worker when it is a new step record
+    void checkForRecord(const LocalSearchWorker& worker);
+
+    // Returns the best program found so far, or an empty string when no program terminated
+    std::string getBestProgram();
+
+public:
+    LocalSearcher(SearchSettings settings, LocalSearchSettings localSettings);
+
+    int getMaxStepsFound() const { return _maxStepsFound; }
+    long getNumCandidates() const { return std::min(_numCandidates.load(),
+                                                    _localSettings.maxCandidates); }
+    long getNumCacheHits() const { return _cache.numHits(); }
+
+    // Returns the program with the step record
+    const std::string getProgramSpec() const override { return _bestProgramSpec; }
+    int getNumSteps() const override { return _maxStepsFound; }
+
+    // Searches around the given programs. The chains are divided over these evenly.
+    void search(const std::vector<std::string>& seedPrograms);
+
+    void dumpSettings(std::ostream &os) const override;
+    void dumpSearchProgress(std::ostream &os) const override;
+};
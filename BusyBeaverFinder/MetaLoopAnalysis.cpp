@@ -7,6 +7,9 @@
 //
 
 #include "MetaLoopAnalysis.h"
+
+#include <algorithm>
+
 #include "Data.h"
 
 // The maximum number of meta-run loop iterations to unroll to construct a meta-loop that meets
@@ -214,34 +217,38 @@ void MetaLoopAnalysis::analyzeRunBlocks(const ExecutionState &executionState) {
 
     _seqAnalysis.clear();
     _analysisCache.clear();
-    _sequenceAnalysisPool.reset();
-    _loopAnalysisPool.reset();
+    _sequenceAnalysisArena.reset();
+    _loopAnalysisArena.reset();
 
     _metaLoopPeriod = metaRunSummary.getLoopPeriod();
+    _unrolledLoopSeqAnalysis.clear();
 
     int startIndex = runSummary.getNumRunBlocks() - _metaLoopPeriod;
     for (int i = 0; i < _metaLoopPeriod; ++i) {
         const RunBlock *rb = runSummary.runBlockAt(startIndex + i);
-        std::shared_ptr<SequenceAnalysis> analysis = nullptr;
+        const SequenceAnalysis* analysis = nullptr;
 
-        auto lookupResult = _analysisCache.lower_bound(rb->getSequenceId());
-        if (lookupResult != _analysisCache.end() && lookupResult->first == rb->getSequenceId()) {
+        auto lookupResult = std::find_if(_analysisCache.begin(), _analysisCache.end(),
+                                         [rb](auto& entry) {
+            return entry.first == rb->getSequenceId();
+        });
+        if (lookupResult != _analysisCache.end()) {
             // Result found in cache. Re-use it
             analysis = lookupResult->second;
         } else {
             if (rb->isLoop()) {
-                auto loopAnalysis = _loopAnalysisPool.pop();
-                int loopStartIndex = runSummary.getStartIndexForSequence(rb->getSequenceId());
-                loopAnalysis->analyzeLoop(&runHistory[loopStartIndex], rb->getLoopPeriod());
+                auto loopAnalysis = _loopAnalysisArena.pop();
+                loopAnalysis->analyzeLoop(runSummary.getLoopBlocks(rb->getSequenceId()),
+                                          rb->getLoopPeriod());
                 analysis = loopAnalysis;
             } else {
-                auto sequenceAnalysis = _sequenceAnalysisPool.pop();
+                auto sequenceAnalysis = _sequenceAnalysisArena.pop();
                 sequenceAnalysis->analyzeSequence(&runHistory[rb->getStartIndex()],
                                                   runSummary.getRunBlockLength(startIndex + i));
                 analysis = sequenceAnalysis;
             }
 
-            _analysisCache.insert(lookupResult, std::make_pair(rb->getSequenceId(), analysis));
+            _analysisCache.emplace_back(rb->getSequenceId(), analysis);
         }
 
         _seqAnalysis.push_back(analysis);
@@ -342,7 +349,7 @@ void MetaLoopAnalysis::initLoopBehaviors() {
         bool movesLeft = sa->dataPointerDelta() < 0;
 
         _loopBehaviors.emplace_back(this, data.sequenceIndex,
-                                    std::dynamic_pointer_cast<LoopAnalysis>(sa),
+                                    static_cast<const LoopAnalysis*>(sa),
                                     movesLeft ? dpDeltaEnd : dpDeltaStart,
                                     movesLeft ? dpDeltaStart : dpDeltaEnd,
                                     iterationDeltaType, iterationDelta);
@@ -363,17 +370,19 @@ int MetaLoopAnalysis::totalDpDelta(const RunSummary &runSummary) {
     return dpDelta;
 }
 
-std::shared_ptr<SequenceAnalysis>
+const SequenceAnalysis*
     MetaLoopAnalysis::unrolledLoopSequenceAnalysis(const ExecutionState &executionState,
                                                    int sequenceIndex) const
 {
-    assert(_seqAnalysis[sequenceIndex]->isLoop());
+    assert(isLoop(sequenceIndex));
     int loopIndex = loopIndexForSequence(sequenceIndex);
     assert(_loopBehaviors[loopIndex].iterationDelta() == 0);
 
-    auto result = _unrolledLoopSeqAnalysis.find(sequenceIndex);
-    if (result != _unrolledLoopSeqAnalysis.end()) {
-        return result->second;
+    // The index ranges up to the loop size, which can be a multiple of the meta-loop period
+    if (sequenceIndex >= _unrolledLoopSeqAnalysis.size()) {
+        _unrolledLoopSeqAnalysis.resize(sequenceIndex + 1, nullptr);
+    } else if (_unrolledLoopSeqAnalysis[sequenceIndex]) {
+        return _unrolledLoopSeqAnalysis[sequenceIndex];
     }
 
     const RunHistory &runHistory = executionState.getRunHistory();
@@ -381,7 +390,7 @@ std::shared_ptr<SequenceAnalysis>
 
     int rbIndex = _firstRunBlockIndex + sequenceIndex;
     int pbStart = runSummary.runBlockAt(rbIndex)->getStartIndex();
-    auto sa = _sequenceAnalysisPool.pop();
+    auto sa = _sequenceAnalysisArena.pop();
     sa->analyzeSequence(&runHistory[pbStart], runSummary.getRunBlockLength(rbIndex));
 
     _unrolledLoopSeqAnalysis[sequenceIndex] = sa;
@@ -396,6 +405,10 @@ void MetaLoopAnalysis::reset() {
     _loopData.clear();
     _loopBehaviors.clear();
     _seqAnalysis.clear();
+    _analysisCache.clear();
+    _unrolledLoopSeqAnalysis.clear();
+    _sequenceAnalysisArena.reset();
+    _loopAnalysisArena.reset();
 }
 
 bool MetaLoopAnalysis::isAnalysisStillValid(const ExecutionState &executionState) {
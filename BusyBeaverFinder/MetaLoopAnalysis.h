@@ -7,7 +7,7 @@
 //
 #pragma once
 
-#include <memory>
+#include <deque>
 #include <vector>
 
 #include "ExecutionState.h"
@@ -96,7 +96,7 @@ class LoopBehavior {
     // The index of the loop in the MetaLoopAnalysis
     int _sequenceIndex;
 
-    std::shared_ptr<LoopAnalysis> _loopAnalysis;
+    const LoopAnalysis* _loopAnalysis;
 
     // How much the mininum (left) and maximum (right) DP value changes on subsequent executions of
     // the loop. Not set when change is irregular.
@@ -109,7 +109,7 @@ class LoopBehavior {
 public:
     // Contructor when meta-loop behavior is periodic or regular
     LoopBehavior(const MetaLoopAnalysis* metaLoopAnalysis, int sequenceIndex,
-                 std::shared_ptr<LoopAnalysis> loopAnalysis,
+                 const LoopAnalysis* loopAnalysis,
                  std::optional<int> minDpDelta, std::optional<int> maxDpDelta,
                  LoopIterationDeltaType iterationDeltaType, std::optional<int> iterationDelta)
     : _metaLoopAnalysis(metaLoopAnalysis)
@@ -120,7 +120,7 @@ public:
     , _iterationDeltaType(iterationDeltaType)
     , _iterationDelta(iterationDelta) {}
 
-    std::shared_ptr<LoopAnalysis> loopAnalysis() const { return _loopAnalysis; }
+    const LoopAnalysis* loopAnalysis() const { return _loopAnalysis; }
 
     int sequenceIndex() const { return _sequenceIndex; }
     std::optional<int> minDpDelta() const { return _minDpDelta; }
@@ -152,17 +152,20 @@ public:
 std::ostream &operator<<(std::ostream &os, const LoopBehavior &behavior);
 
 
-// Simple pool that lazily expands when needed. All elements should be returned at once (via reset)
+// Arena for analysis objects that lazily expands when needed. The returned pointers remain valid
+// until reset, which returns all elements at once. The elements are kept for re-use, so that their
+// buffers do not need to be re-allocated.
 template <typename T>
-class SimplePool {
-    std::vector<std::shared_ptr<T>> _pool;
-    int _numPopped;
+class AnalysisArena {
+    // A deque, as its elements do not move when it grows
+    std::deque<T> _elements;
+    int _numPopped {};
 public:
-    std::shared_ptr<T> pop() {
-        if (_numPopped == _pool.size()) {
-            _pool.push_back(std::make_shared<T>());
+    T* pop() {
+        if (_numPopped == _elements.size()) {
+            _elements.emplace_back();
         }
-        return _pool[_numPopped++];
+        return &_elements[_numPopped++];
     }
     int numPopped() const { return _numPopped; }
     void reset() { _numPopped = 0; }
@@ -189,18 +192,19 @@ class MetaLoopAnalysis {
     int _numRunBlocks {};
     int _numRewrites {};
 
-    mutable SimplePool<SequenceAnalysis> _sequenceAnalysisPool;
-    mutable SimplePool<LoopAnalysis> _loopAnalysisPool;
+    mutable AnalysisArena<SequenceAnalysis> _sequenceAnalysisArena;
+    mutable AnalysisArena<LoopAnalysis> _loopAnalysisArena;
 
-    // Analysis cache. Key: Sequence ID
-    std::map<int, std::shared_ptr<SequenceAnalysis>> _analysisCache;
+    // Analysis cache. Pairs of sequence ID and analysis. A meta-loop only contains a few unique
+    // sequences, so a linear search suffices.
+    std::vector<std::pair<int, const SequenceAnalysis*>> _analysisCache;
 
     // The analysis of every run block in the meta-loop (size = _metaLoopPeriod)
-    std::vector<std::shared_ptr<SequenceAnalysis>> _seqAnalysis;
+    std::vector<const SequenceAnalysis*> _seqAnalysis;
 
     // The sequence analysis for unrolled loops. It can be generated on demand, for fixed-sized
-    // loops. It is indexed by sequence index.
-    mutable std::map<int, std::shared_ptr<SequenceAnalysis>> _unrolledLoopSeqAnalysis;
+    // loops. It is indexed by sequence index, and null or absent when not yet generated.
+    mutable std::vector<const SequenceAnalysis*> _unrolledLoopSeqAnalysis;
 
     // The properties of the loops in the meta-loop. Access by loop index.
     std::vector<MetaLoopData> _loopData;
@@ -231,7 +235,7 @@ class MetaLoopAnalysis {
 
     // The number of loops in the meta-run block (the meta-loop may contain a multiple of this).
     // It is valid before analysis is complete.
-    int numLoops() const { return _loopAnalysisPool.numPopped(); }
+    int numLoops() const { return _loopAnalysisArena.numPopped(); }
 
     // Determine how the DP position at the end of each loop change wrt to the DP position at the
     // end of the loop in the previous iteration of the _analyzed_ meta-loop.
@@ -278,20 +282,22 @@ public:
     // is valid.
     DataPointer startDataPointer() const { return _startDataPointer; }
 
-    const std::vector<std::shared_ptr<SequenceAnalysis>> sequenceAnalysisResults() const {
+    // The returned analyses remain valid until the next meta-loop analysis
+    const std::vector<const SequenceAnalysis*>& sequenceAnalysisResults() const {
         return _seqAnalysis;
     }
-    const std::shared_ptr<SequenceAnalysis> sequenceAnalysis(int sequenceIndex) const {
+    const SequenceAnalysis* sequenceAnalysis(int sequenceIndex) const {
         return _seqAnalysis[sequenceIndex % _metaLoopPeriod];
     }
     // Assumes isLoop(sequenceIndex) == true
-    const std::shared_ptr<LoopAnalysis> loopAnalysis(int sequenceIndex) const {
-        return std::dynamic_pointer_cast<LoopAnalysis>(sequenceAnalysis(sequenceIndex));
+    const LoopAnalysis* loopAnalysis(int sequenceIndex) const {
+        assert(isLoop(sequenceIndex));
+        return static_cast<const LoopAnalysis*>(sequenceAnalysis(sequenceIndex));
     }
 
     // Returns an analysis of a fixed-size loop as if it was a plain sequence.
-    std::shared_ptr<SequenceAnalysis> unrolledLoopSequenceAnalysis(const ExecutionState &execState,
-                                                                   int sequenceIndex) const;
+    const SequenceAnalysis* unrolledLoopSequenceAnalysis(const ExecutionState &execState,
+                                                         int sequenceIndex) const;
 
     const std::vector<LoopBehavior>& loopBehaviors() const { return _loopBehaviors; }
 
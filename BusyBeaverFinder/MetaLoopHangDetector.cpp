@@ -8,22 +8,20 @@
 
 #include "MetaLoopHangDetector.h"
 
-bool MetaLoopHangDetector::shouldCheckNow() const {
-    auto loopRunState = _execution.getLoopRunState();
-    return (// Only check at start and end of loops
-            (loopRunState == LoopRunState::STARTED || loopRunState == LoopRunState::ENDED)
-            // There should be a meta-loop
-            && _execution.getMetaRunSummary().isInsideLoop()
-            && (// The proof phase should also consider loop starts
-                _activeChecker != nullptr
-                // Perform analysis only when the inner-loop is about to finish
-                || loopRunState == LoopRunState::ENDED));
+#include "HangCertificate.h"
+
+bool MetaLoopHangDetector::shouldCheckNow(HangDetectionEvents events) const {
+    return (// The proof phase should also consider loop starts
+            _activeChecker != nullptr
+            // Perform analysis only when the inner-loop is about to finish
+            || (events & META_LOOP_ENDED_EVENT) != 0);
 }
 
 void MetaLoopHangDetector::reset() {
     HangDetector::reset();
 
     _activeChecker = nullptr;
+    _activeCheckerStats = nullptr;
     _activeHang = HangType::UNKNOWN;
     _activeHangProofResult = Trilian::MAYBE;
 
@@ -45,12 +43,16 @@ bool MetaLoopHangDetector::preparePeriodicHangCheck() {
                    + runSummary.getRunBlockLength(endRunBlockIndex));
     // Loop period in program blocks
     int loopPeriod = loopEnd - loopStart;
-    if (!_loopAnalysis.analyzeLoop(&_execution.getRunHistory()[loopStart], loopPeriod)) {
+    auto& runHistory = _execution.getRunHistory();
+    if (!trackAnalysis(_periodicCheckerStats, [&]() {
+        return _loopAnalysis.analyzeLoop(&runHistory[loopStart], loopPeriod);
+    })) {
         return false;
     }
 
     _periodicHangChecker.init(&_loopAnalysis, loopStart);
     _activeChecker = &_periodicHangChecker;
+    _activeCheckerStats = &_periodicCheckerStats;
     _activeHang = HangType::NESTED_PERIODIC;
     _activeHangProofResult = Trilian::MAYBE;
 
@@ -58,11 +60,14 @@ bool MetaLoopHangDetector::preparePeriodicHangCheck() {
 }
 
 bool MetaLoopHangDetector::prepareGliderHangCheck() {
-    if (!_gliderHangChecker.init(&_metaLoopAnalysis, _execution)) {
+    if (!trackAnalysis(_gliderCheckerStats, [this]() {
+        return _gliderHangChecker.init(&_metaLoopAnalysis, _execution);
+    })) {
         return false;
     }
 
     _activeChecker = &_gliderHangChecker;
+    _activeCheckerStats = &_gliderCheckerStats;
     _activeHang = HangType::APERIODIC_GLIDER;
     _activeHangProofResult = Trilian::MAYBE;
 
@@ -70,11 +75,14 @@ bool MetaLoopHangDetector::prepareGliderHangCheck() {
 }
 
 bool MetaLoopHangDetector::prepareSweepHangCheck() {
-    if (!_regularSweepHangChecker.init(&_metaLoopAnalysis, _execution)) {
+    if (!trackAnalysis(_regularSweepCheckerStats, [this]() {
+        return _regularSweepHangChecker.init(&_metaLoopAnalysis, _execution);
+    })) {
         return false;
     }
 
     _activeChecker = &_regularSweepHangChecker;
+    _activeCheckerStats = &_regularSweepCheckerStats;
     _activeHang = HangType::REGULAR_SWEEP;
     _activeHangProofResult = Trilian::MAYBE;
 
@@ -82,17 +90,35 @@ bool MetaLoopHangDetector::prepareSweepHangCheck() {
 }
 
 bool MetaLoopHangDetector::prepareIrregularSweepHangCheck() {
-    if (!_irregularSweepHangChecker.init(&_metaLoopAnalysis, _execution)) {
+    if (!trackAnalysis(_irregularSweepCheckerStats, [this]() {
+        return _irregularSweepHangChecker.init(&_metaLoopAnalysis, _execution);
+    })) {
         return false;
     }
 
     _activeChecker = &_irregularSweepHangChecker;
+    _activeCheckerStats = &_irregularSweepCheckerStats;
     _activeHang = HangType::IRREGULAR_SWEEP;
     _activeHangProofResult = Trilian::MAYBE;
 
     return true;
 }
 
+bool MetaLoopHangDetector::prepareCounterHangCheck() {
+    if (!trackAnalysis(_counterCheckerStats, [this]() {
+        return _counterHangChecker.init(&_metaLoopAnalysis, _execution);
+    })) {
+        return false;
+    }
+
+    _activeChecker = &_counterHangChecker;
+    _activeCheckerStats = &_counterCheckerStats;
+    _activeHang = HangType::AFFINE_COUNTER;
+    _activeHangProofResult = Trilian::MAYBE;
+
+    return true;
+}
+
 bool MetaLoopHangDetector::analyzeHangBehaviour() {
     if (_metaLoopAnalysis.isInitialized()) {
         if (!_metaLoopAnalysis.isAnalysisStillValid(_execution)) {
@@ -104,7 +130,9 @@ bool MetaLoopHangDetector::analyzeHangBehaviour() {
     // Redo meta-loop analysis if it is not valid, or there is no active checker. The latter may
     // happen when the meta-loop analysis did not (yet) latch onto the desired regularity.
     if (!_metaLoopAnalysis.isInitialized() || !_activeChecker) {
-        if (!_metaLoopAnalysis.analyzeMetaLoop(_execution)) {
+        if (!trackAnalysis(_metaLoopAnalysisStats, [this]() {
+            return _metaLoopAnalysis.analyzeMetaLoop(_execution);
+        })) {
             return false;
         }
     }
@@ -121,10 +149,11 @@ bool MetaLoopHangDetector::analyzeHangBehaviour() {
     }
 
     if (_metaLoopAnalysis.isRegular()) {
-        return prepareGliderHangCheck() || prepareSweepHangCheck();
+        return (prepareGliderHangCheck() || prepareSweepHangCheck()
+                || prepareCounterHangCheck());
     }
 
-    return prepareIrregularSweepHangCheck();
+    return prepareIrregularSweepHangCheck() || prepareCounterHangCheck();
 
     // TODO: Check which programs are not covered by the existing checkers
     return false;
@@ -134,7 +163,9 @@ Trilian MetaLoopHangDetector::proofHang() {
     assert(_activeChecker != nullptr);
 
     if (_activeHangProofResult == Trilian::MAYBE) {
-        _activeHangProofResult = _activeChecker->proofHang(_execution);
+        _activeHangProofResult = trackProof(*_activeCheckerStats, [this]() {
+            return _activeChecker->proofHang(_execution);
+        });
 
         if (_activeHangProofResult == Trilian::NO) {
             _activeChecker = nullptr;
@@ -144,6 +175,42 @@ Trilian MetaLoopHangDetector::proofHang() {
     return _activeHangProofResult;
 }
 
+bool MetaLoopHangDetector::getCertificate(HangCertificate& certificate) const {
+    if (_activeChecker != &_counterHangChecker || _activeHangProofResult != Trilian::YES) {
+        return false;
+    }
+
+    certificate.type = CertificateType::AFFINE_COUNTER;
+    _counterHangChecker.getCertificate(certificate.counter);
+
+    return true;
+}
+
+const HangDetectorStats& MetaLoopHangDetector::checkerStats(HangType hangType) const {
+    switch (hangType) {
+        case HangType::NESTED_PERIODIC: return _periodicCheckerStats;
+        case HangType::APERIODIC_GLIDER: return _gliderCheckerStats;
+        case HangType::REGULAR_SWEEP: return _regularSweepCheckerStats;
+        case HangType::IRREGULAR_SWEEP: return _irregularSweepCheckerStats;
+        case HangType::AFFINE_COUNTER: return _counterCheckerStats;
+        default:
+            // Not detected by any of the checkers
+            assert(false);
+            return _metaLoopAnalysisStats;
+    }
+}
+
+void MetaLoopHangDetector::dumpStats(std::ostream &os) const {
+    HangDetector::dumpStats(os);
+
+    os << "  MetaLoopAnalysis: " << _metaLoopAnalysisStats << std::endl;
+    os << "  PeriodicChecker: " << _periodicCheckerStats << std::endl;
+    os << "  GliderChecker: " << _gliderCheckerStats << std::endl;
+    os << "  RegularSweepChecker: " << _regularSweepCheckerStats << std::endl;
+    os << "  IrregularSweepChecker: " << _irregularSweepCheckerStats << std::endl;
+    os << "  CounterChecker: " << _counterCheckerStats << std::endl;
+}
+
 void MetaLoopHangDetector::dump() const {
     std::cout << *this << std::endl;
 }
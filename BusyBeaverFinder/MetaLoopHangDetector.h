@@ -9,6 +9,7 @@
 
 #include "HangDetector.h"
 
+#include "CounterHangChecker.h"
 #include "GliderHangChecker.h"
 #include "HangChecker.h"
 #include "MetaLoopAnalysis.h"
@@ -22,19 +23,31 @@ class MetaLoopHangDetector : public HangDetector {
     GliderHangChecker _gliderHangChecker;
     SweepHangChecker _regularSweepHangChecker;
     IrregularSweepHangChecker _irregularSweepHangChecker;
+    CounterHangChecker _counterHangChecker;
     LoopAnalysis _loopAnalysis;
 
     HangChecker* _activeChecker;
     HangType _activeHang;
     Trilian _activeHangProofResult;
 
+    // Stats of the meta-loop analysis and of each checker. For the checkers, analysis refers to
+    // their initialization.
+    HangDetectorStats _metaLoopAnalysisStats;
+    HangDetectorStats _periodicCheckerStats;
+    HangDetectorStats _gliderCheckerStats;
+    HangDetectorStats _regularSweepCheckerStats;
+    HangDetectorStats _irregularSweepCheckerStats;
+    HangDetectorStats _counterCheckerStats;
+    HangDetectorStats* _activeCheckerStats;
+
     bool preparePeriodicHangCheck();
     bool prepareGliderHangCheck();
     bool prepareSweepHangCheck();
     bool prepareIrregularSweepHangCheck();
+    bool prepareCounterHangCheck();
 
   protected:
-    bool shouldCheckNow() const override;
+    bool shouldCheckNow(HangDetectionEvents events) const override;
     bool analyzeHangBehaviour() override;
     Trilian proofHang() override;
 
@@ -43,8 +56,22 @@ class MetaLoopHangDetector : public HangDetector {
 
     void reset() override;
     HangType hangType() const override { return _activeHang; }
+    const char* name() const override { return "MetaLoop"; }
+
+    // Only checks at start and end of loops that are part of a meta-loop
+    HangDetectionEvents subscribedEvents() const override {
+        return META_LOOP_STARTED_EVENT | META_LOOP_ENDED_EVENT;
+    }
     const MetaLoopAnalysis& metaLoopAnalysis() { return _metaLoopAnalysis; };
 
+    const HangDetectorStats& metaLoopAnalysisStats() const { return _metaLoopAnalysisStats; }
+    // Returns the stats of the checker that detects the given hang type
+    const HangDetectorStats& checkerStats(HangType hangType) const;
+
+    // Only counter hangs provide a certificate
+    bool getCertificate(HangCertificate& certificate) const override;
+
+    void dumpStats(std::ostream &os) const override;
     void dump() const override;
 
     friend std::ostream &operator<<(std::ostream&, const MetaLoopHangDetector&);
@@ -0,0 +1,61 @@
+//
+//  MetricsWriter.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 18/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "MetricsWriter.h"
+
+MetricsWriter::MetricsWriter(const std::string& filename)
+    : _file(filename, std::ios::app)
+{
+    if (_file) {
+        _thread = std::thread(&MetricsWriter::writeLoop, this);
+    }
+}
+
+MetricsWriter::~MetricsWriter() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _condition.notify_one();
+
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void MetricsWriter::writeLine(const std::string& line) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _buffer += line;
+        _buffer += '\n';
+    }
+    _condition.notify_one();
+}
+
+void MetricsWriter::writeLoop() {
+    std::string lines;
+
+    while (true) {
+        bool stop;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]() { return _stop || !_buffer.empty(); });
+
+            lines.swap(_buffer);
+            stop = _stop;
+        }
+
+        if (!lines.empty()) {
+            _file << lines;
+            _file.flush();
+            lines.clear();
+        }
+
+        if (stop) break;
+    }
+}
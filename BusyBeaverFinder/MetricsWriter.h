@@ -0,0 +1,40 @@
+//
+//  MetricsWriter.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 18/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Appends lines to a metrics file. Lines are buffered and written by a background thread, so
+// that file I/O does not slow down the search.
+class MetricsWriter {
+    std::ofstream _file;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    // Lines that still need to be written. Guarded by _mutex.
+    std::string _buffer;
+    bool _stop = false;
+
+    std::thread _thread;
+
+    void writeLoop();
+
+public:
+    // Opens the file for appending
+    MetricsWriter(const std::string& filename);
+    ~MetricsWriter();
+
+    bool isOpen() const { return _file.is_open(); }
+
+    // Adds the line to the buffer. A newline is appended to it.
+    void writeLine(const std::string& line);
+};
@@ -13,11 +13,6 @@
 PeriodicHangDetector::PeriodicHangDetector(const ExecutionState& execution)
     : HangDetector(execution) {}
 
-bool PeriodicHangDetector::shouldCheckNow() const {
-    return (_execution.getLoopRunState() == LoopRunState::RUNNING
-            && _execution.getRunSummary().isAtEndOfLoop());
-}
-
 bool PeriodicHangDetector::analyzeHangBehaviour() {
     const RunHistory& runHistory = _execution.getRunHistory();
     const RunSummary& runSummary = _execution.getRunSummary();
@@ -20,8 +20,6 @@ protected:
     LoopAnalysis _loop;
     PeriodicHangChecker _checker;
 
-    bool shouldCheckNow() const override;
-
     // Analyses the loop. Returns YES if it exhibits periodic hang behavior. In that case, _loop
     // and _loopStart should point to the analyzed periodic loop and its starting point.
     bool analyzeHangBehaviour() override;
@@ -32,6 +30,10 @@ public:
     PeriodicHangDetector(const ExecutionState& execution);
 
     HangType hangType() const override { return HangType::PERIODIC; }
+    const char* name() const override { return "Periodic"; }
+
+    // Checks at the end of each loop iteration, as periodic loops never exit.
+    HangDetectionEvents subscribedEvents() const override { return LOOP_ITERATION_EVENT; }
 
     void dump() const override;
 
@@ -10,6 +10,8 @@
 
 #include "Program.h"
 
+#include "Utils.h"
+
 const char ins_chars[5] = {'.', '_', 'o', '*', 'X' };
 const char web_chars[5] = {'_', '_', 'o', '*', 'X' };
 
@@ -107,11 +109,33 @@ void Program::clear() {
         std::fill(it, it + _size.width, Ins::UNSET);
         it += paddedRowSize;
     }
+
+    _noopsAhead.clear();
+    _noopsAhead.resize(_instructions.size() * 4, 0);
 }
 
 void Program::clone(Program& dest) const {
     dest._size = _size;
     dest._instructions = _instructions;
+    dest._noopsAhead = _noopsAhead;
+}
+
+void Program::updateNoopsAhead(int index) {
+    for (int d = 0; d < 4; d++) {
+        int offset = dx[d] + dy[d] * (_size.width + 1);
+        int noops = (_instructions[index] == Ins::NOOP) ? _noopsAhead[index * 4 + d] + 1 : 0;
+
+        // Update the run of NOOPs that precedes the instruction as well as the instruction before
+        // it. The run always ends, as the program is surrounded by DONE instructions.
+        int i = index - offset;
+        while (true) {
+            _noopsAhead[i * 4 + d] = noops;
+            if (_instructions[i] != Ins::NOOP) break;
+
+            noops++;
+            i -= offset;
+        }
+    }
 }
 
 std::string Program::toSimpleString(const char* charEncoding, bool addLineBreaks) const {
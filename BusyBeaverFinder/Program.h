@@ -27,6 +27,13 @@ class Program {
     // Instruction array
     std::vector<Ins> _instructions;
 
+    // For each instruction (including the border) and each direction, the number of consecutive
+    // NOOP instructions that follow it. This lets block building skip straight to the next
+    // instruction that matters. It is updated whenever a NOOP is set or cleared.
+    std::vector<int8_t> _noopsAhead;
+
+    void updateNoopsAhead(int index);
+
     InstructionPointer getInstructionP(int col, int row) const {
         return InstructionPointer { .col = (int8_t)col, .row = (int8_t)row };
     }
@@ -52,14 +59,35 @@ public:
         return ProgramPointer { .p = { .col = 0, .row = -1 }, .dir = Dir::UP };
     }
 
-    int indexFor(InstructionPointer insP) const {
-        return (insP.col + 1) + (insP.row + 1) * (_size.width + 1);
+    // The instructions are stored row by row, with a border of DONE instructions. Adjacent rows
+    // share a single border cell. This can be invoked with a width that is a compile-time
+    // constant to optimize the calculation.
+    static constexpr int indexFor(InstructionPointer insP, int width) {
+        return (insP.col + 1) + (insP.row + 1) * (width + 1);
     }
+    int indexFor(InstructionPointer insP) const { return indexFor(insP, _size.width); }
+
+    void setInstruction(InstructionPointer insP, Ins ins) {
+        int index = indexFor(insP);
+        bool wasNoop = _instructions[index] == Ins::NOOP;
+
+        _instructions[index] = ins;
 
-    void setInstruction(InstructionPointer insP, Ins ins) { _instructions[indexFor(insP)] = ins; }
-    void clearInstruction(InstructionPointer insP) { _instructions[indexFor(insP)] = Ins::UNSET; }
+        if (wasNoop != (ins == Ins::NOOP)) {
+            updateNoopsAhead(index);
+        }
+    }
+    void clearInstruction(InstructionPointer insP) { setInstruction(insP, Ins::UNSET); }
     Ins getInstruction(InstructionPointer insP) const { return _instructions[indexFor(insP)]; }
 
+    // Returns the number of NOOP instructions that directly follow the program pointer.
+    int noopsAhead(ProgramPointer pp) const {
+        return _noopsAhead[indexFor(pp.p) * 4 + static_cast<int>(pp.dir)];
+    }
+    int noopsAhead(int index, Dir dir) const {
+        return _noopsAhead[index * 4 + static_cast<int>(dir)];
+    }
+
     std::string toPlainString() const;
     std::string toWebString() const;
     std::string toString() const;
@@ -9,25 +9,61 @@
 #include "ProgressTracker.h"
 
 #include <iostream>
+#include <sstream>
 
 #include "Searcher.h"
+#include "HangCertificate.h"
 #include "HangDetector.h"
+#include "MetricsWriter.h"
 #include "Program.h"
 
+const char* hangTypeNames[numHangTypes] = {
+    "UNKNOWN", "NO_DATA_LOOP", "NO_EXIT", "PERIODIC", "NESTED_PERIODIC", "REGULAR_SWEEP",
+    "IRREGULAR_SWEEP", "APERIODIC_GLIDER", "TRANSLATED_CYCLER", "AFFINE_COUNTER",
+    "CLOSED_TAPE", "UNDETECTED"
+};
+
+const char* pruningRuleNames[numPruningRules] = {
+    "NONE", "CONSTANT", "SIGN", "CONGRUENCE"
+};
+
 ProgressTracker::ProgressTracker() :
     _runLengthHistogram(),
     _hangDetectionHistogram(3, 2)
 {
     _startTime = clock();
+    _wallStartTime = std::chrono::steady_clock::now();
 
     for (int i = 0; i < numHangTypes; i++) {
         _totalHangsByType[i] = 0;
         _totalErrorsByType[i] = 0;
     }
+    for (int i = 0; i < numPruningRules; i++) {
+        _totalStaticHangsByRule[i] = 0;
+    }
 
     _lastDetectedHang = nullptr;
 }
 
+ProgressTracker::~ProgressTracker() {}
+
+bool ProgressTracker::setMetricsFile(const std::string& filename) {
+    _metricsWriter = std::make_unique<MetricsWriter>(filename);
+
+    if (!_metricsWriter->isOpen()) {
+        _metricsWriter = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void ProgressTracker::addSteps() {
+    if (_searcher) {
+        _totalSteps += _searcher->getNumSteps();
+    }
+}
+
 void ProgressTracker::report() {
     if (++_total % _dumpStatsPeriod == 0) {
         dumpStats();
@@ -36,6 +72,7 @@ void ProgressTracker::report() {
 
 void ProgressTracker::reportDone(int totalSteps) {
     _totalSuccess++;
+    _totalSteps += totalSteps;
     _runLengthHistogram.add(totalSteps);
 
     if (totalSteps > _dumpSuccessStepsLimit) {
@@ -62,6 +99,8 @@ void ProgressTracker::reportDone(int totalSteps) {
 }
 
 void ProgressTracker::reportError() {
+    addSteps();
+
     if (_detectedHang != HangType::UNDETECTED) {
         // Hang correctly signalled
         _totalErrorsByType[(int)_detectedHang]++;
@@ -79,6 +118,8 @@ void ProgressTracker::reportError() {
 }
 
 void ProgressTracker::reportAssumedHang() {
+    addSteps();
+
     if (_detectedHang != HangType::UNDETECTED) {
         // Hang correctly signalled
         _totalHangsByType[(int)_detectedHang]++;
@@ -91,13 +132,24 @@ void ProgressTracker::reportAssumedHang() {
             // Dump the assumed hang
             std::cout << "ASS " << _searcher->getProgramSpec() << std::endl;
         }
+        if (_collectAssumedHangs) {
+            _assumedHangs.push_back(_searcher->getProgramSpec());
+        }
     }
 
     report();
 }
 
+void ProgressTracker::reportProvenAssumedHangs(HangType hangType, long num) {
+    assert(num <= _totalHangsByType[(int)HangType::UNDETECTED]);
+
+    _totalHangsByType[(int)HangType::UNDETECTED] -= num;
+    _totalHangsByType[(int)hangType] += num;
+}
+
 void ProgressTracker::reportLateEscape(int numSteps) {
     _totalLateEscapes++;
+    _totalSteps += numSteps;
 
     std::cout << "ESC " << numSteps << " "
     << _searcher->getProgramSpec() << std::endl;
@@ -128,6 +180,7 @@ void ProgressTracker::reportDetectedHang(HangType hangType, bool executionWillCo
     }
 
     _totalHangsByType[(int)hangType]++;
+    _totalSteps += numSteps;
 
     report();
 }
@@ -136,9 +189,99 @@ void ProgressTracker::reportDetectedHang(std::shared_ptr<HangDetector> hangDetec
                                          bool executionWillContinue) {
     _lastDetectedHang = hangDetector;
 
+    if (_collectCertificates) {
+        CertifiedHang hang;
+        if (hangDetector->getCertificate(hang.certificate)) {
+            hang.programSpec = _searcher->getProgramSpec();
+            _certifiedHangs.push_back(std::move(hang));
+        }
+    }
+
     reportDetectedHang(hangDetector->hangType(), executionWillContinue);
 }
 
+void ProgressTracker::reportVerifiedHang(const std::string& programSpec, HangType hangType,
+                                         RunResult result, int numSteps) {
+    _totalSteps += numSteps;
+
+    switch (result) {
+        case RunResult::SUCCESS:
+            _totalSuccess++;
+            _runLengthHistogram.add(numSteps);
+            if (numSteps > _dumpSuccessStepsLimit) {
+                std::cout << "SUC " << numSteps << " " << programSpec << std::endl;
+            }
+            if (numSteps > _maxStepsSofar) {
+                _maxStepsSofar = numSteps;
+                _bestProgramSpec = programSpec;
+            }
+            break;
+        case RunResult::PROGRAM_ERROR:
+            _totalLateEscapes++;
+            std::cout << "ESC " << numSteps << " " << programSpec << std::endl;
+            break;
+        case RunResult::DATA_ERROR:
+            _totalErrorsByType[(int)hangType]++;
+            break;
+        case RunResult::DETECTED_HANG:
+        case RunResult::ASSUMED_HANG:
+            _totalHangsByType[(int)hangType]++;
+            break;
+        case RunResult::UNKNOWN:
+            assert(false);
+    }
+
+    if (result == RunResult::SUCCESS || result == RunResult::PROGRAM_ERROR) {
+        _totalFaultyHangs++;
+
+        std::cout << "False positive, type = " << (int)hangType << ", steps = " << numSteps
+        << ": " << programSpec << std::endl;
+    }
+
+    // Like other late escapes, these are not counted as programs
+    if (result != RunResult::PROGRAM_ERROR) {
+        report();
+    }
+}
+
+void ProgressTracker::reportStaticHang(PruningRule rule, bool executionWillContinue) {
+    _totalStaticHangsByRule[(int)rule]++;
+
+    reportDetectedHang(HangType::NO_EXIT, executionWillContinue);
+}
+
+void ProgressTracker::merge(const ProgressTracker& other) {
+    _total += other._total;
+    _totalSuccess += other._totalSuccess;
+    _totalFastExecutions += other._totalFastExecutions;
+    _totalCachedFastExecutions += other._totalCachedFastExecutions;
+    _totalLateEscapes += other._totalLateEscapes;
+    for (int i = 0; i < numHangTypes; i++) {
+        _totalHangsByType[i] += other._totalHangsByType[i];
+        _totalErrorsByType[i] += other._totalErrorsByType[i];
+    }
+    _totalFaultyHangs += other._totalFaultyHangs;
+    _totalEquivalent += other._totalEquivalent;
+    for (int i = 0; i < numPruningRules; i++) {
+        _totalStaticHangsByRule[i] += other._totalStaticHangsByRule[i];
+    }
+    _totalSteps += other._totalSteps;
+    _assumedHangs.insert(_assumedHangs.end(),
+                         other._assumedHangs.begin(), other._assumedHangs.end());
+    _certifiedHangs.insert(_certifiedHangs.end(),
+                           other._certifiedHangs.begin(), other._certifiedHangs.end());
+
+    _runLengthHistogram.add(other._runLengthHistogram);
+    _hangDetectionHistogram.add(other._hangDetectionHistogram);
+
+    if (other._maxStepsSofar > _maxStepsSofar) {
+        _maxStepsSofar = other._maxStepsSofar;
+        _bestProgramSpec = other._bestProgramSpec;
+    }
+    _maxStepsUntilHangDetection = std::max(_maxStepsUntilHangDetection,
+                                           other._maxStepsUntilHangDetection);
+}
+
 long ProgressTracker::getTotalDetectedErrors() const {
     long total = 0;
     for (int i = 0; i < numDetectedHangTypes; i++) {
@@ -181,6 +324,8 @@ void ProgressTracker::dumpStats() {
     std::cout << getTotalErrors()
     << ", Hangs=" << (getTotalHangs() - getTotalDetectedHangs()) << "/" << getTotalDetectedHangs()
     << ", Fast execs=" << getTotalLateEscapes() << "/" << getTotalFastExecutions()
+    << ", Cached=" << _totalCachedFastExecutions
+    << ", Equivalent=" << _totalEquivalent
     << std::endl;
 
     if (_searcher) {
@@ -196,6 +341,14 @@ void ProgressTracker::dumpStats() {
 
     dumpRunLengths();
     dumpHangStats();
+
+    if (_dumpHangDetectionProfile) {
+        dumpHangDetectionProfile();
+    }
+
+    if (_metricsWriter) {
+        writeMetrics();
+    }
 }
 
 void ProgressTracker::dumpRunLengths() {
@@ -216,6 +369,82 @@ void ProgressTracker::dumpHangStats() {
     << ", RSWEEP=" << _totalHangsByType[(int)HangType::REGULAR_SWEEP]
     << ", ISWEEP=" << _totalHangsByType[(int)HangType::IRREGULAR_SWEEP]
     << ", GLIDER=" << _totalHangsByType[(int)HangType::APERIODIC_GLIDER]
+    << ", TCYCLER=" << _totalHangsByType[(int)HangType::TRANSLATED_CYCLER]
+    << ", COUNTER=" << _totalHangsByType[(int)HangType::AFFINE_COUNTER]
+    << ", CLOSED=" << _totalHangsByType[(int)HangType::CLOSED_TAPE]
     << ", ASUMED=" << _totalHangsByType[(int)HangType::UNDETECTED]
     << std::endl;
+
+    std::cout << _timeStamp << ": Static hangs:";
+    for (int i = 0; i < numPruningRules; i++) {
+        std::cout << (i ? ", " : " ") << pruningRuleNames[i] << "=" << _totalStaticHangsByRule[i];
+    }
+    std::cout << std::endl;
+}
+
+void ProgressTracker::dumpHangDetectionProfile() {
+    if (!_searcher) return;
+
+    std::cout << _timeStamp << ": Hang detection profile" << std::endl;
+    _searcher->dumpHangDetectionProfile(std::cout);
+}
+
+void ProgressTracker::writeMetrics() {
+    std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - _wallStartTime;
+    double cpuTime = (clock() - _startTime) / (double)CLOCKS_PER_SEC;
+    double wallSecs = std::max(wallTime.count(), 1e-9);
+
+    auto writeHistogram = [](std::ostream &os, const LogHistogram& histogram) {
+        os << "[";
+        bool first = true;
+        for (auto& bin : histogram.getBins()) {
+            os << (first ? "" : ",") << "[" << bin.first << "," << bin.second << "]";
+            first = false;
+        }
+        os << "]";
+    };
+    auto writeCountsByHangType = [](std::ostream &os, const long* counts) {
+        os << "{";
+        for (int i = 0; i < numHangTypes; i++) {
+            os << (i ? "," : "") << "\"" << hangTypeNames[i] << "\":" << counts[i];
+        }
+        os << "}";
+    };
+
+    std::ostringstream os;
+    os << "{\"wallTime\":" << wallTime.count()
+    << ",\"cpuTime\":" << cpuTime
+    << ",\"programs\":" << _total
+    << ",\"programsPerSec\":" << _total / wallSecs
+    << ",\"steps\":" << _totalSteps
+    << ",\"stepsPerSec\":" << _totalSteps / wallSecs
+    << ",\"outcomes\":{"
+    << "\"successes\":" << _totalSuccess
+    << ",\"errors\":" << getTotalErrors()
+    << ",\"lateEscapes\":" << _totalLateEscapes
+    << ",\"detectedHangs\":" << getTotalDetectedHangs()
+    << ",\"assumedHangs\":" << _totalHangsByType[(int)HangType::UNDETECTED]
+    << "},\"hangs\":";
+    writeCountsByHangType(os, _totalHangsByType);
+    os << ",\"errors\":";
+    writeCountsByHangType(os, _totalErrorsByType);
+    os << ",\"staticHangs\":{";
+    for (int i = 0; i < numPruningRules; i++) {
+        os << (i ? "," : "") << "\"" << pruningRuleNames[i] << "\":" << _totalStaticHangsByRule[i];
+    }
+    os << "},\"falsePositives\":" << _totalFaultyHangs
+    << ",\"fastExecutions\":" << _totalFastExecutions
+    << ",\"cachedFastExecutions\":" << _totalCachedFastExecutions
+    << ",\"lateEscapes\":" << _totalLateEscapes
+    << ",\"equivalentPrograms\":" << _totalEquivalent
+    << ",\"runLengths\":";
+    writeHistogram(os, _runLengthHistogram);
+    os << ",\"hangDetectedAt\":";
+    writeHistogram(os, _hangDetectionHistogram);
+    os << ",\"maxStepsUntilHangDetection\":" << _maxStepsUntilHangDetection
+    << ",\"maxSteps\":" << _maxStepsSofar
+    << ",\"bestProgram\":\"" << _bestProgramSpec << "\""
+    << "}";
+
+    _metricsWriter->writeLine(os.str());
 }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <time.h>
+#include <chrono>
 #include <string>
 #include <memory>
 #include <vector>
@@ -16,6 +17,8 @@
 
 class Searcher;
 class HangDetector;
+class MetricsWriter;
+struct CertifiedHang;
 
 class ProgressTracker {
     int _dumpStatsPeriod = 100000;
@@ -23,6 +26,9 @@ class ProgressTracker {
     // This default works for 7x7 search
     int _dumpSuccessStepsLimit = 1000000;
     bool _dumpUndetectedHangs = false;
+    bool _dumpHangDetectionProfile = false;
+    bool _collectAssumedHangs = false;
+    bool _collectCertificates = false;
 
     // This can be a plain pointer, as unique_ptr ensures that a ProgressTracker is attached to
     // a single searcher at most.
@@ -31,11 +37,20 @@ class ProgressTracker {
     long _total = 0;
     long _totalSuccess = 0;
     long _totalFastExecutions = 0;
+    // Fast executions whose result was taken from the transposition table
+    long _totalCachedFastExecutions = 0;
     long _totalLateEscapes = 0;
     long _totalHangsByType[numHangTypes];
     long _totalErrorsByType[numHangTypes];
     long _totalFaultyHangs = 0;
+    // Programs that were not searched as they are equivalent to a program that was
+    long _totalEquivalent = 0;
+    // Hangs proven by static analysis, by the strongest rule the proof needed
+    long _totalStaticHangsByRule[numPruningRules];
+    // The sum of the steps of all completed program runs
+    long _totalSteps = 0;
     clock_t _startTime;
+    std::chrono::steady_clock::time_point _wallStartTime;
     double _timeStamp = 0;
 
     // Tracks after how many steps each (non-hanging) program terminates.
@@ -49,6 +64,12 @@ class ProgressTracker {
     int _maxStepsSofar = 0;
     std::string _bestProgramSpec;
 
+    // The assumed hangs, so that these can be analyzed further after the search
+    std::vector<std::string> _assumedHangs;
+
+    // The detected hangs whose detector provided a certificate
+    std::vector<CertifiedHang> _certifiedHangs;
+
     // Hang detector with details of the last detected specialized hang (i.e. hang that was
     // detected by a HangDetector).
     std::shared_ptr<HangDetector> _lastDetectedHang;
@@ -56,10 +77,16 @@ class ProgressTracker {
     // Stats on hang-detection speed and effectiveness
     int _maxStepsUntilHangDetection = 0;
 
+    // Optional machine-readable output. One JSON object is written each time stats are dumped.
+    std::unique_ptr<MetricsWriter> _metricsWriter;
+
     void report();
+    void addSteps();
+    void writeMetrics();
 
 public:
     ProgressTracker();
+    ~ProgressTracker();
 
     void setSearcher(Searcher* searcher) { _searcher = searcher; }
 
@@ -67,28 +94,62 @@ public:
     void setDumpStackPeriod(int val) { _dumpStackPeriod = val; }
     void setDumpUndetectedHangs(bool flag) { _dumpUndetectedHangs = flag; }
     void setDumpSuccessStepsLimit(int minSteps) { _dumpSuccessStepsLimit  = minSteps; }
+    void setDumpHangDetectionProfile(bool flag) { _dumpHangDetectionProfile = flag; }
+    bool getDumpHangDetectionProfile() const { return _dumpHangDetectionProfile; }
+    void setCollectAssumedHangs(bool flag) { _collectAssumedHangs = flag; }
+    void setCollectCertificates(bool flag) { _collectCertificates = flag; }
 
+    // Appends metrics in JSON Lines format to the given file. Returns false if the file cannot be
+    // opened.
+    bool setMetricsFile(const std::string& filename);
+
+    long getTotal() const { return _total; }
     long getTotalSuccess() const { return _totalSuccess; }
     long getTotalErrors() const;
     long getTotalHangs() const;
     long getTotalFastExecutions() const { return _totalFastExecutions; }
+    long getTotalCachedFastExecutions() const { return _totalCachedFastExecutions; }
     long getTotalLateEscapes() const { return _totalLateEscapes; }
     long getTotalDetectedErrors() const;
     long getTotalErrors(HangType hangType) const { return _totalErrorsByType[(int)hangType]; }
     long getTotalDetectedHangs() const;
     long getTotalHangs(HangType hangType) const { return _totalHangsByType[(int)hangType]; }
+    long getTotalStaticHangs(PruningRule rule) const { return _totalStaticHangsByRule[(int)rule]; }
+    long getTotalEquivalent() const { return _totalEquivalent; }
+    long getTotalSteps() const { return _totalSteps; }
 
     std::shared_ptr<HangDetector> getLastDetectedHang() const { return _lastDetectedHang; }
 
     int getMaxStepsFound() const { return _maxStepsSofar; }
+    const std::string& getBestProgramSpec() const { return _bestProgramSpec; }
+    const std::vector<std::string>& getAssumedHangs() const { return _assumedHangs; }
+    const std::vector<CertifiedHang>& getCertifiedHangs() const { return _certifiedHangs; }
+
+    // Adds the results tracked by the other tracker. This way, searches that run in parallel can
+    // each use their own tracker.
+    void merge(const ProgressTracker& other);
 
     void reportDone(int totalSteps);
     void reportError();
     void reportDetectedHang(HangType hangType, bool executionWillContinue);
     void reportDetectedHang(std::shared_ptr<HangDetector> hangDetector, bool executionWillContinue);
     void reportAssumedHang();
+    // Assumed hangs that were proven to hang after the search. They are moved to the given type.
+    void reportProvenAssumedHangs(HangType hangType, long num);
+    // A hang proven by static analysis. It is also counted as a NO_EXIT hang.
+    void reportStaticHang(PruningRule rule, bool executionWillContinue);
+
+    // The detected hang is verified in the background instead of by continuing its execution
+    void reportQueuedVerification() { _detectedHang = HangType::UNDETECTED; }
+    // The outcome of a background verification of a detected hang. A program that does not hang
+    // within the maximum number of steps is reported as a false positive.
+    void reportVerifiedHang(const std::string& programSpec, HangType hangType, RunResult result,
+                            int numSteps);
 
     void reportFastExecution() { _totalFastExecutions++; }
+    void reportCachedFastExecution() { _totalCachedFastExecutions++; }
+    // Programs that were skipped because they are equivalent to programs that were searched.
+    void reportEquivalentPrograms(long num) { _totalEquivalent += num; }
     // A "late escape" is a program that did not terminate while hang detection was enabled, but
     // whose execution escaped from its interpreted program during fast execution (at which time
     // the program cannot be expanded further).
@@ -96,5 +157,6 @@ public:
 
     void dumpStats();
     void dumpHangStats();
+    void dumpHangDetectionProfile();
     void dumpRunLengths();
 };
@@ -77,6 +77,10 @@ void RunSummaryBase::addRunBlock(int start, int sequenceId, int loopPeriod) {
             static_cast<int>(_runBlocks.size() - 1);
     }
     _runBlocks.emplace_back(start, sequenceId, loopPeriod);
+
+    if (loopPeriod) {
+        addedLoop(sequenceId, start, loopPeriod);
+    }
 }
 
 void RunSummaryBase::createRunBlock(int start, int end, int loopPeriod) {
@@ -104,17 +108,17 @@ void RunSummaryBase::createRunBlocks(int start, int end) {
 
         if (result != _lastOccurenceBeforeLoop.end()) {
             // Check if the run history matches the loop
+            // Note: Copy the loop properties, as adding run blocks may invalidate references
             auto& loopBlock = _runBlocks[result->second + 1];
             assert(loopBlock.isLoop());
 
-            auto seqNode = _sequenceBlocks[loopBlock.getSequenceId()];
-            int loopStart = seqNode._startIndex;
+            int loopSequenceId = loopBlock.getSequenceId();
             int loopPeriod = loopBlock.getLoopPeriod();
 
             int matchLen = 0;
             while (mid + matchLen < end &&
                    getRunUnitIdAt(mid + matchLen) ==
-                   getRunUnitIdAt(loopStart + matchLen % loopPeriod)) {
+                   getLoopUnitIdAt(loopSequenceId, matchLen % loopPeriod)) {
                 ++matchLen;
             }
 
@@ -126,7 +130,7 @@ void RunSummaryBase::createRunBlocks(int start, int end) {
                     createRunBlock(start, mid, 0);
                 }
 
-                addRunBlock(mid, loopBlock.getSequenceId(), loopPeriod);
+                addRunBlock(mid, loopSequenceId, loopPeriod);
 
                 createRunBlocks(mid + matchLen, end); // Recurse
 
@@ -151,6 +155,16 @@ void RunSummaryBase::resetPending() {
     _pending = -1;
 }
 
+int RunSummaryBase::firstReferencedRunUnit() const {
+    for (auto it = _runBlocks.crbegin(); it != _runBlocks.crend(); ++it) {
+        if (it->isLoop()) {
+            return it->getStartIndex();
+        }
+    }
+
+    return _pending;
+}
+
 int RunSummaryBase::getRunBlockLength(int startIndex, int endIndex) const {
     bool isLast = endIndex == getNumRunBlocks();
     int runUnitStartIndex = _runBlocks[startIndex].getStartIndex();
@@ -357,20 +371,26 @@ void RunSummaryBase::dumpCondensed(bool hideLegend) const {
         }
 
         if (j == numUnique) {
-            // First encounter of this block. So dump it
-            std::cout << sequenceIndex << " =";
-
-            int len = getRunBlockLength(i);
             if (runBlock->isLoop()) {
-                len = runBlock->getLoopPeriod();
-            }
+                std::cout << sequenceIndex << " =";
+                for (int k = 0; k < runBlock->getLoopPeriod(); k++) {
+                    std::cout << " " << getLoopUnitIdAt(sequenceIndex, k);
+                }
+                std::cout << std::endl;
+            } else {
+                int k = runBlock->getStartIndex();
+                if (k < firstRetainedRunUnit()) {
+                    // Its run units have been discarded. Dump a later occurrence instead.
+                    continue;
+                }
 
-            int k = runBlock->getStartIndex();
-            int end = k + len;
-            while (k < end) {
-                std::cout << " " << getRunUnitIdAt(k++);
+                std::cout << sequenceIndex << " =";
+                int end = k + getRunBlockLength(i);
+                while (k < end) {
+                    std::cout << " " << getRunUnitIdAt(k++);
+                }
+                std::cout << std::endl;
             }
-            std::cout << std::endl;
 
             helperArray[numUnique++] = sequenceIndex;
             if (numUnique == 64) {
@@ -381,9 +401,12 @@ void RunSummaryBase::dumpCondensed(bool hideLegend) const {
 }
 
 void RunSummaryBase::dump() const {
-    int runUnitIndex = 0;
+    int runUnitIndex = firstRetainedRunUnit();
     int numRunUnits = getNumRunUnits();
-    auto runBlock = _runBlocks.cbegin();
+    auto runBlock = std::lower_bound(_runBlocks.cbegin(), _runBlocks.cend(), runUnitIndex,
+                                     [](const RunBlock& rb, int index) {
+        return rb.getStartIndex() < index;
+    });
     int numPendingBlocks = 0;
     bool isLoop = false;
 
@@ -409,10 +432,52 @@ void RunSummaryBase::dump() const {
     std::cout << std::endl;
 }
 
+void RunHistory::clear() {
+    _blocks.clear();
+    _offset = 0;
+    _start = 0;
+}
+
+void RunHistory::discardBefore(int index) {
+    assert(index <= size());
+    _start = std::max(_start, index);
+
+    // Only compact when at least half of the stored blocks can be removed. This way, the cost of
+    // moving the retained blocks is amortized.
+    int numDiscarded = _start - _offset;
+    if (numDiscarded >= 256 && numDiscarded * 2 >= _blocks.size()) {
+        _blocks.erase(_blocks.begin(), _blocks.begin() + numDiscarded);
+        _offset = _start;
+    }
+}
+
+void RunSummary::reset() {
+    RunSummaryBase::reset();
+
+    _loopBlocks.clear();
+    _loopStart.clear();
+}
+
+void RunSummary::addedLoop(int sequenceId, int start, int loopPeriod) {
+    if (sequenceId >= _loopStart.size()) {
+        _loopStart.resize(sequenceId + 1, -1);
+    }
+    if (_loopStart[sequenceId] >= 0) {
+        return;
+    }
+
+    // The first occurrence of a loop always runs two iterations, so its history is complete
+    _loopStart[sequenceId] = (int)_loopBlocks.size();
+    for (int i = 0; i < loopPeriod; i++) {
+        _loopBlocks.push_back(_runHistory[start + i]);
+    }
+}
+
 int RunSummary::getDpDeltaOfProgramBlockSequence(int start, int end) const {
     int dpDelta = 0;
 
-    for (auto &programBlock : makeRange(_runHistory, start, end)) {
+    for (int i = start; i < end; i++) {
+        auto programBlock = _runHistory[i];
         if (!programBlock->isDelta()) {
             dpDelta += programBlock->getInstructionAmount();
         }
@@ -503,6 +568,20 @@ void MetaRunSummary::exitedLoop() {
     attemptLoopCollapse();
 }
 
+int MetaRunSummary::firstReferencedRunUnit() const {
+    int first = RunSummaryBase::firstReferencedRunUnit();
+
+    // A collapse re-groups the run blocks that the meta-loop detector refers to
+    if (_metaLoopDetector) {
+        int rbIndex = _metaLoopDetector->firstReferencedRunUnit();
+        if (rbIndex < getNumRunBlocks()) {
+            first = std::min(first, runBlockAt(rbIndex)->getStartIndex());
+        }
+    }
+
+    return first;
+}
+
 void MetaRunSummary::reset() {
     RunSummaryBase::reset();
 
@@ -92,9 +92,9 @@ class RunSummaryBase {
     // Value: Pair of results with first the equality result, and second the offset (if applicable)
     mutable std::map<std::pair<int, int>, std::pair<bool, int>> _rotationEqualityCache;
 
-    // Helper array required by findRepeatedSequence utility function
-    // Note: It is not owned by this class (and should therefore not be freed by it)
-    int* _helperBuf;
+    // Helper array required by findRepeatedSequence utility function. It grows as needed.
+    // Note: It is not owned by this class, as it is shared by summaries at different levels
+    std::vector<int>& _helperBuf;
 
     bool _identifyShortLoops {};
 
@@ -104,6 +104,13 @@ class RunSummaryBase {
     // Returns the identifier for the run unit at the given index in the run history
     virtual int getRunUnitIdAt(int runUnitIndex) const = 0;
 
+    // Returns the identifier of the run unit at the given index in the first iteration of the loop
+    // with the given sequence ID. By default, it is taken from the run history where the loop
+    // first occurred.
+    virtual int getLoopUnitIdAt(int sequenceId, int index) const {
+        return getRunUnitIdAt(_sequenceBlocks[sequenceId]._startIndex + index);
+    }
+
     int sequenceId(int start, int end);
 
     void addRunBlock(int start, int sequenceId, int loopPeriod);
@@ -127,20 +134,24 @@ protected:
     void resetPending();
     void createRunBlock(int start, int end, int loopPeriod);
     virtual void exitedLoop() {}
+    // Invoked when a loop run block is added
+    virtual void addedLoop(int sequenceId, int start, int loopPeriod) {}
+    // Returns the index of the first run unit in the history that has not been discarded
+    virtual int firstRetainedRunUnit() const { return 0; }
 
     // Returns true if this resulted in the creation of one or more RunBlocks
     template <class RunUnitHistory>
     bool processNewHistory(const RunUnitHistory& history);
 
 public:
-    RunSummaryBase(int* helperBuf) : _helperBuf(helperBuf) { reset(); }
+    RunSummaryBase(std::vector<int>& helperBuf) : _helperBuf(helperBuf) { reset(); }
 
     // Do not support copy and assignment to avoid accidental expensive copies. Run summaries
     // should be passed by reference.
     RunSummaryBase(const RunSummaryBase&) = delete;
     RunSummaryBase& operator=(const RunSummaryBase&) = delete;
 
-    int* getHelperBuffer() const { return _helperBuf; }
+    std::vector<int>& getHelperBuffer() const { return _helperBuf; }
 
     // Enables short-loop detection
     //
@@ -169,6 +180,10 @@ public:
     virtual void reset();
     virtual bool processNewRunUnits() = 0;
 
+    // Returns the index of the first run unit that this summary may still refer to. These are
+    // the units of the last loop and any units that follow it.
+    virtual int firstReferencedRunUnit() const;
+
     bool isInsideLoop() const { return _loop >= 0; }
     int getLoopPeriod() const { return _runBlocks.back().getLoopPeriod(); }
     int getLoopIteration() const;
@@ -200,10 +215,6 @@ public:
         return getRunBlockLength((int)(block - &_runBlocks[0]));
     }
 
-    int getStartIndexForSequence(int sequenceId) const {
-        return _sequenceBlocks[sequenceId]._startIndex;
-    }
-
     // Returns the index of the last loop with given sequenceId that has at least the given length.
     std::optional<int> findLoopOfLength(int sequenceId, int length) const;
 
@@ -221,19 +232,69 @@ public:
     void dump() const;
 };
 
-typedef std::vector<const ProgramBlock *> RunHistory;
+/* The program blocks executed during hang detection. Blocks are indexed by their position in the
+ * full history, but blocks that are no longer referred to can be discarded. This way, memory use
+ * does not grow with the length of the hang detection window. The retained blocks are stored
+ * contiguously, so that analyses can take pointers into the history.
+ */
+class RunHistory {
+    std::vector<const ProgramBlock *> _blocks;
+
+    // The index of the first stored block
+    int _offset = 0;
+    // The index of the first retained block. Blocks before it may still be stored until the
+    // storage is compacted.
+    int _start = 0;
+
+public:
+    size_t size() const { return _offset + _blocks.size(); }
+    int firstIndex() const { return _start; }
+
+    const ProgramBlock* const& operator[](int index) const {
+        assert(index >= _start);
+        return _blocks[index - _offset];
+    }
+    const ProgramBlock* const& at(int index) const {
+        assert(index >= _start);
+        return _blocks.at(index - _offset);
+    }
+    const ProgramBlock* back() const { return _blocks.back(); }
+
+    // Iterates over the retained blocks
+    auto begin() const { return _blocks.cbegin() + (_start - _offset); }
+    auto end() const { return _blocks.cend(); }
+
+    void push_back(const ProgramBlock* block) { _blocks.push_back(block); }
+    void clear();
+
+    // Discards the blocks before the given index
+    void discardBefore(int index);
+};
 
 class RunSummary : public RunSummaryBase {
     const RunHistory &_runHistory;
 
+    // One iteration of each loop. The blocks of the loop with a given sequence ID start at
+    // _loopBlocks[_loopStart[sequenceId]]. This way, loops can be analyzed after the run history
+    // where they first occurred has been discarded.
+    std::vector<const ProgramBlock *> _loopBlocks;
+    std::vector<int> _loopStart;
+
     int getDpDeltaOfProgramBlockSequence(int start, int end) const;
 
     int getRunUnitIdAt(int runUnitIndex) const override {
         return _runHistory[runUnitIndex]->getStartIndex();
     };
+    int getLoopUnitIdAt(int sequenceId, int index) const override {
+        return getLoopBlocks(sequenceId)[index]->getStartIndex();
+    }
+
+protected:
+    void addedLoop(int sequenceId, int start, int loopPeriod) override;
+    int firstRetainedRunUnit() const override { return _runHistory.firstIndex(); }
 
 public:
-    RunSummary(const RunHistory &runHistory, int* helperBuf)
+    RunSummary(const RunHistory &runHistory, std::vector<int>& helperBuf)
     : RunSummaryBase(helperBuf), _runHistory(runHistory) {}
 
     // Do not support copy and assignment to avoid accidental expensive copies. Run summaries
@@ -245,6 +306,12 @@ public:
     // to lastRunBlock (exclusive).
     int getDpDelta(int firstRunBlock, int lastRunBlock) const;
 
+    // Returns the program blocks of the first iteration of the loop with the given sequence ID
+    const ProgramBlock* const* getLoopBlocks(int sequenceId) const {
+        return &_loopBlocks[_loopStart[sequenceId]];
+    }
+
+    void reset() override;
     bool processNewRunUnits() override { return processNewHistory(_runHistory); };
 };
 
@@ -267,7 +334,7 @@ protected:
     void exitedLoop() override;
 
 public:
-    MetaRunSummary(const std::vector<RunBlock> &runHistory, int* helperBuf)
+    MetaRunSummary(const std::vector<RunBlock> &runHistory, std::vector<int>& helperBuf)
     : RunSummaryBase(helperBuf), _runHistory(runHistory) {}
 
     // Do not support copy and assignment to avoid accidental expensive copies. Run summaries
@@ -279,6 +346,9 @@ public:
 
     int rewriteCount() const { return _rewriteCount; }
     bool processNewRunUnits() override { return processNewHistory(_runHistory); };
+
+    // Also includes the run blocks that an attempt to collapse loops may still refer to
+    int firstReferencedRunUnit() const override;
 };
 
 template <class RunUnitHistory>
@@ -288,8 +358,12 @@ bool RunSummaryBase::processNewHistory(const RunUnitHistory& history) {
 
     while (_processed < history.size()) {
         if (_loop < 0) {
-            int loopPeriod = findRepeatedSequence(&history[_pending], _helperBuf,
-                                                  _processed - _pending + 1);
+            int len = _processed - _pending + 1;
+            if (len / 2 >= _helperBuf.size()) {
+                _helperBuf.resize(std::max(len, 64));
+            }
+
+            int loopPeriod = findRepeatedSequence(&history[_pending], _helperBuf.data(), len);
             if (loopPeriod > 0) {                           // Start of new loop
                 _loop = _processed + 1 - loopPeriod * 2;
 
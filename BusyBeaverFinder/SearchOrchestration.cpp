@@ -8,6 +8,8 @@
 
 #include "SearchOrchestration.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -15,9 +17,7 @@
 #include "ExhaustiveSearcher.h"
 #include "Utils.h"
 
-void OrchestratedSearchRunner::addInstructionsUntilTurn(std::vector<Ins> &stack,
-                                                        int numNoop,
-                                                        int numData) {
+void addInstructionsUntilTurn(std::vector<Ins> &stack, int numNoop, int numData) {
     while (numNoop-- > 0) {
         stack.push_back(Ins::NOOP);
     }
@@ -27,8 +27,8 @@ void OrchestratedSearchRunner::addInstructionsUntilTurn(std::vector<Ins> &stack,
     stack.push_back(Ins::TURN);
 }
 
-void OrchestratedSearchRunner::run() {
-    auto size = _searcher.getProgramSize();
+void visitOrchestratedSubTrees(ProgramSize size,
+                               std::function<void(const std::vector<Ins>&)> visitor) {
     std::vector<Ins> resumeStack;
 
     // Only the number of DATA instructions before the first TURN matters, not their position, as
@@ -60,7 +60,7 @@ void OrchestratedSearchRunner::run() {
 
                         addInstructionsUntilTurn(resumeStack, numNoop2, numData2);
 
-                        _searcher.searchSubTree(resumeStack);
+                        visitor(resumeStack);
 
                         while (resumeStack.size() > sizeBefore) {
                             resumeStack.pop_back();
@@ -68,17 +68,26 @@ void OrchestratedSearchRunner::run() {
                     }
                 }
             } else {
-                _searcher.searchSubTree(resumeStack);
+                visitor(resumeStack);
             }
         }
     }
 }
 
-void ResumeSearchRunner::run() {
+template <int maxProgramSize, int programWidth>
+void BasicOrchestratedSearchRunner<maxProgramSize, programWidth>::run() {
+    visitOrchestratedSubTrees(_searcher.getProgramSize(), [this](const std::vector<Ins>& stack) {
+        _searcher.searchSubTree(stack);
+    });
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicResumeSearchRunner<maxProgramSize, programWidth>::run() {
     _searcher.search(std::make_unique<ResumeFromProgram>(_programSpec));
 }
 
-void LateEscapeSearchRunner::run() {
+template <int maxProgramSize, int programWidth>
+void BasicLateEscapeSearchRunner<maxProgramSize, programWidth>::run() {
     std::ifstream input(_programFile);
     if (!input) {
         std::cerr << "Could not read file" << std::endl;
@@ -98,6 +107,120 @@ void LateEscapeSearchRunner::run() {
     }
 }
 
+template <int maxProgramSize, int programWidth>
+void BasicSubTreeSearchRunner<maxProgramSize, programWidth>::run() {
+    std::ifstream input(_stackFile);
+    if (!input) {
+        std::cerr << "Could not read file" << std::endl;
+        return;
+    }
+
+    std::string line;
+    while (getline(input, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream iss(line);
+        std::vector<Ins> stack;
+        loadResumeStackFromStream(iss, stack);
+
+        if (!stack.empty()) {
+            _searcher.searchSubTree(stack);
+        }
+    }
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicBeamSearchRunner<maxProgramSize, programWidth>::run() {
+    _searcher.search();
+}
+
+template <int maxProgramSize, int programWidth>
+void BasicEstimateSearchRunner<maxProgramSize, programWidth>::run() {
+    double totalPrograms = 0, totalTime = 0;
+    double programsVariance = 0, timeVariance = 0;
+
+    auto dumpEstimate = [](const SampleStats& programs, const SampleStats& time) {
+        std::cout
+        << "Programs=" << programs.mean() << " ±" << programs.confidenceInterval()
+        << ", CPU hours=" << time.mean() / 3600 << " ±" << time.confidenceInterval() / 3600
+        << std::endl;
+    };
+
+    visitOrchestratedSubTrees(_searcher.getProgramSize(), [&](const std::vector<Ins>& stack) {
+        SampleStats programs, time;
+
+        for (int i = 0; i < _numProbes; i++) {
+            ProbeResult result = _searcher.probe(stack, _random);
+            programs.add(result.numPrograms);
+            time.add(result.searchTime);
+        }
+
+        std::cout << "Sub-tree ";
+        ::dumpInstructionStack(stack, std::cout, "");
+        std::cout << ": ";
+        dumpEstimate(programs, time);
+
+        totalPrograms += programs.mean();
+        totalTime += time.mean();
+        programsVariance += programs.varianceOfMean();
+        timeVariance += time.varianceOfMean();
+    });
+
+    // The sub-trees are estimated independently, so their variances add up
+    std::cout
+    << "Total: Programs=" << totalPrograms << " ±" << 1.96 * std::sqrt(programsVariance)
+    << ", CPU hours=" << totalTime / 3600
+    << " ±" << 1.96 * std::sqrt(timeVariance) / 3600
+    << std::endl;
+}
+
+void LocalSearchRunner::run() {
+    std::ifstream input(_programFile);
+    if (!input) {
+        std::cerr << "Could not read file" << std::endl;
+        return;
+    }
+
+    // The program is the last item on each line. This way, files where each program is preceded
+    // by its number of steps can also be used.
+    std::vector<std::string> seedPrograms;
+    std::string line;
+    while (getline(input, line)) {
+        std::istringstream iss(line);
+        std::string item, programSpec;
+        while (iss >> item) {
+            programSpec = item;
+        }
+        if (!programSpec.empty()) {
+            seedPrograms.push_back(programSpec);
+        }
+    }
+
+    if (seedPrograms.empty()) {
+        std::cerr << "No seed programs" << std::endl;
+        return;
+    }
+    _searcher.search(seedPrograms);
+}
+
+template class BasicOrchestratedSearchRunner<8>;
+template class BasicOrchestratedSearchRunner<8, 6>;
+template class BasicOrchestratedSearchRunner<8, 7>;
+template class BasicOrchestratedSearchRunner<16>;
+template class BasicResumeSearchRunner<8>;
+template class BasicResumeSearchRunner<8, 6>;
+template class BasicResumeSearchRunner<8, 7>;
+template class BasicResumeSearchRunner<16>;
+template class BasicLateEscapeSearchRunner<8>;
+template class BasicLateEscapeSearchRunner<8, 6>;
+template class BasicLateEscapeSearchRunner<8, 7>;
+template class BasicLateEscapeSearchRunner<16>;
+template class BasicSubTreeSearchRunner<8>;
+template class BasicSubTreeSearchRunner<8, 6>;
+template class BasicSubTreeSearchRunner<8, 7>;
+template class BasicSubTreeSearchRunner<16>;
+
 void FastExecSearchRunner::run() {
     std::ifstream input(_programFile);
     if (!input) {
@@ -116,9 +239,21 @@ void FastExecSearchRunner::run() {
 void FastExecSearchRunner_PlainProgram::runProgram(const std::string& programSpec) {
     _program = Program::fromString(programSpec);
 
-    _builder->buildFromProgram(_program);
+    if (InterpretedProgramBuilder::supportsSize(_program.getSize())) {
+        _builder->buildFromProgram(_program);
+        _searcher.run(programSpec, _builder);
+        return;
+    }
 
-    _searcher.run(programSpec, _builder);
+    if (!LargeInterpretedProgramBuilder::supportsSize(_program.getSize())) {
+        std::cerr << "Program too large: " << programSpec << std::endl;
+        return;
+    }
+    if (!_largeBuilder) {
+        _largeBuilder = std::make_shared<LargeInterpretedProgramBuilder>();
+    }
+    _largeBuilder->buildFromProgram(_program);
+    _searcher.run(programSpec, _largeBuilder);
 }
 
 void FastExecSearchRunner_InterpretedProgram::runProgram(const std::string& line) {
@@ -135,3 +270,11 @@ void FastExecSearchRunner_InterpretedProgram::runProgram(const std::string& line
 
     _searcher.run(programId, program);
 }
+template class BasicBeamSearchRunner<8>;
+template class BasicBeamSearchRunner<8, 6>;
+template class BasicBeamSearchRunner<8, 7>;
+template class BasicBeamSearchRunner<16>;
+template class BasicEstimateSearchRunner<8>;
+template class BasicEstimateSearchRunner<8, 6>;
+template class BasicEstimateSearchRunner<8, 7>;
+template class BasicEstimateSearchRunner<16>;
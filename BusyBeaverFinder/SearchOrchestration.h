@@ -7,19 +7,21 @@
 //
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
 #include "Types.h"
 #include "Searcher.h"
+#include "BeamSearcher.h"
 #include "ExhaustiveSearcher.h"
 #include "FastExecSearcher.h"
 #include "InterpretedProgramBuilder.h"
+#include "LocalSearcher.h"
 #include "Program.h"
 
-class ExhaustiveSearcher;
-
 class SearchRunner {
 public:
     virtual void run() = 0;
@@ -30,39 +32,104 @@ public:
     }
 };
 
-class OrchestratedSearchRunner : public SearchRunner {
-    ExhaustiveSearcher _searcher;
+// Invokes the visitor with the instruction stack of each sub-tree that an orchestrated search
+// searches. Together, these sub-trees cover all programs of the given size that need searching.
+void visitOrchestratedSubTrees(ProgramSize size,
+                               std::function<void(const std::vector<Ins>&)> visitor);
+
+template <int maxProgramSize, int programWidth = 0>
+class BasicOrchestratedSearchRunner : public SearchRunner {
+    using SearcherType = BasicExhaustiveSearcher<maxProgramSize, programWidth>;
 
-    void addInstructionsUntilTurn(std::vector<Ins> &stack, int numNoop, int numData);
+    SearcherType _searcher;
 public:
-    OrchestratedSearchRunner(SearchSettings settings) : _searcher(settings) {}
+    BasicOrchestratedSearchRunner(SearchSettings settings) : _searcher(settings) {}
 
-    ExhaustiveSearcher& getSearcher() override { return _searcher; };
+    SearcherType& getSearcher() override { return _searcher; };
     void run() override;
 };
 
-class ResumeSearchRunner : public SearchRunner {
-    ExhaustiveSearcher _searcher;
+template <int maxProgramSize, int programWidth = 0>
+class BasicResumeSearchRunner : public SearchRunner {
+    using SearcherType = BasicExhaustiveSearcher<maxProgramSize, programWidth>;
+
+    SearcherType _searcher;
     std::string _programSpec;
 public:
-    ResumeSearchRunner(SearchSettings settings, std::string programSpec)
+    BasicResumeSearchRunner(SearchSettings settings, std::string programSpec)
     : _searcher(settings), _programSpec(programSpec) {}
 
-    ExhaustiveSearcher& getSearcher() override { return _searcher; };
+    SearcherType& getSearcher() override { return _searcher; };
     void run() override;
 };
 
-class LateEscapeSearchRunner : public SearchRunner {
-    ExhaustiveSearcher _searcher;
+template <int maxProgramSize, int programWidth = 0>
+class BasicLateEscapeSearchRunner : public SearchRunner {
+    using SearcherType = BasicExhaustiveSearcher<maxProgramSize, programWidth>;
+
+    SearcherType _searcher;
     std::string _programFile;
 public:
-    LateEscapeSearchRunner(SearchSettings settings, std::string programFile)
+    BasicLateEscapeSearchRunner(SearchSettings settings, std::string programFile)
     : _searcher(settings), _programFile(programFile) {}
 
-    ExhaustiveSearcher& getSearcher() override { return _searcher; };
+    SearcherType& getSearcher() override { return _searcher; };
+    void run() override;
+};
+
+// Searches the sub-trees listed in the given file, one instruction stack per line. These can be
+// the work units created by the planner.
+template <int maxProgramSize, int programWidth = 0>
+class BasicSubTreeSearchRunner : public SearchRunner {
+    using SearcherType = BasicExhaustiveSearcher<maxProgramSize, programWidth>;
+
+    SearcherType _searcher;
+    std::string _stackFile;
+public:
+    BasicSubTreeSearchRunner(SearchSettings settings, std::string stackFile)
+    : _searcher(settings), _stackFile(stackFile) {}
+
+    SearcherType& getSearcher() override { return _searcher; };
+    void run() override;
+};
+
+template <int maxProgramSize, int programWidth = 0>
+class BasicBeamSearchRunner : public SearchRunner {
+    using SearcherType = BasicBeamSearcher<maxProgramSize, programWidth>;
+
+    SearcherType _searcher;
+public:
+    BasicBeamSearchRunner(SearchSettings settings, BeamSearchSettings beamSettings)
+    : _searcher(settings, beamSettings) {}
+
+    SearcherType& getSearcher() override { return _searcher; };
+    void run() override;
+};
+
+// Estimates the number of programs and the time it takes to search each sub-tree of an
+// orchestrated search, using random probes.
+template <int maxProgramSize, int programWidth = 0>
+class BasicEstimateSearchRunner : public SearchRunner {
+    using SearcherType = BasicExhaustiveSearcher<maxProgramSize, programWidth>;
+
+    SearcherType _searcher;
+    int _numProbes;
+    std::mt19937 _random;
+public:
+    BasicEstimateSearchRunner(SearchSettings settings, int numProbes, unsigned int randomSeed)
+    : _searcher(settings), _numProbes(numProbes), _random(randomSeed) {}
+
+    SearcherType& getSearcher() override { return _searcher; };
     void run() override;
 };
 
+using OrchestratedSearchRunner = BasicOrchestratedSearchRunner<8>;
+using ResumeSearchRunner = BasicResumeSearchRunner<8>;
+using LateEscapeSearchRunner = BasicLateEscapeSearchRunner<8>;
+using SubTreeSearchRunner = BasicSubTreeSearchRunner<8>;
+using BeamSearchRunner = BasicBeamSearchRunner<8>;
+using EstimateSearchRunner = BasicEstimateSearchRunner<8>;
+
 class FastExecSearchRunner : public SearchRunner {
     std::string _programFile;
 
@@ -82,6 +149,8 @@ public:
 class FastExecSearchRunner_PlainProgram : public FastExecSearchRunner {
     Program _program;
     std::shared_ptr<InterpretedProgramBuilder> _builder;
+    // Only created when a program is encountered that is too large for the default builder
+    std::shared_ptr<LargeInterpretedProgramBuilder> _largeBuilder;
 
     void runProgram(const std::string& programSpec) override;
 public:
@@ -97,3 +166,17 @@ public:
     FastExecSearchRunner_InterpretedProgram(BaseSearchSettings settings, std::string programFile)
     : FastExecSearchRunner(settings, programFile) {}
 };
+
+// Searches for improvements of the programs in the given file
+class LocalSearchRunner : public SearchRunner {
+    LocalSearcher _searcher;
+    std::string _programFile;
+
+public:
+    LocalSearchRunner(SearchSettings settings, LocalSearchSettings localSettings,
+                      std::string programFile)
+    : _searcher(settings, localSettings), _programFile(programFile) {}
+
+    LocalSearcher& getSearcher() override { return _searcher; };
+    void run() override;
+};
@@ -15,6 +15,7 @@ void Searcher::attachProgressTracker(std::unique_ptr<ProgressTracker> tracker) {
 }
 
 std::unique_ptr<ProgressTracker> Searcher::detachProgressTracker() {
+    finishPendingWork();
     _tracker->setSearcher(nullptr);
 
     return std::move(_tracker);
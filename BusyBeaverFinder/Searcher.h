@@ -10,6 +10,8 @@
 #include "Program.h"
 #include "ProgressTracker.h"
 
+class SubTreeProfile;
+
 struct BaseSearchSettings {
     ProgramSize size{6};
 
@@ -18,6 +20,18 @@ struct BaseSearchSettings {
     // The maximum steps that a program will run for.
     int maxSteps{1024};
 
+    // The width of the data cells used by the fast executor. Execution switches to wide cells when
+    // a value does not fit.
+    CellWidth fastExecCellWidth{CellWidth::WIDE};
+
+    // Let the fast executor check for repeated execution states. It proves some hangs that would
+    // otherwise be assumed, at the cost of slower execution.
+    bool fastExecCycleDetection{false};
+
+    // Let the fast executor check for repeated execution states at exponentially increasing step
+    // counts. It proves fewer hangs than checking each step, but is nearly as fast as no checks.
+    bool fastExecCycleSampling{false};
+
     BaseSearchSettings(int size) : size(size) {}
 };
 
@@ -28,6 +42,7 @@ protected:
 public:
     void attachProgressTracker(std::unique_ptr<ProgressTracker> tracker);
     std::unique_ptr<ProgressTracker> detachProgressTracker();
+    const ProgressTracker* getProgressTracker() const { return _tracker.get(); }
 
     virtual int getNumSteps() const = 0;
 
@@ -35,6 +50,18 @@ public:
     // is typically created from Program.getString() but not necessarily.
     virtual const std::string getProgramSpec() const = 0;
 
+    // Completes work that the search left running in the background, so that its results are
+    // reported before the tracker is detached.
+    virtual void finishPendingWork() {}
+
     virtual void dumpSettings(std::ostream &os) const = 0;
     virtual void dumpSearchProgress(std::ostream &os) const = 0;
+
+    // Dumps the cost of hang detection per detector. Searchers without hang detection do not
+    // dump anything.
+    virtual void dumpHangDetectionProfile(std::ostream &os) const {}
+
+    // Returns the cost of each sub-tree searched so far, or nullptr when the searcher does not
+    // profile its search.
+    virtual const SubTreeProfile* getSubTreeProfile() const { return nullptr; }
 };
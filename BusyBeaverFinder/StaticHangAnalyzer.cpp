@@ -0,0 +1,239 @@
+//
+//  StaticHangAnalyzer.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 18/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "StaticHangAnalyzer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+#include "Utils.h"
+
+// Guard against analyses that take too long. The analysis converges well before this, as the
+// abstract values of blocks can only be widened a limited number of times.
+const int maxAnalysisStepsPerBlock = 4;
+
+AbstractValue AbstractValue::exact(int value) {
+    return {
+        0, value,
+        static_cast<uint8_t>(value > 0 ? POSITIVE : (value < 0 ? NEGATIVE : ZERO))
+    };
+}
+
+PruningRule AbstractValue::zeroExcludedBy() const {
+    if (isExact()) {
+        return residue == 0 ? PruningRule::NONE : PruningRule::CONSTANT;
+    }
+    if (!(signs & ZERO)) {
+        return PruningRule::SIGN;
+    }
+    if (residue != 0) {
+        return PruningRule::CONGRUENCE;
+    }
+
+    return PruningRule::NONE;
+}
+
+PruningRule AbstractValue::nonZeroExcludedBy() const {
+    if (isExact()) {
+        return residue == 0 ? PruningRule::CONSTANT : PruningRule::NONE;
+    }
+    if (!(signs & (NEGATIVE | POSITIVE))) {
+        return PruningRule::SIGN;
+    }
+
+    return PruningRule::NONE;
+}
+
+AbstractValue AbstractValue::add(int delta) const {
+    if (isExact()) {
+        return exact(residue + delta);
+    }
+    if (delta == 0) {
+        return *this;
+    }
+
+    uint8_t towards = delta > 0 ? POSITIVE : NEGATIVE;
+    uint8_t awayFrom = delta > 0 ? NEGATIVE : POSITIVE;
+    uint8_t newSigns = 0;
+    if (signs & (towards | ZERO)) {
+        newSigns |= towards;
+    }
+    if (signs & awayFrom) {
+        // The value may cross zero
+        newSigns |= NEGATIVE | ZERO | POSITIVE;
+    }
+
+    return { modulus, normalizedMod(residue + delta, modulus), newSigns };
+}
+
+AbstractValue AbstractValue::withoutZero() const {
+    if (isExact()) {
+        return *this;
+    }
+
+    return { modulus, residue, static_cast<uint8_t>(signs & ~ZERO) };
+}
+
+AbstractValue AbstractValue::join(const AbstractValue& other) const {
+    if (*this == other) {
+        return *this;
+    }
+
+    // For exact values the modulus is zero, so this also handles these
+    int newModulus = std::gcd(std::gcd(modulus, other.modulus), abs(residue - other.residue));
+    if (newModulus == 0) {
+        // Both are exact and equal. Only the signs differ, which should not happen.
+        assert(false);
+        return *this;
+    }
+
+    return {
+        newModulus, normalizedMod(residue, newModulus),
+        static_cast<uint8_t>(signs | other.signs)
+    };
+}
+
+std::ostream &operator<<(std::ostream &os, const AbstractValue &value) {
+    if (value.isExact()) {
+        os << value.residue;
+    } else {
+        os << (value.signs & AbstractValue::NEGATIVE ? "-" : "")
+        << (value.signs & AbstractValue::ZERO ? "0" : "")
+        << (value.signs & AbstractValue::POSITIVE ? "+" : "");
+        if (value.modulus > 1) {
+            os << "(" << value.residue << " mod " << value.modulus << ")";
+        }
+    }
+
+    return os;
+}
+
+template <int maxProgramSize>
+BasicStaticHangAnalyzer<maxProgramSize>::BasicStaticHangAnalyzer() {
+    for (int i = 0; i < maxProgramBlocks; i++) {
+        _visited[i] = false;
+    }
+}
+
+template <int maxProgramSize>
+bool BasicStaticHangAnalyzer<maxProgramSize>::visitBlock(const ProgramBlock* block,
+                                                         AbstractValue value) {
+    if (!block->isFinalized() || block->isExit()) {
+        return false;
+    }
+
+    int index = block->getStartIndex();
+    if (!_visited[index]) {
+        _visited[index] = true;
+        _visitedBlocks.push_back(block);
+        _entryValue[index] = value;
+        _workList.push_back(block);
+    } else {
+        AbstractValue joined = _entryValue[index].join(value);
+        if (joined != _entryValue[index]) {
+            _entryValue[index] = joined;
+            _workList.push_back(block);
+        }
+    }
+
+    return true;
+}
+
+template <int maxProgramSize>
+bool BasicStaticHangAnalyzer<maxProgramSize>::analyze(const ProgramBlock* block,
+                                                      PruningRule maxRule) {
+    _rule = PruningRule::NONE;
+
+    // Blocks that start with a counter-clockwise turn are entered via a zero-branch.
+    bool enteredWithZero = (block->getStartIndex() & 0x01) == 0;
+    if (!visitBlock(block, enteredWithZero ? AbstractValue::exact(0) : AbstractValue::nonZero())) {
+        return false;
+    }
+
+    int numSteps = 0;
+    while (!_workList.empty()) {
+        if (++numSteps > maxAnalysisStepsPerBlock * maxProgramBlocks) {
+            return false;
+        }
+
+        const ProgramBlock* block = _workList.back();
+        _workList.pop_back();
+
+        if (block->isHang()) {
+            continue;
+        }
+
+        AbstractValue value = _entryValue[block->getStartIndex()];
+        AbstractValue exitValue = (block->isDelta()
+                                   ? value.add(block->getInstructionAmount())
+                                   : AbstractValue::any());
+
+        // The zero-block is not set when the program builder already excluded it
+        if (block->zeroBlock() != nullptr) {
+            PruningRule rule = exitValue.zeroExcludedBy();
+            if (rule == PruningRule::NONE || rule > maxRule) {
+                if (!visitBlock(block->zeroBlock(), AbstractValue::exact(0))) {
+                    return false;
+                }
+            } else {
+                _rule = std::max(_rule, rule);
+            }
+        }
+
+        PruningRule rule = exitValue.nonZeroExcludedBy();
+        if (rule == PruningRule::NONE) {
+            if (!visitBlock(block->nonZeroBlock(), exitValue.withoutZero())) {
+                return false;
+            }
+        } else if (rule > maxRule) {
+            if (!visitBlock(block->nonZeroBlock(), AbstractValue::nonZero())) {
+                return false;
+            }
+        } else {
+            _rule = std::max(_rule, rule);
+        }
+    }
+
+    return true;
+}
+
+template <int maxProgramSize>
+void BasicStaticHangAnalyzer<maxProgramSize>::reset() {
+    for (auto visited : _visitedBlocks) {
+        _visited[visited->getStartIndex()] = false;
+    }
+    _visitedBlocks.clear();
+    _workList.clear();
+}
+
+template <int maxProgramSize>
+bool BasicStaticHangAnalyzer<maxProgramSize>::provesHang(const ProgramBlock* block) {
+    assert(block->isFinalized());
+
+    bool hangs = analyze(block, PruningRule::CONGRUENCE);
+    reset();
+
+    // Not all excluded branches may have been needed for the proof. Find the weakest rule that
+    // suffices, so that the proof is attributed correctly. Proofs are rare, so this is cheap.
+    while (hangs && _rule != PruningRule::NONE) {
+        PruningRule rule = _rule;
+        bool weakerProof = analyze(block, static_cast<PruningRule>(static_cast<int>(rule) - 1));
+        reset();
+
+        if (!weakerProof) {
+            _rule = rule;
+            break;
+        }
+    }
+
+    return hangs;
+}
+
+template class BasicStaticHangAnalyzer<8>;
+template class BasicStaticHangAnalyzer<16>;
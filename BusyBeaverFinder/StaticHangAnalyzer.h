@@ -0,0 +1,91 @@
+//
+//  StaticHangAnalyzer.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 18/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <vector>
+
+#include "InterpretedProgramBuilder.h"
+#include "Types.h"
+
+// Abstract value of the data cell that DP points to. The value is in {x | x = residue (mod
+// modulus)}, further restricted to the signs that are possible. When the modulus is zero, the
+// value is known exactly and equals the residue.
+struct AbstractValue {
+    static constexpr uint8_t NEGATIVE = 0x01;
+    static constexpr uint8_t ZERO = 0x02;
+    static constexpr uint8_t POSITIVE = 0x04;
+
+    int modulus;
+    int residue;
+    uint8_t signs;
+
+    static AbstractValue exact(int value);
+    static AbstractValue nonZero() { return { 1, 0, NEGATIVE | POSITIVE }; }
+    static AbstractValue any() { return { 1, 0, NEGATIVE | ZERO | POSITIVE }; }
+
+    bool isExact() const { return modulus == 0; }
+
+    // Returns the rule that excludes the value from being zero, or NONE if it can be zero.
+    PruningRule zeroExcludedBy() const;
+    // Returns the rule that excludes the value from being non-zero, or NONE if it can be non-zero.
+    PruningRule nonZeroExcludedBy() const;
+
+    AbstractValue add(int delta) const;
+    AbstractValue withoutZero() const;
+
+    // Returns the smallest abstract value that contains both values.
+    AbstractValue join(const AbstractValue& other) const;
+
+    bool operator==(const AbstractValue& other) const {
+        return modulus == other.modulus && residue == other.residue && signs == other.signs;
+    }
+    bool operator!=(const AbstractValue& other) const { return !(*this == other); }
+};
+
+std::ostream &operator<<(std::ostream &os, const AbstractValue &value);
+
+/* Statically analyzes the (partial) interpreted program to prove that a program hangs once it
+ * enters a given block. It propagates the abstract value of the current data cell over the
+ * finalized blocks, which can show that some branches are never taken. The program hangs when no
+ * exit and no unfinalized block is reachable.
+ *
+ * It complements the ExitFinder, which only considers the value on entry paths to exits, up to a
+ * limited depth.
+ */
+template <int maxProgramSize>
+class BasicStaticHangAnalyzer {
+    static constexpr int maxProgramBlocks
+        = BasicInterpretedProgramBuilder<maxProgramSize>::maxProgramBlocks;
+
+    // The abstract value on entry of each block. Only valid for blocks that have been visited.
+    AbstractValue _entryValue[maxProgramBlocks];
+    bool _visited[maxProgramBlocks];
+
+    std::vector<const ProgramBlock*> _visitedBlocks;
+    std::vector<const ProgramBlock*> _workList;
+
+    PruningRule _rule;
+
+    // Returns false if the block can escape (i.e. it is an exit or not yet finalized).
+    bool visitBlock(const ProgramBlock* block, AbstractValue value);
+
+    // Analyzes if the program hangs, only excluding branches using rules up to the given one.
+    bool analyze(const ProgramBlock* block, PruningRule maxRule);
+    void reset();
+
+public:
+    BasicStaticHangAnalyzer();
+
+    // Returns true if the program hangs when it enters the given block.
+    bool provesHang(const ProgramBlock* block);
+
+    // The strongest rule that was needed to exclude branches for the last successful proof.
+    PruningRule lastRule() const { return _rule; }
+};
+
+using StaticHangAnalyzer = BasicStaticHangAnalyzer<8>;
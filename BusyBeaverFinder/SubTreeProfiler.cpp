@@ -0,0 +1,159 @@
+//
+//  SubTreeProfiler.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "SubTreeProfiler.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <fstream>
+#include <sstream>
+
+#include "ProgressTracker.h"
+#include "Utils.h"
+
+void SubTreeStats::add(const SubTreeStats& other) {
+    complete = complete && other.complete;
+    numPrograms += other.numPrograms;
+    numSteps += other.numSteps;
+    wallTime += other.wallTime;
+    numSuccess += other.numSuccess;
+    numErrors += other.numErrors;
+    numLateEscapes += other.numLateEscapes;
+    numEquivalent += other.numEquivalent;
+    for (int i = 0; i < numHangTypes; i++) {
+        numHangs[i] += other.numHangs[i];
+    }
+}
+
+void SubTreeProfile::add(const std::vector<Ins>& stack, const SubTreeStats& stats) {
+    auto result = _subTrees.insert({stack, stats});
+    if (!result.second) {
+        result.first->second.add(stats);
+    }
+}
+
+void SubTreeProfile::write(std::ostream &os) const {
+    os << "# Stack Complete Programs Steps Time Success Errors LateEscapes Equivalent Hangs..."
+    << std::endl;
+
+    for (auto& [stack, stats] : _subTrees) {
+        dumpInstructionStack(stack, os, ",");
+        os
+        << " " << (stats.complete ? 'C' : 'P')
+        << " " << stats.numPrograms
+        << " " << stats.numSteps
+        << " " << stats.wallTime
+        << " " << stats.numSuccess
+        << " " << stats.numErrors
+        << " " << stats.numLateEscapes
+        << " " << stats.numEquivalent;
+        for (int i = 0; i < numHangTypes; i++) {
+            os << " " << stats.numHangs[i];
+        }
+        os << std::endl;
+    }
+}
+
+bool SubTreeProfile::writeToFile(const std::string& filename) const {
+    std::ofstream output(filename);
+    if (!output) {
+        return false;
+    }
+
+    write(output);
+    return true;
+}
+
+bool SubTreeProfile::read(std::istream &is) {
+    std::string line;
+    while (getline(is, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream iss(line);
+        std::string stackSpec;
+        char complete;
+        SubTreeStats stats;
+
+        iss >> stackSpec >> complete
+        >> stats.numPrograms >> stats.numSteps >> stats.wallTime
+        >> stats.numSuccess >> stats.numErrors >> stats.numLateEscapes >> stats.numEquivalent;
+        for (int i = 0; i < numHangTypes; i++) {
+            iss >> stats.numHangs[i];
+        }
+        if (!iss || (complete != 'C' && complete != 'P')) {
+            return false;
+        }
+        stats.complete = (complete == 'C');
+
+        std::vector<Ins> stack;
+        std::replace(stackSpec.begin(), stackSpec.end(), ',', ' ');
+        std::istringstream stackStream(stackSpec);
+        loadResumeStackFromStream(stackStream, stack);
+
+        add(stack, stats);
+    }
+
+    return true;
+}
+
+bool SubTreeProfile::readFromFile(const std::string& filename) {
+    std::ifstream input(filename);
+    if (!input) {
+        return false;
+    }
+
+    return read(input);
+}
+
+SubTreeStats SubTreeProfiler::trackerStats(const ProgressTracker& tracker) const {
+    SubTreeStats stats;
+
+    stats.numPrograms = tracker.getTotal();
+    stats.numSteps = tracker.getTotalSteps();
+    stats.numSuccess = tracker.getTotalSuccess();
+    stats.numErrors = tracker.getTotalErrors();
+    stats.numLateEscapes = tracker.getTotalLateEscapes();
+    stats.numEquivalent = tracker.getTotalEquivalent();
+    for (int i = 0; i < numHangTypes; i++) {
+        stats.numHangs[i] = tracker.getTotalHangs((HangType)i);
+    }
+
+    return stats;
+}
+
+void SubTreeProfiler::enterSubTree(const ProgressTracker& tracker) {
+    _entryStats.push_back(trackerStats(tracker));
+    _entryTimes.push_back(std::chrono::steady_clock::now());
+}
+
+void SubTreeProfiler::leaveSubTree(const std::vector<Ins>& stack, bool complete,
+                                   const ProgressTracker& tracker) {
+    assert(!_entryStats.empty());
+
+    SubTreeStats entry = _entryStats.back();
+    SubTreeStats stats = trackerStats(tracker);
+
+    stats.complete = complete;
+    stats.numPrograms -= entry.numPrograms;
+    stats.numSteps -= entry.numSteps;
+    stats.wallTime = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - _entryTimes.back()
+    ).count();
+    stats.numSuccess -= entry.numSuccess;
+    stats.numErrors -= entry.numErrors;
+    stats.numLateEscapes -= entry.numLateEscapes;
+    stats.numEquivalent -= entry.numEquivalent;
+    for (int i = 0; i < numHangTypes; i++) {
+        stats.numHangs[i] -= entry.numHangs[i];
+    }
+
+    _profile.add(stack, stats);
+
+    _entryStats.pop_back();
+    _entryTimes.pop_back();
+}
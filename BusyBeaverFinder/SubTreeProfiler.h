@@ -0,0 +1,87 @@
+//
+//  SubTreeProfiler.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Types.h"
+
+class ProgressTracker;
+
+// The cost and the outcome of searching a sub-tree of the search tree
+struct SubTreeStats {
+    // A sub-tree is complete when it was searched in full. The sub-trees on the path to a resume
+    // point are only partially searched, so these cannot be searched on their own.
+    bool complete = true;
+
+    long numPrograms = 0;
+    // The sum of the steps of all program runs
+    long numSteps = 0;
+    // In seconds
+    double wallTime = 0;
+
+    long numSuccess = 0;
+    long numErrors = 0;
+    long numLateEscapes = 0;
+    long numEquivalent = 0;
+    // Detected hangs by type. Assumed hangs are counted as UNDETECTED.
+    long numHangs[numHangTypes] = {};
+
+    void add(const SubTreeStats& other);
+};
+
+// The stats of each sub-tree, keyed by the instruction stack at its root
+class SubTreeProfile {
+    std::map<std::vector<Ins>, SubTreeStats> _subTrees;
+
+public:
+    const std::map<std::vector<Ins>, SubTreeStats>& subTrees() const { return _subTrees; }
+
+    // Adds the stats to those of the sub-tree. A sub-tree can be visited more than once, e.g.
+    // when it is on the path to multiple resume points.
+    void add(const std::vector<Ins>& stack, const SubTreeStats& stats);
+
+    // Writes one line per sub-tree. Parents precede their children.
+    void write(std::ostream &os) const;
+    bool writeToFile(const std::string& filename) const;
+
+    // Reads sub-trees as written by write. Returns false on malformed input.
+    bool read(std::istream &is);
+    bool readFromFile(const std::string& filename);
+};
+
+/* Records where the time of an exhaustive search goes. It profiles the sub-trees up to a given
+ * depth below the resume point of the search, as well as the sub-trees on the path to it.
+ *
+ * The stats of a sub-tree are derived from the changes in the progress tracker while it is
+ * searched, so profiling only adds overhead when entering and leaving profiled sub-trees.
+ */
+class SubTreeProfiler {
+    int _maxDepth;
+    SubTreeProfile _profile;
+
+    // The tracker state and time when the profiled sub-trees that are being searched were entered
+    std::vector<SubTreeStats> _entryStats;
+    std::vector<std::chrono::steady_clock::time_point> _entryTimes;
+
+    SubTreeStats trackerStats(const ProgressTracker& tracker) const;
+
+public:
+    SubTreeProfiler(int maxDepth) : _maxDepth(maxDepth) {}
+
+    int getMaxDepth() const { return _maxDepth; }
+    const SubTreeProfile& getProfile() const { return _profile; }
+
+    void enterSubTree(const ProgressTracker& tracker);
+    void leaveSubTree(const std::vector<Ins>& stack, bool complete,
+                      const ProgressTracker& tracker);
+};
@@ -368,6 +368,18 @@ bool SweepHangChecker::addContributionOfSweepLoopPass(const SweepLoopVisitState
         rbIndex = result.value();
     }
     auto runBlock = runSummary.runBlockAt(rbIndex);
+    if (runBlock->getStartIndex() < runHistory.firstIndex()) {
+        // The run history of this occurrence has been discarded. As it only repeats the loop,
+        // unroll the loop instead. Include the block that follows, which continues the loop.
+        auto loopBlocks = runSummary.getLoopBlocks(runBlock->getSequenceId());
+        std::vector<const ProgramBlock*> unrolledLoop;
+        for (int i = 0; i <= pbLen; i++) {
+            unrolledLoop.push_back(loopBlocks[i % loopAnalysis->loopSize()]);
+        }
+        multiPartAnalysis.analyzeMultiSequence(unrolledLoop.data(), pbLen, dpStart);
+
+        return true;
+    }
     multiPartAnalysis.analyzeMultiSequence(&runHistory.at(runBlock->getStartIndex()),
                                            pbLen, dpStart);
 
@@ -7,6 +7,7 @@
 //
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <optional>
 #include <vector>
@@ -78,18 +79,10 @@ class SweepHangChecker : public HangChecker {
             _incomingLoops.clear();
             _outgoingLoops.clear();
         }
-        void addIncomingLoop(std::shared_ptr<LoopAnalysis> loop) {
-            _incomingLoops.insert(loop);
-        }
-        void addOutgoingLoop(std::shared_ptr<LoopAnalysis> loop) {
-            _outgoingLoops.insert(loop);
-        }
-        const std::set<std::shared_ptr<LoopAnalysis>>& incomingLoops() const {
-            return _incomingLoops;
-        }
-        const std::set<std::shared_ptr<LoopAnalysis>>& outgoingLoops() const {
-            return _outgoingLoops;
-        }
+        void addIncomingLoop(const LoopAnalysis* loop) { addLoop(_incomingLoops, loop); }
+        void addOutgoingLoop(const LoopAnalysis* loop) { addLoop(_outgoingLoops, loop); }
+        const std::vector<const LoopAnalysis*>& incomingLoops() const { return _incomingLoops; }
+        const std::vector<const LoopAnalysis*>& outgoingLoops() const { return _outgoingLoops; }
 
         bool analyze(const SweepHangChecker& checker, const ExecutionState& executionState);
 
@@ -129,9 +122,16 @@ class SweepHangChecker : public HangChecker {
         // The number of bootstrap cycles for this loop.
         int _outgoingLoopNumBootstrapCycles;
 
-        // The analysis of incoming and outgoing loops. Only one entry for each unique loop
-        std::set<std::shared_ptr<LoopAnalysis>> _incomingLoops;
-        std::set<std::shared_ptr<LoopAnalysis>> _outgoingLoops;
+        // The analysis of incoming and outgoing loops. Only one entry for each unique loop. There
+        // are only a few, so a linear search suffices to keep them unique.
+        std::vector<const LoopAnalysis*> _incomingLoops;
+        std::vector<const LoopAnalysis*> _outgoingLoops;
+
+        static void addLoop(std::vector<const LoopAnalysis*>& loops, const LoopAnalysis* loop) {
+            if (std::find(loops.begin(), loops.end(), loop) == loops.end()) {
+                loops.push_back(loop);
+            }
+        }
 
         bool analyzeCombinedEffect(const SweepHangChecker& checker,
                                    const ExecutionState& executionState);
@@ -0,0 +1,134 @@
+//
+//  TranslatedCycleHangDetector.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "TranslatedCycleHangDetector.h"
+
+#include <algorithm>
+
+#include "HangCertificate.h"
+
+TranslatedCycleHangDetector::TranslatedCycleHangDetector(const ExecutionState& execution)
+: BlockHangDetector(execution) {
+    _sides[0].dir = -1;
+    _sides[1].dir = 1;
+
+    reset();
+}
+
+void TranslatedCycleHangDetector::reset() {
+    BlockHangDetector::reset();
+
+    for (Side& side : _sides) {
+        side.numRecords = 0;
+        side.last = maxRecords - 1;
+    }
+}
+
+bool TranslatedCycleHangDetector::matchesRecord(const Record& record, int distanceBehind,
+                                                DataPointer dp, int dir) const {
+    const Data& data = _execution.getData();
+
+    for (int i = 0; i <= distanceBehind; i++) {
+        if (record.window[i] != data.valueAt(dp, -i * dir)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TranslatedCycleHangDetector::checkRecord(Side& side, const ProgramBlock* block) {
+    const Data& data = _execution.getData();
+    DataPointer dp = data.getDataPointer();
+    int dir = side.dir;
+
+    // All data beyond DP should be zero
+    bool isEmpty = data.getMinBoundP() > data.getMaxBoundP();
+    if (!isEmpty && (dp - (dir > 0 ? data.getMaxBoundP() : data.getMinBoundP())) * dir < 0) {
+        return false;
+    }
+
+    // Check the earlier records, newest first, while tracking how far execution went back since
+    DataPointer furthestBack = dp;
+    for (int i = 0; i < side.numRecords; i++) {
+        const Record& record = side.fromLast(i);
+        if ((furthestBack - record.furthestBack) * dir > 0) {
+            furthestBack = record.furthestBack;
+        }
+        int distanceBehind = static_cast<int>((record.dp - furthestBack) * dir);
+        if (distanceBehind > maxRecordDistance) {
+            // Older records can only be further away
+            break;
+        }
+
+        if (record.block == block) {
+            _blockStats.numProofAttempts++;
+            if (matchesRecord(record, distanceBehind, dp, dir)) {
+                _blockStats.numProofsYes++;
+                _cycleStart = record.numSteps;
+                _cycleEnd = _execution.numSteps();
+                return true;
+            }
+            _blockStats.numProofsNo++;
+        }
+    }
+
+    side.last = (side.last + 1) % maxRecords;
+    side.numRecords = std::min(side.numRecords + 1, maxRecords);
+
+    Record& record = side.records[side.last];
+    record.block = block;
+    record.dp = dp;
+    record.numSteps = _execution.numSteps();
+    record.furthestBack = dp;
+
+    // Only the values up to the far end of the data can be non-zero
+    DataPointer farEnd = dir > 0 ? data.getMinBoundP() : data.getMaxBoundP();
+    int numValues = isEmpty ? 0 : std::min(static_cast<int>((dp - farEnd) * dir) + 1,
+                                           maxRecordDistance + 1);
+    for (int i = 0; i < numValues; i++) {
+        record.window[i] = dp[-i * dir];
+    }
+    std::fill(record.window.begin() + numValues, record.window.end(), 0);
+
+    return false;
+}
+
+bool TranslatedCycleHangDetector::checkBlock(const ProgramBlock* block) {
+    DataPointer dp = _execution.getData().getDataPointer();
+    _blockStats.numInvocations++;
+
+    for (Side& side : _sides) {
+        if (side.numRecords == 0 || (dp - side.records[side.last].dp) * side.dir > 0) {
+            if (checkRecord(side, block)) {
+                return true;
+            }
+        } else {
+            Record& last = side.records[side.last];
+            if ((last.furthestBack - dp) * side.dir > 0) {
+                last.furthestBack = dp;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool TranslatedCycleHangDetector::getCertificate(HangCertificate& certificate) const {
+    certificate.type = CertificateType::CYCLE;
+    certificate.cycle = CycleCertificate {
+        .numSteps = _cycleStart, .period = _cycleEnd - _cycleStart
+    };
+
+    return true;
+}
+
+void TranslatedCycleHangDetector::dump() const {
+    std::cout << "TranslatedCycleHangDetector, #records = "
+    << _sides[0].numRecords << "/" << _sides[1].numRecords << std::endl;
+}
@@ -0,0 +1,81 @@
+//
+//  TranslatedCycleHangDetector.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <array>
+
+#include "HangDetector.h"
+
+/* Detects programs that repeat the same behavior while shifting along the tape, into fresh zeros.
+ * These are not detected by the loop-based detectors unless their run summary exhibits a matching
+ * meta-loop structure.
+ *
+ * It records the data around DP each time execution reaches a new record position beyond all
+ * non-zero data at either side of the tape. Consider two records at the same side for the same
+ * program block. If the data behind the first record, up to where execution went in between both
+ * records, equals the data behind the second record, the execution in between both records will
+ * repeat forever, each time translated by the distance between the records.
+ */
+class TranslatedCycleHangDetector : public BlockHangDetector {
+    // The maximum number of records kept per side
+    static constexpr int maxRecords = 32;
+    // The number of values behind DP that are recorded. Records that would need to be compared
+    // over a larger distance are ignored.
+    static constexpr int maxRecordDistance = 64;
+
+    struct Record {
+        const ProgramBlock* block;
+        DataPointer dp;
+        long numSteps;
+        // The position furthest behind the record that execution visited in between this record
+        // and the next
+        DataPointer furthestBack;
+        // The values at DP and behind it, i.e. away from the tape edge
+        std::array<int, maxRecordDistance + 1> window;
+    };
+
+    // The records at one side of the tape. They are kept in a ring buffer, so that no memory is
+    // allocated while recording.
+    struct Side {
+        std::array<Record, maxRecords> records;
+        int numRecords;
+        int last;
+
+        // The direction in which the tape edge moves
+        int dir;
+
+        const Record& fromLast(int i) const {
+            return records[(last - i + maxRecords) % maxRecords];
+        }
+    };
+
+    Side _sides[2];
+
+    // The steps of the matching record, and of the detection
+    long _cycleStart, _cycleEnd;
+
+    // Checks if DP is at a new record at the given side. Returns true when a hang is detected.
+    bool checkRecord(Side& side, const ProgramBlock* block);
+    bool matchesRecord(const Record& record, int distanceBehind, DataPointer dp, int dir) const;
+
+public:
+    TranslatedCycleHangDetector(const ExecutionState& execution);
+
+    HangType hangType() const override { return HangType::TRANSLATED_CYCLER; }
+    const char* name() const override { return "TranslatedCycle"; }
+
+    bool defersDetection() const override { return true; }
+
+    void reset() override;
+
+    bool checkBlock(const ProgramBlock* block) override;
+
+    bool getCertificate(HangCertificate& certificate) const override;
+
+    void dump() const override;
+};
@@ -0,0 +1,129 @@
+//
+//  TranspositionTable.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "TranspositionTable.h"
+
+// Markers for blocks in the key. Positions of finalized blocks are non-negative.
+constexpr int UNFINALIZED_BLOCK = -1;
+constexpr int EXIT_BLOCK = -2;
+constexpr int HANG_BLOCK = -3;
+constexpr int NO_BLOCK = -4;
+
+size_t ExecutionKeyHash::operator()(const ExecutionKey& key) const {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (int value : key) {
+        hash ^= static_cast<uint32_t>(value);
+        hash *= 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+void TranspositionTable::createKey(const ProgramBlock* block, const Data& data,
+                                   ExecutionKey& key) {
+    key.clear();
+
+    // Number the blocks in the order that they are visited by a breadth-first traversal. The
+    // numbering only depends on the structure of the reachable program.
+    auto positionOf = [this](const ProgramBlock* block) {
+        if (!block) return NO_BLOCK;
+
+        int index = block->getStartIndex();
+        if (index >= _blockPosition.size()) {
+            _blockPosition.resize(index + 1, -1);
+        }
+        if (_blockPosition[index] < 0) {
+            _blockPosition[index] = static_cast<int>(_blocks.size());
+            _blocks.push_back(block);
+        }
+        return _blockPosition[index];
+    };
+
+    positionOf(block);
+    for (int i = 0; i < _blocks.size(); i++) {
+        const ProgramBlock* block = _blocks[i];
+
+        if (!block->isFinalized()) {
+            key.push_back(UNFINALIZED_BLOCK);
+        } else if (block->isExit()) {
+            key.push_back(EXIT_BLOCK);
+            key.push_back(block->getNumSteps());
+        } else if (block->isHang()) {
+            key.push_back(HANG_BLOCK);
+        } else {
+            key.push_back(positionOf(block->zeroBlock()));
+            key.push_back(positionOf(block->nonZeroBlock()));
+            key.push_back(block->isDelta());
+            key.push_back(block->getInstructionAmount());
+            key.push_back(block->getNumSteps());
+        }
+    }
+
+    for (auto block : _blocks) {
+        _blockPosition[block->getStartIndex()] = -1;
+    }
+    _blocks.clear();
+
+    // Add the data. The position relative to the middle of the tape matters, as this determines
+    // when execution runs out of data.
+    key.push_back(static_cast<int>(data.getDataPointer() - data.getMidDataP()));
+    if (data.getMinBoundP() <= data.getMaxBoundP()) {
+        key.push_back(static_cast<int>(data.getMinBoundP() - data.getMidDataP()));
+        key.insert(key.end(), data.getMinBoundP(), data.getMaxBoundP() + 1);
+    }
+}
+
+bool TranspositionTable::lookup(const ExecutionKey& key, int maxSteps,
+                                RunResult& result, int& numSteps, HangType& hangType) {
+    _numLookups++;
+
+    auto it = _lookup.find(key);
+    if (it == _lookup.end()) {
+        return false;
+    }
+
+    const Entry& entry = it->second->second;
+    if (entry.result == RunResult::ASSUMED_HANG
+        ? entry.maxSteps < maxSteps  // Did not run long enough
+        : entry.numSteps >= maxSteps // Would now be cut short
+    ) {
+        return false;
+    }
+
+    _lru.splice(_lru.begin(), _lru, it->second);
+    _numHits++;
+    result = entry.result;
+    numSteps = entry.numSteps;
+    hangType = entry.hangType;
+
+    return true;
+}
+
+void TranspositionTable::store(const ExecutionKey& key, int maxSteps,
+                               RunResult result, int numSteps, HangType hangType) {
+    if (_capacity == 0) {
+        return;
+    }
+
+    auto it = _lookup.find(key);
+    if (it != _lookup.end()) {
+        // Replace the entry, which did not run long enough
+        it->second->second = { result, numSteps, maxSteps, hangType };
+        _lru.splice(_lru.begin(), _lru, it->second);
+        return;
+    }
+
+    if (_lru.size() >= _capacity) {
+        _lookup.erase(_lru.back().first);
+        _lru.pop_back();
+        _numEvictions++;
+    }
+
+    _lru.emplace_front(key, Entry { result, numSteps, maxSteps, hangType });
+    _lookup.insert({_lru.front().first, _lru.begin()});
+}
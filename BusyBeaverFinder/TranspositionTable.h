@@ -0,0 +1,87 @@
+//
+//  TranspositionTable.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "Data.h"
+#include "ProgramBlock.h"
+#include "Types.h"
+
+// Uniquely identifies the remaining execution of a program. It consists of the canonical
+// representation of the interpreted program that is reachable from the current block and the
+// contents of the data tape. Unfinalized blocks are included, as reaching one ends the execution.
+using ExecutionKey = std::vector<int>;
+
+struct ExecutionKeyHash {
+    size_t operator()(const ExecutionKey& key) const;
+};
+
+/* Caches the results of fast executions, so that these do not need to be repeated for programs
+ * that continue execution in the same way. Programs that only differ in the order of instructions
+ * within a program block, or in blocks that cannot be reached anymore, map to the same key.
+ *
+ * The number of entries is bounded. When full, the least recently used entry is evicted.
+ */
+class TranspositionTable {
+    struct Entry {
+        RunResult result;
+        // The number of steps until the result was obtained
+        int numSteps;
+        // The maximum number of steps the execution was allowed to take
+        int maxSteps;
+        // The type of hang, when one was detected
+        HangType hangType;
+    };
+    using LruList = std::list<std::pair<ExecutionKey, Entry>>;
+
+    size_t _capacity;
+
+    // Most recently used entries are at the front
+    LruList _lru;
+    std::unordered_map<ExecutionKey, LruList::iterator, ExecutionKeyHash> _lookup;
+
+    // Maps the start index of a block to its position in the key. Only used while creating a key.
+    std::vector<int> _blockPosition;
+    std::vector<const ProgramBlock*> _blocks;
+
+    long _numLookups = 0;
+    long _numHits = 0;
+    long _numEvictions = 0;
+
+public:
+    TranspositionTable(size_t capacity) : _capacity(capacity) {}
+
+    void createKey(const ProgramBlock* block, const Data& data, ExecutionKey& key);
+
+    // Returns true when the result of an execution with the given key is known, in which case the
+    // result and the number of steps it took are set. The maximum number of steps the execution is
+    // allowed to take should not exceed that of the cached execution, unless the latter
+    // terminated well within this limit.
+    bool lookup(const ExecutionKey& key, int maxSteps, RunResult& result, int& numSteps,
+                HangType& hangType);
+    bool lookup(const ExecutionKey& key, int maxSteps, RunResult& result, int& numSteps) {
+        HangType hangType;
+        return lookup(key, maxSteps, result, numSteps, hangType);
+    }
+
+    // Stores the result of an execution. The hang type should be UNDETECTED unless the result is
+    // DETECTED_HANG.
+    void store(const ExecutionKey& key, int maxSteps, RunResult result, int numSteps,
+               HangType hangType);
+
+    size_t size() const { return _lru.size(); }
+    size_t capacity() const { return _capacity; }
+
+    long numLookups() const { return _numLookups; }
+    long numHits() const { return _numHits; }
+    long numEvictions() const { return _numEvictions; }
+    double hitRate() const { return _numLookups ? _numHits / (double)_numLookups : 0; }
+};
@@ -38,6 +38,14 @@ struct ProgramPointer {
 
 typedef int* DataPointer;
 
+// The width of the cells on the data tape of the fast executor. Narrow cells fit more cells in a
+// cache line. When a value does not fit in a narrow cell, execution switches to wide cells.
+enum class CellWidth : int8_t {
+    NARROW_8 = 8,
+    NARROW_16 = 16,
+    WIDE = 32
+};
+
 // Data operations
 typedef uint8_t UndoOp;
 
@@ -98,8 +106,8 @@ enum class LoopType : int8_t {
     DOUBLE_SWEEP = 3,
 };
 
-const int numHangTypes = 9;
-const int numDetectedHangTypes = 8;
+const int numHangTypes = 12;
+const int numDetectedHangTypes = 11;
 enum class HangType : int8_t {
     UNKNOWN = 0,
     // Simple loop, without any DATA
@@ -110,7 +118,27 @@ enum class HangType : int8_t {
     REGULAR_SWEEP = 5,
     IRREGULAR_SWEEP = 6,
     APERIODIC_GLIDER = 7,
-    UNDETECTED = 8 // Should always be last
+    // Repeats the same behavior while shifting along the tape
+    TRANSLATED_CYCLER = 8,
+    // Meta-loop whose loop counters follow an affine recurrence, e.g. they grow exponentially
+    AFFINE_COUNTER = 9,
+    // Proven after the search by the closed tape decider
+    CLOSED_TAPE = 10,
+    UNDETECTED = 11 // Should always be last
+};
+
+// Rules that the static hang analysis uses to show that a branch is never taken. They are ordered
+// by strength. A hang proof is attributed to the strongest rule it needed.
+const int numPruningRules = 4;
+enum class PruningRule : int8_t {
+    // No branch needed to be excluded
+    NONE = 0,
+    // The value is known exactly
+    CONSTANT = 1,
+    // The sign of the value shows it cannot be zero, e.g. a positive value that is incremented
+    SIGN = 2,
+    // The value is in a residue class that does not include zero
+    CONGRUENCE = 3
 };
 
 enum class Trilian : int8_t {
@@ -19,8 +19,6 @@
 bool enableDebugOutput = false;
 
 
-const int dx[4] = { 0, 1, 0, -1 };
-const int dy[4] = { 1, 0, -1, 0 };
 
 bool isPowerOfTwo(int val) {
     return (val & (val - 1)) == 0;
@@ -65,13 +63,6 @@ int ceildiv(int a, int b) {
     return result;
 }
 
-InstructionPointer nextInstructionPointer(ProgramPointer pp) {
-    return InstructionPointer {
-        .col = (int8_t)(pp.p.col + dx[(int)pp.dir]),
-        .row = (int8_t)(pp.p.row + dy[(int)pp.dir])
-    };
-}
-
 // Not used anymore, but kept for reference. It helps understanding the findPeriod implementation
 // and has its own unit tests, which is possibly useful in troubleshooting.
 void calculateZArray(const char* input, int* output, int len) {
@@ -286,6 +277,36 @@ void LogHistogram::add(int value) {
     _histogram.back().second++;
 }
 
+void LogHistogram::add(const LogHistogram& other) {
+    assert(_bins_per_log_scale == other._bins_per_log_scale
+           && _ini_log_scale == other._ini_log_scale);
+
+    while (_histogram.size() < other._histogram.size()) {
+        _histogram.emplace_back(getBinUpperBound(static_cast<int>(_histogram.size())), 0);
+    }
+    for (int i = 0; i < other._histogram.size(); i++) {
+        _histogram[i].second += other._histogram[i].second;
+    }
+}
+
+void SampleStats::add(double value) {
+    _count++;
+    _sum += value;
+    _sumSquares += value * value;
+}
+
+double SampleStats::varianceOfMean() const {
+    if (_count < 2) return 0;
+
+    double m = mean();
+    double variance = std::max(0.0, (_sumSquares - _count * m * m) / (_count - 1));
+    return variance / _count;
+}
+
+double SampleStats::confidenceInterval() const {
+    return 1.96 * std::sqrt(varianceOfMean());
+}
+
 std::ostream &operator<<(std::ostream &os, const LogHistogram &h) {
     int lower = 1;
     for (auto& entry : h._histogram) {
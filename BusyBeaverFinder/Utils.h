@@ -46,7 +46,24 @@ inline int sign(int val) {
     return val > 0 ? 1 : (val < 0 ? -1 : 0);
 }
 
-InstructionPointer nextInstructionPointer(ProgramPointer insP);
+// Offsets for each direction. These are constants so that the inlined look-up below is cheap in
+// the inner loops of the searcher and program builder.
+constexpr int dx[4] = { 0, 1, 0, -1 };
+constexpr int dy[4] = { 1, 0, -1, 0 };
+
+inline InstructionPointer nextInstructionPointer(ProgramPointer pp) {
+    return InstructionPointer {
+        .col = (int8_t)(pp.p.col + dx[(int)pp.dir]),
+        .row = (int8_t)(pp.p.row + dy[(int)pp.dir])
+    };
+}
+
+inline InstructionPointer nextInstructionPointer(ProgramPointer pp, int distance) {
+    return InstructionPointer {
+        .col = (int8_t)(pp.p.col + dx[(int)pp.dir] * distance),
+        .row = (int8_t)(pp.p.row + dy[(int)pp.dir] * distance)
+    };
+}
 
 void calculateZArray(const char* input, int* output, int len);
 int findPeriod(const char* input, int* buf, int len);
@@ -90,10 +107,36 @@ public:
 
     // Adds the value to the corresponding bin.
     void add(int value);
+
+    // Adds the counts of the other histogram, which should have the same bins.
+    void add(const LogHistogram& other);
+
+    // Returns the bins as (upper bound, count) pairs
+    const std::vector<std::pair<int,long>>& getBins() const { return _histogram; }
 };
 
 std::ostream &operator<<(std::ostream &os, const LogHistogram &h);
 
+// Tracks the mean of a series of samples, and how accurately it is known
+class SampleStats {
+    long _count = 0;
+    double _sum = 0;
+    double _sumSquares = 0;
+
+public:
+    void add(double value);
+
+    long count() const { return _count; }
+    double mean() const { return _count ? _sum / _count : 0; }
+
+    // The variance of the mean
+    double varianceOfMean() const;
+
+    // The half-width of the 95% confidence interval of the mean, assuming it is normally
+    // distributed
+    double confidenceInterval() const;
+};
+
 template<typename T, std::size_t N, std::size_t... I>
 constexpr auto create_indexed_array_impl(std::index_sequence<I...>) {
     return std::array<T, N>{ {I...} };
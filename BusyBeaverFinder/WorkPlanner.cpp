@@ -0,0 +1,120 @@
+//
+//  WorkPlanner.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "WorkPlanner.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <queue>
+
+constexpr Ins branchInstructions[] = { Ins::NOOP, Ins::DATA, Ins::TURN };
+
+bool lessCostly(const WorkUnit& unit1, const WorkUnit& unit2) {
+    return unit1.cost < unit2.cost;
+}
+
+double WorkPlanner::costOf(const SubTreeStats& stats) const {
+    switch (_costMetric) {
+        case CostMetric::WALL_TIME: return stats.wallTime;
+        case CostMetric::STEPS: return stats.numSteps;
+        case CostMetric::PROGRAMS: return stats.numPrograms;
+    }
+
+    assert(false);
+    return 0;
+}
+
+WorkUnit WorkPlanner::workUnitFor(const std::vector<Ins>& stack) const {
+    return { stack, costOf(_profile.subTrees().at(stack)) };
+}
+
+std::vector<std::vector<Ins>> WorkPlanner::childrenOf(const std::vector<Ins>& stack) const {
+    std::vector<std::vector<Ins>> children;
+    std::vector<Ins> child = stack;
+
+    child.push_back(Ins::UNSET);
+    for (Ins ins : branchInstructions) {
+        child.back() = ins;
+        if (_profile.subTrees().count(child)) {
+            children.push_back(child);
+        }
+    }
+
+    return children;
+}
+
+std::vector<WorkUnit> WorkPlanner::createWorkUnits(int numUnits) const {
+    std::vector<std::vector<Ins>> pending;
+    for (auto& [stack, stats] : _profile.subTrees()) {
+        auto parent = stack;
+        parent.pop_back();
+        if (!_profile.subTrees().count(parent)) {
+            pending.push_back(stack);
+        }
+    }
+
+    // Units that can be split further, most costly first
+    std::priority_queue<WorkUnit, std::vector<WorkUnit>, decltype(&lessCostly)>
+        splittable(lessCostly);
+    std::vector<WorkUnit> units;
+    auto addUnit = [&](const std::vector<Ins>& stack) {
+        if (childrenOf(stack).empty()) {
+            units.push_back(workUnitFor(stack));
+        } else {
+            splittable.push(workUnitFor(stack));
+        }
+    };
+
+    while (!pending.empty()) {
+        auto stack = pending.back();
+        pending.pop_back();
+
+        if (_profile.subTrees().at(stack).complete) {
+            addUnit(stack);
+        } else {
+            // Partially searched sub-trees cannot be searched on their own
+            auto children = childrenOf(stack);
+            pending.insert(pending.end(), children.begin(), children.end());
+        }
+    }
+
+    while (!splittable.empty() && (int)(units.size() + splittable.size()) < numUnits) {
+        auto stack = splittable.top().stack;
+        splittable.pop();
+
+        for (auto& child : childrenOf(stack)) {
+            addUnit(child);
+        }
+    }
+
+    while (!splittable.empty()) {
+        units.push_back(splittable.top());
+        splittable.pop();
+    }
+
+    return units;
+}
+
+std::vector<std::vector<WorkUnit>> WorkPlanner::assignWorkUnits(std::vector<WorkUnit> units,
+                                                                int numWorkers) const {
+    std::vector<std::vector<WorkUnit>> workers(std::max(1, numWorkers));
+    std::vector<double> workerCosts(workers.size());
+
+    std::sort(units.begin(), units.end(), [](const WorkUnit& unit1, const WorkUnit& unit2) {
+        return lessCostly(unit2, unit1);
+    });
+    for (auto& unit : units) {
+        auto cheapest = std::min_element(workerCosts.begin(), workerCosts.end());
+        int index = static_cast<int>(cheapest - workerCosts.begin());
+
+        workers[index].push_back(unit);
+        *cheapest += unit.cost;
+    }
+
+    return workers;
+}
@@ -0,0 +1,54 @@
+//
+//  WorkPlanner.h
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+#pragma once
+
+#include <vector>
+
+#include "Types.h"
+#include "SubTreeProfiler.h"
+
+enum class CostMetric : int8_t {
+    WALL_TIME = 0,
+    STEPS = 1,
+    PROGRAMS = 2,
+};
+
+// A sub-tree that can be searched on its own, by resuming from its instruction stack
+struct WorkUnit {
+    std::vector<Ins> stack;
+    double cost;
+};
+
+/* Divides a search over workers so that each gets a similar amount of work. The cost of the work
+ * is taken from the profile of an earlier search. This can be a search with a lower step limit,
+ * as long as the cost is distributed similarly over the search tree.
+ */
+class WorkPlanner {
+    const SubTreeProfile& _profile;
+    CostMetric _costMetric;
+
+    double costOf(const SubTreeStats& stats) const;
+    WorkUnit workUnitFor(const std::vector<Ins>& stack) const;
+
+    // Returns the sub-trees one level below the given one that are in the profile
+    std::vector<std::vector<Ins>> childrenOf(const std::vector<Ins>& stack) const;
+
+public:
+    WorkPlanner(const SubTreeProfile& profile, CostMetric costMetric)
+    : _profile(profile), _costMetric(costMetric) {}
+
+    // Divides the profiled search into work units that together cover it. The most costly units
+    // are split until there are at least the requested number of units, or until the profile
+    // lacks the detail to split them further.
+    std::vector<WorkUnit> createWorkUnits(int numUnits) const;
+
+    // Assigns the units to the workers. Units are assigned from most to least costly, each time
+    // to the worker with the least work so far.
+    std::vector<std::vector<WorkUnit>> assignWorkUnits(std::vector<WorkUnit> units,
+                                                       int numWorkers) const;
+};
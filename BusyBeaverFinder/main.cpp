@@ -12,6 +12,8 @@
 #include "cxxopts.hpp"
 
 #include "Utils.h"
+#include "ClosedTapeDecider.h"
+#include "HangCertificate.h"
 #include "ExhaustiveSearcher.h"
 #include "ProgressTracker.h"
 #include "SearchOrchestration.h"
@@ -31,9 +33,29 @@ enum class RunMode : int8_t {
 
     // No search. Just execute each of the programs to see how they behave.
     ONLY_RUN = 3,
+
+    // Search for long-running programs by only expanding the most promising partial programs.
+    // This is meant for grids that are too large for an exhaustive search.
+    BEAM_SEARCH = 4,
+
+    // Search for improvements of known good programs by mutating them
+    LOCAL_SEARCH = 5,
+
+    // Estimate the size of a full search, and how long it takes
+    ESTIMATE = 6,
+
+    // Search the sub-trees listed in a file, e.g. the work units created by the planner
+    SUB_TREES = 7,
 };
 
 std::shared_ptr<SearchRunner> searchRunner;
+// When set, the cost of each sub-tree is written to this file after the search
+std::string profileFile;
+// When set, the closed tape decider analyzes the assumed hangs after the search
+bool closedTapeFilter = false;
+// When set, the certificates of all certified hangs are written to this file after the search
+std::string certificateFile;
+int numThreads = 1;
 
 bool fileContainsTabs(std::string& filepath) {
     std::ifstream input(filepath);
@@ -51,6 +73,42 @@ bool fileContainsTabs(std::string& filepath) {
     return line.find("\t") != std::string::npos;
 }
 
+// Creates the runner for the search modes, which use a searcher that is specialized for the
+// maximum program size and, optionally, the program width.
+template <int maxProgramSize, int programWidth = 0>
+std::shared_ptr<SearchRunner> createSearchRunner(RunMode runMode, SearchSettings settings,
+                                                 const std::string& inputFile,
+                                                 const std::string& resumeFrom,
+                                                 BeamSearchSettings beamSettings,
+                                                 int numProbes, unsigned int randomSeed) {
+    switch (runMode) {
+        case RunMode::FULL_SEARCH:
+            return std::make_shared<
+                BasicOrchestratedSearchRunner<maxProgramSize, programWidth>>(settings);
+        case RunMode::RESUME_FROM:
+            return std::make_shared<
+                BasicResumeSearchRunner<maxProgramSize, programWidth>>(settings, resumeFrom);
+        case RunMode::LATE_ESCAPE:
+            return std::make_shared<
+                BasicLateEscapeSearchRunner<maxProgramSize, programWidth>>(settings, inputFile);
+        case RunMode::BEAM_SEARCH:
+            return std::make_shared<
+                BasicBeamSearchRunner<maxProgramSize, programWidth>>(settings, beamSettings);
+        case RunMode::ESTIMATE:
+            return std::make_shared<BasicEstimateSearchRunner<maxProgramSize, programWidth>>(
+                settings, numProbes, randomSeed);
+        case RunMode::SUB_TREES:
+            return std::make_shared<
+                BasicSubTreeSearchRunner<maxProgramSize, programWidth>>(settings, inputFile);
+        case RunMode::ONLY_RUN:
+        case RunMode::LOCAL_SEARCH:
+            break;
+    }
+
+    assert(false);
+    return nullptr;
+}
+
 void init(int argc, char * argv[]) {
     cxxopts::Options options("BusyBeaverFinder", "Searcher for Busy Beaver Programs");
     options.add_options()
@@ -62,15 +120,46 @@ void init(int argc, char * argv[]) {
          cxxopts::value<int>())
         ("max-hang-detection-steps", "Max steps to execute with hang detection",
          cxxopts::value<int>())
+        ("cell-width", "Data cell width of fast executor: 8, 16 or 32", cxxopts::value<int>())
+        ("detect-cycles", "Let the fast executor detect repeated execution states")
+        ("sample-cycles", "Let the fast executor sample for repeated execution states")
         ("undo-capacity", "Maximum data operations to undo", cxxopts::value<int>())
-        ("run-mode", "One of: FULL, RESUME, ESCAPE, ONLYRUN", cxxopts::value<std::string>())
-        ("input-file", "File with programs (ESCAPE, ONLYRUN)", cxxopts::value<std::string>())
+        ("run-mode", "One of: FULL, RESUME, ESCAPE, ONLYRUN, BEAM, LOCAL, ESTIMATE, SUBTREES",
+         cxxopts::value<std::string>())
+        ("input-file", "File with programs (ESCAPE, ONLYRUN, LOCAL) or stacks (SUBTREES)",
+         cxxopts::value<std::string>())
         ("resume-from", "Program from which to resume the search", cxxopts::value<std::string>())
         ("t,test-hangs", "Test hang detection")
+        ("verify-threads", "Number of threads that verify detected hangs when testing them, "
+         "0 to verify them synchronously", cxxopts::value<int>())
         ("dump-period", "The period of dumping basic stats", cxxopts::value<int>())
         ("dump-success-steps-limit", "The minimum number of steps for dumping successful programs",
          cxxopts::value<int>())
         ("dump-undetected-hangs", "Report undetected hangs")
+        ("metrics-file", "File to append metrics to in JSON Lines format",
+         cxxopts::value<std::string>())
+        ("profile-hang-detection", "Report the cost of each hang detector and checker")
+        ("profile-file", "File to write the cost of each sub-tree to", cxxopts::value<std::string>())
+        ("profile-depth", "Depth below the resume point up to which sub-trees are profiled",
+         cxxopts::value<int>())
+        ("transposition-table-size", "Number of fast execution results to cache, 0 to disable",
+         cxxopts::value<int>())
+        ("beam-width", "Number of partial programs to expand each round (BEAM)",
+         cxxopts::value<int>())
+        ("max-queue-size", "Maximum number of partial programs to keep (BEAM)",
+         cxxopts::value<int>())
+        ("max-expansions", "Number of partial programs to expand, 0 for no limit (BEAM)",
+         cxxopts::value<long>())
+        ("max-candidates", "Number of programs to evaluate (LOCAL)", cxxopts::value<long>())
+        ("max-mutations", "Maximum cells to mutate per candidate (LOCAL)", cxxopts::value<int>())
+        ("temperature", "Initial annealing temperature (LOCAL)", cxxopts::value<double>())
+        ("probes", "Number of random probes per sub-tree (ESTIMATE)", cxxopts::value<int>())
+        ("random-seed", "Seed for the random number generator (LOCAL, ESTIMATE)",
+         cxxopts::value<unsigned int>())
+        ("closed-tape-filter", "Try to prove that assumed hangs hang after the search")
+        ("certificate-file", "File to write hang proofs to, which the Verifier can check",
+         cxxopts::value<std::string>())
+        ("threads", "Number of threads (BEAM, LOCAL, closed tape filter)", cxxopts::value<int>())
         ("help", "Show help");
     auto result = options.parse(argc, argv);
 
@@ -99,6 +188,14 @@ void init(int argc, char * argv[]) {
             runMode = RunMode::LATE_ESCAPE;
         } else if (s == "ONLYRUN") {
             runMode = RunMode::ONLY_RUN;
+        } else if (s == "BEAM") {
+            runMode = RunMode::BEAM_SEARCH;
+        } else if (s == "LOCAL") {
+            runMode = RunMode::LOCAL_SEARCH;
+        } else if (s == "ESTIMATE") {
+            runMode = RunMode::ESTIMATE;
+        } else if (s == "SUBTREES") {
+            runMode = RunMode::SUB_TREES;
         } else {
             std::cerr << "Unknown run mode: " << s << std::endl;
             exit(-1);
@@ -122,16 +219,91 @@ void init(int argc, char * argv[]) {
     settings.maxSearchSteps = std::max(settings.maxHangDetectionSteps, settings.maxSearchSteps);
     settings.maxSteps = std::max(settings.maxSearchSteps, settings.maxSteps);
 
+    if (result.count("cell-width")) {
+        int cellWidth = result["cell-width"].as<int>();
+        switch (cellWidth) {
+            case 8: settings.fastExecCellWidth = CellWidth::NARROW_8; break;
+            case 16: settings.fastExecCellWidth = CellWidth::NARROW_16; break;
+            case 32: settings.fastExecCellWidth = CellWidth::WIDE; break;
+            default:
+                std::cerr << "Unsupported cell width: " << cellWidth << std::endl;
+                exit(-1);
+        }
+    }
+
+    if (result.count("detect-cycles")) {
+        settings.fastExecCycleDetection = true;
+    }
+    if (result.count("sample-cycles")) {
+        settings.fastExecCycleSampling = true;
+    }
+
     // Enable testing of hang detection?
     if (result.count("t")) {
         settings.testHangDetection = true;
     }
+    if (result.count("verify-threads")) {
+        settings.numVerificationThreads = result["verify-threads"].as<int>();
+    }
+    if (result.count("profile-hang-detection")) {
+        settings.profileHangDetection = true;
+    }
+    if (result.count("transposition-table-size")) {
+        settings.transpositionTableSize = result["transposition-table-size"].as<int>();
+    }
+    if (result.count("profile-file")) {
+        profileFile = result["profile-file"].as<std::string>();
+        settings.subTreeProfileDepth = (result.count("profile-depth")
+                                        ? result["profile-depth"].as<int>() : 4);
+    }
+
+    BeamSearchSettings beamSettings;
+    if (result.count("beam-width")) {
+        beamSettings.beamWidth = result["beam-width"].as<int>();
+    }
+    if (result.count("max-queue-size")) {
+        beamSettings.maxQueueSize = result["max-queue-size"].as<int>();
+    }
+    if (result.count("max-expansions")) {
+        beamSettings.maxExpansions = result["max-expansions"].as<long>();
+    }
+    LocalSearchSettings localSettings;
+    if (result.count("max-candidates")) {
+        localSettings.maxCandidates = result["max-candidates"].as<long>();
+    }
+    if (result.count("max-mutations")) {
+        localSettings.maxMutations = result["max-mutations"].as<int>();
+    }
+    if (result.count("temperature")) {
+        localSettings.initialTemperature = result["temperature"].as<double>();
+    }
+    unsigned int randomSeed = 0;
+    if (result.count("random-seed")) {
+        randomSeed = result["random-seed"].as<unsigned int>();
+        localSettings.randomSeed = randomSeed;
+    }
+    int numProbes = 1000;
+    if (result.count("probes")) {
+        numProbes = result["probes"].as<int>();
+    }
+    if (result.count("threads")) {
+        beamSettings.numThreads = result["threads"].as<int>();
+        localSettings.numThreads = result["threads"].as<int>();
+        numThreads = result["threads"].as<int>();
+    }
+    if (result.count("closed-tape-filter")) {
+        closedTapeFilter = true;
+    }
+    if (result.count("certificate-file")) {
+        certificateFile = result["certificate-file"].as<std::string>();
+    }
 
     std::string inputFile;
     if (result.count("input-file")) {
         inputFile = result["input-file"].as<std::string>();
     }
-    bool expectsInputFile = runMode == RunMode::ONLY_RUN || runMode == RunMode::LATE_ESCAPE;
+    bool expectsInputFile = (runMode == RunMode::ONLY_RUN || runMode == RunMode::LATE_ESCAPE
+                             || runMode == RunMode::LOCAL_SEARCH || runMode == RunMode::SUB_TREES);
     if (inputFile.empty()) {
         if (expectsInputFile) {
             std::cerr << "Missing input file" << std::endl;
@@ -143,27 +315,38 @@ void init(int argc, char * argv[]) {
         }
     }
 
-    switch (runMode) {
-        case RunMode::ONLY_RUN:
-            if (fileContainsTabs(inputFile)) {
-                searchRunner = std::make_shared<FastExecSearchRunner_InterpretedProgram>(settings,
-                                                                                         inputFile);
-            } else {
-                searchRunner = std::make_shared<FastExecSearchRunner_PlainProgram>(settings,
-                                                                                   inputFile);
-            }
-            break;
-        case RunMode::FULL_SEARCH:
-            searchRunner = std::make_shared<OrchestratedSearchRunner>(settings);
-            break;
-        case RunMode::RESUME_FROM: {
-            std::string resumeFrom = result["resume-from"].as<std::string>();
-            searchRunner = std::make_shared<ResumeSearchRunner>(settings, resumeFrom);
-            break;
+    std::string resumeFrom;
+    if (runMode == RunMode::RESUME_FROM) {
+        resumeFrom = result["resume-from"].as<std::string>();
+    }
+
+    if (runMode == RunMode::ONLY_RUN) {
+        // The programs can be of any size, so this does not depend on the program size settings
+        if (fileContainsTabs(inputFile)) {
+            searchRunner = std::make_shared<FastExecSearchRunner_InterpretedProgram>(settings,
+                                                                                     inputFile);
+        } else {
+            searchRunner = std::make_shared<FastExecSearchRunner_PlainProgram>(settings,
+                                                                               inputFile);
         }
-        case RunMode::LATE_ESCAPE:
-            searchRunner = std::make_shared<LateEscapeSearchRunner>(settings, inputFile);
-            break;
+    } else if (runMode == RunMode::LOCAL_SEARCH) {
+        // The size of the programs is determined by the seed programs
+        searchRunner = std::make_shared<LocalSearchRunner>(settings, localSettings, inputFile);
+    } else if (settings.size.width == 6 && settings.size.height == 6) {
+        searchRunner = createSearchRunner<8, 6>(runMode, settings, inputFile, resumeFrom,
+                                                beamSettings, numProbes, randomSeed);
+    } else if (settings.size.width == 7 && settings.size.height == 7) {
+        searchRunner = createSearchRunner<8, 7>(runMode, settings, inputFile, resumeFrom,
+                                                beamSettings, numProbes, randomSeed);
+    } else if (InterpretedProgramBuilder::supportsSize(settings.size)) {
+        searchRunner = createSearchRunner<8>(runMode, settings, inputFile, resumeFrom,
+                                             beamSettings, numProbes, randomSeed);
+    } else if (LargeInterpretedProgramBuilder::supportsSize(settings.size)) {
+        searchRunner = createSearchRunner<16>(runMode, settings, inputFile, resumeFrom,
+                                              beamSettings, numProbes, randomSeed);
+    } else {
+        std::cerr << "Unsupported program size: " << settings.size << std::endl;
+        exit(-1);
     }
     searchRunner->getSearcher().dumpSettings(std::cout);
 
@@ -178,21 +361,81 @@ void init(int argc, char * argv[]) {
     if (result.count("dump-success-steps-limit")) {
         tracker->setDumpSuccessStepsLimit(result["dump-success-steps-limit"].as<int>());
     }
+    if (result.count("profile-hang-detection")) {
+        tracker->setDumpHangDetectionProfile(true);
+    }
+    if (result.count("metrics-file")) {
+        auto metricsFile = result["metrics-file"].as<std::string>();
+        if (!tracker->setMetricsFile(metricsFile)) {
+            std::cerr << "Could not open metrics file: " << metricsFile << std::endl;
+            exit(-1);
+        }
+    }
 
     if (runMode == RunMode::ONLY_RUN || runMode == RunMode::LATE_ESCAPE) {
         tracker->setDumpSuccessStepsLimit(0); // Dump every successful program
     }
+    tracker->setCollectAssumedHangs(closedTapeFilter);
+    tracker->setCollectCertificates(!certificateFile.empty());
 
     searchRunner->getSearcher().attachProgressTracker(std::move(tracker));
 }
 
+// Moves the assumed hangs that the closed tape decider proves to hang to their own hang type.
+// Their proofs are added to the certified hangs.
+void filterAssumedHangs(ProgressTracker& tracker, std::vector<CertifiedHang>& certifiedHangs) {
+    auto results = decideClosedTapeHangs(tracker.getAssumedHangs(), {}, numThreads);
+    long numProven = 0;
+    for (auto& result : results) {
+        if (!result.proven) continue;
+
+        numProven++;
+        if (!certificateFile.empty()) {
+            CertifiedHang hang;
+            hang.programSpec = result.programSpec;
+            hang.certificate.type = CertificateType::CLOSED_TAPE;
+            hang.certificate.closedTape = std::move(result.certificate);
+            certifiedHangs.push_back(std::move(hang));
+        }
+    }
+
+    std::cout << "Closed tape filter: proven " << numProven
+    << " of " << results.size() << " assumed hangs" << std::endl;
+    tracker.reportProvenAssumedHangs(HangType::CLOSED_TAPE, numProven);
+}
+
 int main(int argc, char * argv[]) {
     init(argc, argv);
 
     searchRunner->run();
 
+    if (!profileFile.empty()) {
+        const SubTreeProfile* profile = searchRunner->getSearcher().getSubTreeProfile();
+        if (!profile) {
+            std::cerr << "Sub-tree profiling is not supported by this run mode" << std::endl;
+        } else if (!profile->writeToFile(profileFile)) {
+            std::cerr << "Could not write profile file: " << profileFile << std::endl;
+        }
+    }
+
     auto tracker = searchRunner->detachProgressTracker();
+    std::vector<CertifiedHang> certifiedHangs = tracker->getCertifiedHangs();
+    if (closedTapeFilter) {
+        filterAssumedHangs(*tracker, certifiedHangs);
+    }
+    if (!certificateFile.empty()) {
+        std::ofstream output(certificateFile);
+        if (output) {
+            writeCertifiedHangs(output, certifiedHangs);
+        } else {
+            std::cerr << "Could not write certificate file: " << certificateFile << std::endl;
+        }
+    }
     tracker->dumpStats();
+    if (tracker->getDumpHangDetectionProfile()) {
+        // The tracker is detached, so dump the profile directly
+        searchRunner->getSearcher().dumpHangDetectionProfile(std::cout);
+    }
 
     return 0;
 }
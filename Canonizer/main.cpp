@@ -26,14 +26,17 @@ void outputInterpretedProgram(InterpretedProgram& program) {
 void canonizeProgram(std::string& programSpec) {
     Program program = Program::fromString(programSpec);
 
-    InterpretedProgramBuilder builder;
-    builder.buildFromProgram(program);
+    auto interpretedProgram = buildInterpretedProgram(program);
+    if (!interpretedProgram) {
+        std::cerr << "Program too large: " << programSpec << std::endl;
+        return;
+    }
 
     std::cout << programSpec;
     if (SKIP_CANONIZE) {
-        outputInterpretedProgram(builder);
+        outputInterpretedProgram(*interpretedProgram);
     } else {
-        InterpretedProgramCanonizer canonizer {builder};
+        InterpretedProgramCanonizer canonizer {*interpretedProgram};
         outputInterpretedProgram(canonizer);
     }
 }
@@ -0,0 +1,88 @@
+//
+//  main.cpp
+//  Planner
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cxxopts.hpp"
+
+#include "SubTreeProfiler.h"
+#include "Utils.h"
+#include "WorkPlanner.h"
+
+// Divides a search over workers, based on the sub-tree profile of an earlier search. For each
+// worker it writes a file with the instruction stacks of its work units. These can be searched
+// using the SUBTREES run mode.
+int main(int argc, char * argv[]) {
+    cxxopts::Options options("Planner", "Divides a search into balanced work units");
+    options.add_options()
+        ("profile-file", "Sub-tree profile of an earlier search", cxxopts::value<std::string>())
+        ("workers", "Number of workers", cxxopts::value<int>()->default_value("1"))
+        ("units-per-worker", "Minimum number of work units per worker",
+         cxxopts::value<int>()->default_value("8"))
+        ("cost", "Cost metric. One of: TIME, STEPS, PROGRAMS",
+         cxxopts::value<std::string>()->default_value("TIME"))
+        ("output", "Prefix of the output files",
+         cxxopts::value<std::string>()->default_value("work-units"))
+        ("help", "Show help");
+    auto result = options.parse(argc, argv);
+
+    if (result.count("help") || !result.count("profile-file")) {
+        std::cout << options.help() << std::endl;
+        return result.count("help") ? 0 : -1;
+    }
+
+    CostMetric costMetric;
+    auto cost = result["cost"].as<std::string>();
+    if (cost == "TIME") {
+        costMetric = CostMetric::WALL_TIME;
+    } else if (cost == "STEPS") {
+        costMetric = CostMetric::STEPS;
+    } else if (cost == "PROGRAMS") {
+        costMetric = CostMetric::PROGRAMS;
+    } else {
+        std::cerr << "Unknown cost metric: " << cost << std::endl;
+        return -1;
+    }
+
+    SubTreeProfile profile;
+    auto profileFile = result["profile-file"].as<std::string>();
+    if (!profile.readFromFile(profileFile)) {
+        std::cerr << "Could not read profile file: " << profileFile << std::endl;
+        return -1;
+    }
+
+    int numWorkers = std::max(1, result["workers"].as<int>());
+    WorkPlanner planner(profile, costMetric);
+    auto units = planner.createWorkUnits(numWorkers * result["units-per-worker"].as<int>());
+    auto workers = planner.assignWorkUnits(units, numWorkers);
+
+    auto outputPrefix = result["output"].as<std::string>();
+    for (size_t i = 0; i < workers.size(); i++) {
+        std::string filename = outputPrefix + "-" + std::to_string(i) + ".txt";
+        std::ofstream output(filename);
+        if (!output) {
+            std::cerr << "Could not write file: " << filename << std::endl;
+            return -1;
+        }
+
+        double workerCost = 0;
+        for (auto& unit : workers[i]) {
+            dumpInstructionStack(unit.stack, output, ",");
+            output << std::endl;
+            workerCost += unit.cost;
+        }
+
+        std::cout << filename << ": Units=" << workers[i].size()
+        << ", Cost=" << workerCost << std::endl;
+    }
+
+    return 0;
+}
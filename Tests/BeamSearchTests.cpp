@@ -0,0 +1,93 @@
+//
+//  BeamSearchTests.cpp
+//  Tests
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include <memory>
+
+#include "catch.hpp"
+
+#include "BeamSearcher.h"
+
+TEST_CASE("Expand partial program", "[search][beam]") {
+    SearchSettings settings {5};
+    ExhaustiveSearcher searcher {settings};
+
+    auto tracker = std::make_unique<ProgressTracker>();
+    tracker->setDumpSuccessStepsLimit(INT_MAX);
+    searcher.attachProgressTracker(std::move(tracker));
+
+    std::vector<PartialProgram> frontier;
+    searcher.expand({}, frontier);
+
+    REQUIRE(frontier.size() > 0);
+    for (auto& partialProgram : frontier) {
+        REQUIRE(partialProgram.instructions.size() >= 1);
+        REQUIRE(partialProgram.score > 0);
+    }
+
+    // Expanding a child only yields programs that extend it
+    auto child = frontier[0].instructions;
+    std::vector<PartialProgram> frontier2;
+    searcher.expand(child, frontier2);
+    for (auto& partialProgram : frontier2) {
+        REQUIRE(partialProgram.instructions.size() > child.size());
+        REQUIRE(std::equal(child.begin(), child.end(), partialProgram.instructions.begin()));
+    }
+}
+
+TEST_CASE("5x5 Beam search", "[search][5x5][beam]") {
+    SearchSettings settings {5};
+    BeamSearchSettings beamSettings;
+
+    auto search = [&]() {
+        BeamSearcher searcher {settings, beamSettings};
+        auto tracker = std::make_unique<ProgressTracker>();
+        tracker->setDumpSuccessStepsLimit(INT_MAX);
+        searcher.attachProgressTracker(std::move(tracker));
+
+        searcher.search();
+
+        REQUIRE(searcher.getMaxStepsFound() == searcher.getProgressTracker()->getMaxStepsFound());
+        return searcher.detachProgressTracker();
+    };
+
+    SECTION("Unbounded queue") {
+        // Without dropping partial programs, all programs are eventually visited
+        beamSettings.beamWidth = 50;
+        auto tracker = search();
+
+        REQUIRE(tracker->getMaxStepsFound() == 44);
+        REQUIRE(tracker->getTotalSuccess() == 31055);
+        REQUIRE(tracker->getTotalErrors() == 0);
+    }
+    SECTION("Bounded queue") {
+        beamSettings.beamWidth = 50;
+        beamSettings.maxQueueSize = 200;
+        auto tracker = search();
+
+        REQUIRE(tracker->getTotalSuccess() < 31055);
+    }
+    SECTION("Limited expansions") {
+        beamSettings.beamWidth = 50;
+        beamSettings.maxExpansions = 120;
+        beamSettings.numThreads = 4;
+        BeamSearcher searcher {settings, beamSettings};
+        searcher.attachProgressTracker(std::make_unique<ProgressTracker>());
+
+        searcher.search();
+
+        REQUIRE(searcher.getTotalExpanded() == 120);
+    }
+    SECTION("Multi-threaded") {
+        beamSettings.beamWidth = 50;
+        beamSettings.numThreads = 4;
+        auto tracker = search();
+
+        REQUIRE(tracker->getMaxStepsFound() == 44);
+        REQUIRE(tracker->getTotalSuccess() == 31055);
+    }
+}
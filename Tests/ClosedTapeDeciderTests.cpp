@@ -0,0 +1,76 @@
+//
+//  ClosedTapeDeciderTests.cpp
+//  Tests
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include <sstream>
+
+#include "catch.hpp"
+
+#include "ClosedTapeDecider.h"
+#include "InterpretedProgramBuilder.h"
+#include "Program.h"
+
+TEST_CASE("6x6 Closed tape decider", "[hang][closed-tape][6x6]") {
+    ClosedTapeDecider decider;
+    ClosedTapeCertificate certificate;
+
+    SECTION("6x6-AssumedHang") {
+        // A hang that none of the hang detectors detects.
+        //
+        //     * *
+        //   * o o *
+        // o _ o _ *
+        // o * o o _ *
+        // _   _ *
+        // _   *
+        Program program = Program::fromString("Zvr7W0S2UjLzvw");
+        auto interpretedProgram = buildInterpretedProgram(program);
+
+        REQUIRE(decider.proveHang(*interpretedProgram, certificate));
+        REQUIRE(verifyClosedTapeCertificate(*interpretedProgram, certificate));
+
+        std::stringstream stream;
+        certificate.write(stream);
+        REQUIRE(!stream.str().empty());
+
+        SECTION("Incomplete certificate") {
+            // Removing any configuration other than the initial one breaks the closure
+            auto initialConfig = ClosedTapeConfig {
+                .blockIndex = 0, .segment = TapeSegment(2 * certificate.windowSize - 1, 0)
+            };
+            auto it = std::find_if(certificate.configs.begin(), certificate.configs.end(),
+                                   [&](auto& config) {
+                return config.blockIndex != initialConfig.blockIndex
+                    || config.segment != initialConfig.segment;
+            });
+            REQUIRE(it != certificate.configs.end());
+            certificate.configs.erase(it);
+
+            REQUIRE(!verifyClosedTapeCertificate(*interpretedProgram, certificate));
+        }
+        SECTION("Incomplete windows") {
+            certificate.windows.pop_back();
+
+            REQUIRE(!verifyClosedTapeCertificate(*interpretedProgram, certificate));
+        }
+    }
+    SECTION("6x6-Terminates") {
+        // The 6x6 busy beaver, which terminates after 573 steps
+        Program program = Program::fromString("Zu65Euk8W4Flbw");
+        auto interpretedProgram = buildInterpretedProgram(program);
+
+        REQUIRE(!decider.proveHang(*interpretedProgram, certificate));
+    }
+    SECTION("In parallel") {
+        auto results = decideClosedTapeHangs({"Zvr7W0S2UjLzvw", "Zu65Euk8W4Flbw"}, {}, 2);
+
+        REQUIRE(results.size() == 2);
+        REQUIRE(results[0].proven);
+        REQUIRE(results[0].programSpec == "Zvr7W0S2UjLzvw");
+        REQUIRE(!results[1].proven);
+    }
+}
@@ -0,0 +1,49 @@
+//
+//  CounterHangTests.cpp
+//  Tests
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include "catch.hpp"
+
+#include "HangExecutor.h"
+
+TEST_CASE("7x7 Counter hang tests", "[hang][counter][7x7]") {
+    HangExecutor hangExecutor(1024, 100000);
+    hangExecutor.setMaxSteps(100000);
+    hangExecutor.addDefaultHangDetectors();
+
+    SECTION("7x7-DoublingCounter") {
+        // Two counters move slowly leftwards. Each iteration of the meta-loop doubles their values
+        // while moving them two positions. It is not a glider as both loops run longer each time.
+        //
+        //     * *   *
+        // * o o o o _ *
+        // o _ o o * _
+        // _ _ o *   _
+        // _ * _   * _
+        // _ * o * _ o *
+        // _   *     *
+        RunResult result = hangExecutor.execute("d/ruVSRYwbMjjJhjvs");
+
+        REQUIRE(result == RunResult::DETECTED_HANG);
+        REQUIRE(hangExecutor.detectedHangType() == HangType::AFFINE_COUNTER);
+    }
+    SECTION("7x7-TriplingCounter") {
+        // Similar to the previous program, but the counters are tripled each iteration.
+        //
+        //     * *   *
+        // * o o o o _ *
+        // o _ o o * _
+        // _ _ o o * _
+        // _ * o _ o o *
+        // _ * o *   *
+        // _   *
+        RunResult result = hangExecutor.execute("d/ruVSRYwWMkWJuzv8");
+
+        REQUIRE(result == RunResult::DETECTED_HANG);
+        REQUIRE(hangExecutor.detectedHangType() == HangType::AFFINE_COUNTER);
+    }
+}
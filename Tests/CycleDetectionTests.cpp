@@ -0,0 +1,251 @@
+//
+//  CycleDetectionTests.cpp
+//  Tests
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include <memory>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "CycleDetector.h"
+#include "Data.h"
+#include "FastExecSearcher.h"
+#include "FastExecutor.h"
+#include "HangDetector.h"
+#include "HangExecutor.h"
+#include "InterpretedProgramBuilder.h"
+#include "Program.h"
+
+TEST_CASE("Tape fingerprint", "[cycle-detection][fingerprint]") {
+    Data data(1024);
+
+    // Writes the values at DP and onwards, and moves DP back to where it started
+    auto write = [&data](std::vector<int> values) {
+        for (int value : values) {
+            data.delta(value);
+            data.shift(1);
+        }
+        data.shift(-(int)values.size());
+    };
+
+    uint64_t empty = data.getFingerprint();
+    write({1, -2, 3});
+    uint64_t pattern = data.getFingerprint();
+    REQUIRE(pattern != empty);
+
+    SECTION("Translation") {
+        // Move the pattern five cells to the right, and follow it with DP
+        write({-1, 2, -3});
+        data.shift(5);
+        write({1, -2, 3});
+        REQUIRE(data.getFingerprint() == pattern);
+
+        // It is relative to DP
+        data.shift(1);
+        REQUIRE(data.getFingerprint() != pattern);
+    }
+    SECTION("Different values") {
+        data.delta(1);
+        REQUIRE(data.getFingerprint() != pattern);
+        data.delta(-1);
+        REQUIRE(data.getFingerprint() == pattern);
+    }
+    SECTION("Undo") {
+        size_t undoSize = data.undoStackSize();
+        data.shift(-3);
+        write({7, 7});
+        REQUIRE(data.getFingerprint() != pattern);
+
+        data.undo(undoSize);
+        REQUIRE(data.getFingerprint() == pattern);
+
+        data.undo(0);
+        REQUIRE(data.getFingerprint() == empty);
+    }
+}
+
+TEST_CASE("Cycle detector", "[cycle-detection]") {
+    CycleDetector cycleDetector;
+    std::vector<int> tape(64);
+    TapeFingerprint fingerprint;
+    int* dataP = &tape[16];
+
+    // The blocks are only compared, so can be any pointer
+    const ProgramBlock* blocks[2] = {
+        reinterpret_cast<const ProgramBlock*>(&tape[0]),
+        reinterpret_cast<const ProgramBlock*>(&tape[1])
+    };
+
+    auto update = [&](int step) {
+        return cycleDetector.update(blocks[step % 2], fingerprint.value(),
+                                    &tape[2], &tape[62], dataP);
+    };
+
+    SECTION("Translated cycle") {
+        // Moves a value to the right, one cell every two steps
+        *dataP = 5;
+        fingerprint.change(0, 5);
+
+        bool detected = false;
+        int step = 0;
+        while (!detected && step < 40) {
+            if (step % 2 == 0) {
+                fingerprint.change(*dataP, 0);
+                *dataP = 0;
+                dataP++;
+                fingerprint.shift(1);
+                fingerprint.change(*dataP, 5);
+                *dataP = 5;
+            }
+            detected = update(++step);
+        }
+
+        REQUIRE(detected);
+        REQUIRE(cycleDetector.numComparisons() == 1);
+    }
+    SECTION("Counter") {
+        // Increments a counter every step, so the state never repeats
+        bool detected = false;
+        for (int step = 1; step < 40 && !detected; step++) {
+            fingerprint.change(*dataP, *dataP + 1);
+            *dataP += 1;
+            detected = update(step);
+        }
+
+        REQUIRE(!detected);
+    }
+}
+
+TEST_CASE("6x6 Cycle hang tests", "[hang][cycle-detection][6x6]") {
+    // A periodic hang that travels along the tape. Its execution state repeats, translated.
+    //
+    //   *     *
+    // * o _ _ _ *
+    //   o *   o
+    // * _ _ o o *
+    // * * _ * o
+    // o o o * *
+    std::string programSpec = "ZiCJAhhIFqJFaA";
+
+    SECTION("Hang executor") {
+        HangExecutor hangExecutor(1024, 1024);
+        hangExecutor.setMaxSteps(1024);
+        hangExecutor.addDefaultHangDetectors();
+
+        RunResult result = hangExecutor.execute(programSpec);
+
+        REQUIRE(result == RunResult::DETECTED_HANG);
+        REQUIRE(hangExecutor.detectedHangType() == HangType::PERIODIC);
+        REQUIRE(std::string(hangExecutor.detectedHang()->name()) == "Cycle");
+    }
+    SECTION("Fast executor") {
+        FastExecutor fastExecutor(1024);
+        fastExecutor.setMaxSteps(1000);
+
+        Program program = Program::fromString(programSpec);
+        auto programBuilder = std::make_shared<InterpretedProgramBuilder>();
+        programBuilder->buildFromProgram(program);
+
+        REQUIRE(fastExecutor.execute(programBuilder) == RunResult::ASSUMED_HANG);
+        fastExecutor.pop();
+
+        fastExecutor.setDetectCycles(true);
+        REQUIRE(fastExecutor.execute(programBuilder) == RunResult::DETECTED_HANG);
+        REQUIRE(fastExecutor.detectedHangType() == HangType::PERIODIC);
+        REQUIRE(fastExecutor.numSteps() < 200);
+    }
+    SECTION("Fast exec searcher") {
+        BaseSearchSettings settings {6};
+        settings.maxSteps = 1000;
+        settings.fastExecCycleDetection = true;
+        FastExecSearcher searcher(settings);
+        searcher.attachProgressTracker(std::make_unique<ProgressTracker>());
+
+        Program program = Program::fromString(programSpec);
+        auto programBuilder = std::make_shared<InterpretedProgramBuilder>();
+        programBuilder->buildFromProgram(program);
+        searcher.run(programSpec, programBuilder);
+
+        auto tracker = searcher.getProgressTracker();
+        REQUIRE(tracker->getTotal() == 1);
+        REQUIRE(tracker->getTotalHangs(HangType::PERIODIC) == 1);
+        REQUIRE(tracker->getTotalDetectedHangs() == 1);
+    }
+    SECTION("Fast executor sampling") {
+        FastExecutor fastExecutor(1024);
+        fastExecutor.setMaxSteps(100000);
+        fastExecutor.setCellWidth(CellWidth::NARROW_8);
+        fastExecutor.setSampleCycles(true);
+
+        Program program = Program::fromString(programSpec);
+        auto programBuilder = std::make_shared<InterpretedProgramBuilder>();
+        programBuilder->buildFromProgram(program);
+
+        // The first sample is only taken after 1024 steps
+        REQUIRE(fastExecutor.execute(programBuilder) == RunResult::DETECTED_HANG);
+        REQUIRE(fastExecutor.detectedHangType() == HangType::PERIODIC);
+        REQUIRE(fastExecutor.numSteps() > 1024);
+        REQUIRE(fastExecutor.numSteps() < 4096);
+        REQUIRE(fastExecutor.getActiveCellWidth() == CellWidth::NARROW_8);
+    }
+    SECTION("Fast exec searcher sampling") {
+        BaseSearchSettings settings {6};
+        settings.maxSteps = 100000;
+        settings.fastExecCycleSampling = true;
+        FastExecSearcher searcher(settings);
+        searcher.attachProgressTracker(std::make_unique<ProgressTracker>());
+
+        Program program = Program::fromString(programSpec);
+        auto programBuilder = std::make_shared<InterpretedProgramBuilder>();
+        programBuilder->buildFromProgram(program);
+        searcher.run(programSpec, programBuilder);
+
+        auto tracker = searcher.getProgressTracker();
+        REQUIRE(tracker->getTotal() == 1);
+        REQUIRE(tracker->getTotalHangs(HangType::PERIODIC) == 1);
+        REQUIRE(tracker->getTotalSteps() > 1024);
+        REQUIRE(tracker->getTotalSteps() < 4096);
+    }
+}
+
+TEST_CASE("6x6 Translated cycle hang tests", "[hang][cycle-detection][6x6]") {
+    HangExecutor hangExecutor(1024, 1024);
+    hangExecutor.setMaxSteps(1024);
+    hangExecutor.addDefaultHangDetectors();
+
+    SECTION("6x6-TranslatedCycle") {
+        // A hang that the loop-based detectors do not detect within the hang detection window.
+        // It repeats the same behavior while it extends the data to the right.
+        //
+        //       *
+        //     * o _ *
+        //   * * o _
+        //   _ o o *
+        // * _ _ o
+        // o _ o *
+        RunResult result = hangExecutor.execute("Zv7/kuk8W4H0bw");
+
+        REQUIRE(result == RunResult::DETECTED_HANG);
+        REQUIRE(hangExecutor.detectedHangType() == HangType::TRANSLATED_CYCLER);
+    }
+    SECTION("6x6-TravellingPeriodicHang") {
+        // This hang is also a translated cycle. However, the translated cycle detector defers its
+        // detection until the end of the hang detection window, so that the hang keeps the
+        // classification of the loop-based detectors.
+        //
+        //   * *   *
+        // * o o o _ *
+        //   * o o o *
+        // * _ o * *
+        // * o *
+        // o o *
+        RunResult result = hangExecutor.execute("ZiiJUiVoaJgFgA");
+
+        REQUIRE(result == RunResult::DETECTED_HANG);
+        REQUIRE(hangExecutor.detectedHangType() == HangType::PERIODIC);
+    }
+}
@@ -6,10 +6,13 @@
 //  Copyright © 2019 Erwin Bonsma.
 //
 
+#include <cmath>
 #include <memory>
+#include <random>
 #include "catch.hpp"
 
 #include "ExhaustiveSearcher.h"
+#include "Utils.h"
 
 TEST_CASE( "3x3 Search", "[search][3x3][exhaustive]" ) {
     SearchSettings settings {3};
@@ -24,7 +27,8 @@ TEST_CASE( "3x3 Search", "[search][3x3][exhaustive]" ) {
 
         tracker = searcher.detachProgressTracker();
         REQUIRE(tracker->getMaxStepsFound() == 5);
-        REQUIRE(tracker->getTotalSuccess() == 59);
+        REQUIRE(tracker->getTotalSuccess() == 38);
+        REQUIRE(tracker->getTotalSuccess() + tracker->getTotalEquivalent() == 59);
     }
     SECTION("3x3-FindOne") {
         searcher.findOne();
@@ -48,12 +52,32 @@ TEST_CASE( "4x4 Search", "[search][4x4][exhaustive]" ) {
 
         tracker = searcher.detachProgressTracker();
         REQUIRE(tracker->getMaxStepsFound() == 15);
-        REQUIRE(tracker->getTotalSuccess() == 854);
+        REQUIRE(tracker->getTotalSuccess() == 533);
+        REQUIRE(tracker->getTotalSuccess() + tracker->getTotalEquivalent() == 854);
         REQUIRE(tracker->getTotalErrors() == 0);
         REQUIRE(tracker->getTotalDetectedHangs() == tracker->getTotalHangs());
     }
 }
 
+TEST_CASE( "4x4 Search without equivalence pruning", "[search][4x4][exhaustive]" ) {
+    SearchSettings settings {4};
+    settings.disableEquivalencePruning = true;
+    ExhaustiveSearcher searcher {settings};
+
+    auto tracker = std::make_unique<ProgressTracker>();
+    tracker->setDumpSuccessStepsLimit(INT_MAX);
+    searcher.attachProgressTracker(std::move(tracker));
+
+    SECTION("Find all") {
+        searcher.search();
+
+        tracker = searcher.detachProgressTracker();
+        REQUIRE(tracker->getMaxStepsFound() == 15);
+        REQUIRE(tracker->getTotalSuccess() == 854);
+        REQUIRE(tracker->getTotalEquivalent() == 0);
+    }
+}
+
 TEST_CASE( "5x5 Search", "[search][5x5][exhaustive]" ) {
     SearchSettings settings {5};
     ExhaustiveSearcher searcher {settings};
@@ -68,8 +92,64 @@ TEST_CASE( "5x5 Search", "[search][5x5][exhaustive]" ) {
 
         tracker = searcher.detachProgressTracker();
         REQUIRE(tracker->getMaxStepsFound() == 44);
-        REQUIRE(tracker->getTotalSuccess() == 51410);
+        REQUIRE(tracker->getTotalSuccess() == 31055);
+        REQUIRE(tracker->getTotalSuccess() + tracker->getTotalEquivalent() == 51410);
         REQUIRE(tracker->getTotalErrors() == 0);
         REQUIRE(tracker->getTotalHangs() == tracker->getTotalDetectedHangs());
     }
 }
+
+TEST_CASE( "5x5 Search with asynchronous hang verification", "[search][5x5][exhaustive]" ) {
+    auto search = [](int numVerificationThreads) {
+        SearchSettings settings {5};
+        settings.testHangDetection = true;
+        settings.numVerificationThreads = numVerificationThreads;
+        ExhaustiveSearcher searcher {settings};
+
+        auto tracker = std::make_unique<ProgressTracker>();
+        tracker->setDumpSuccessStepsLimit(INT_MAX);
+        searcher.attachProgressTracker(std::move(tracker));
+        searcher.search();
+
+        return searcher.detachProgressTracker();
+    };
+
+    auto reference = search(0);
+    auto tracker = search(2);
+
+    REQUIRE(tracker->getTotal() == reference->getTotal());
+    REQUIRE(tracker->getTotalSuccess() == reference->getTotalSuccess());
+    REQUIRE(tracker->getTotalLateEscapes() == reference->getTotalLateEscapes());
+    REQUIRE(tracker->getTotalErrors() == reference->getTotalErrors());
+    for (int i = 0; i < numHangTypes; i++) {
+        REQUIRE(tracker->getTotalHangs((HangType)i) == reference->getTotalHangs((HangType)i));
+    }
+    REQUIRE(tracker->getMaxStepsFound() == 44);
+}
+
+TEST_CASE( "5x5 Search tree estimate", "[search][5x5][estimate]" ) {
+    SearchSettings settings {5};
+    ExhaustiveSearcher searcher {settings};
+
+    auto tracker = std::make_unique<ProgressTracker>();
+    tracker->setDumpSuccessStepsLimit(INT_MAX);
+    searcher.attachProgressTracker(std::move(tracker));
+
+    searcher.search();
+    long total = searcher.getProgressTracker()->getTotal();
+
+    std::mt19937 random(42);
+    SampleStats programs;
+    for (int i = 0; i < 5000; i++) {
+        ProbeResult result = searcher.probe({}, random);
+        REQUIRE(result.numPrograms >= 0);
+        REQUIRE(result.searchTime > 0);
+        programs.add(result.numPrograms);
+    }
+
+    // The estimate excludes late escapes, like the total. It is unbiased, but the number of
+    // programs in a sub-tree is heavy-tailed, so check it against its own confidence interval
+    // instead of a fixed fraction of the total
+    REQUIRE(programs.count() == 5000);
+    REQUIRE(std::abs(programs.mean() - total) < programs.confidenceInterval());
+}
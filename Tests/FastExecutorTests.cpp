@@ -37,3 +37,47 @@ TEST_CASE("6x6 Fast Executor tests", "[6x6][fast-exec]") {
         REQUIRE(result == RunResult::DATA_ERROR);
     }
 }
+
+TEST_CASE("Fast Executor narrow cell tests", "[fast-exec][narrow]") {
+    FastExecutor wideExecutor(1024);
+    FastExecutor narrowExecutor(1024);
+    wideExecutor.setMaxSteps(100000);
+    narrowExecutor.setMaxSteps(100000);
+
+    std::string programSpec;
+    CellWidth expectedActiveWidth = CellWidth::WIDE;
+
+    SECTION("6x6-NarrowCells-DataError") {
+        // Small data values. Terminates with a DATA_ERROR.
+        programSpec = "ZiiIRkKCACQggA";
+        narrowExecutor.setCellWidth(CellWidth::NARROW_8);
+        expectedActiveWidth = CellWidth::NARROW_8;
+    }
+    SECTION("6x6-NarrowCells-Success") {
+        // The longest running 6x6 program. Its values remain small.
+        programSpec = "Zu65Euk8W4Flbw";
+        narrowExecutor.setCellWidth(CellWidth::NARROW_8);
+        expectedActiveWidth = CellWidth::NARROW_8;
+    }
+    SECTION("7x7-NarrowCells-Overflow8") {
+        // Values grow beyond what fits in eight bits, so execution needs to switch to wide cells
+        programSpec = "Zv6+kpUoAqW0bw";
+        narrowExecutor.setCellWidth(CellWidth::NARROW_8);
+    }
+    SECTION("7x7-NarrowCells-Overflow16") {
+        programSpec = "Zv6+kpUoAqW0bw";
+        narrowExecutor.setCellWidth(CellWidth::NARROW_16);
+        expectedActiveWidth = CellWidth::NARROW_16;
+    }
+
+    Program program = Program::fromString(programSpec);
+    auto programBuilder = std::make_shared<InterpretedProgramBuilder>();
+    programBuilder->buildFromProgram(program);
+
+    RunResult wideResult = wideExecutor.execute(programBuilder);
+    RunResult narrowResult = narrowExecutor.execute(programBuilder);
+
+    REQUIRE(narrowResult == wideResult);
+    REQUIRE(narrowExecutor.numSteps() == wideExecutor.numSteps());
+    REQUIRE(narrowExecutor.getActiveCellWidth() == expectedActiveWidth);
+}
@@ -0,0 +1,116 @@
+//
+//  HangCertificateTests.cpp
+//  Tests
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include <sstream>
+
+#include "catch.hpp"
+
+#include "HangCertificate.h"
+#include "HangDetector.h"
+#include "HangExecutor.h"
+#include "InterpretedProgramBuilder.h"
+#include "Program.h"
+
+namespace {
+
+bool verify(const std::string& programSpec, const HangCertificate& certificate) {
+    Program program = Program::fromString(programSpec);
+    auto interpretedProgram = buildInterpretedProgram(program);
+
+    return verifyHangCertificate(*interpretedProgram, certificate);
+}
+
+HangCertificate writeAndRead(const HangCertificate& certificate) {
+    std::stringstream stream;
+    certificate.write(stream);
+
+    HangCertificate result;
+    REQUIRE(result.read(stream));
+    return result;
+}
+
+}
+
+TEST_CASE("6x6 Cycle certificates", "[hang][certificate][6x6]") {
+    HangExecutor hangExecutor(1024, 1024);
+    hangExecutor.setMaxSteps(1024);
+    hangExecutor.addDefaultHangDetectors();
+    HangCertificate certificate;
+
+    SECTION("6x6-TranslatedCycle") {
+        std::string programSpec = "Zv7/kuk8W4H0bw";
+        REQUIRE(hangExecutor.execute(programSpec) == RunResult::DETECTED_HANG);
+        REQUIRE(hangExecutor.detectedHangType() == HangType::TRANSLATED_CYCLER);
+        REQUIRE(hangExecutor.detectedHang()->getCertificate(certificate));
+        REQUIRE(certificate.type == CertificateType::CYCLE);
+
+        REQUIRE(verify(programSpec, certificate));
+        REQUIRE(verify(programSpec, writeAndRead(certificate)));
+
+        SECTION("Wrong period") {
+            certificate.cycle.period -= 1;
+            REQUIRE(!verify(programSpec, certificate));
+        }
+    }
+    SECTION("6x6-CycleHang") {
+        std::string programSpec = "ZiCJAhhIFqJFaA";
+        REQUIRE(hangExecutor.execute(programSpec) == RunResult::DETECTED_HANG);
+        REQUIRE(std::string(hangExecutor.detectedHang()->name()) == "Cycle");
+        REQUIRE(hangExecutor.detectedHang()->getCertificate(certificate));
+
+        REQUIRE(verify(programSpec, certificate));
+    }
+    SECTION("6x6-Terminates") {
+        // The 6x6 busy beaver, which terminates after 573 steps
+        certificate.type = CertificateType::CYCLE;
+        certificate.cycle = CycleCertificate { .numSteps = 0, .period = 573 };
+
+        REQUIRE(!verify("Zu65Euk8W4Flbw", certificate));
+    }
+}
+
+TEST_CASE("7x7 Counter certificates", "[hang][certificate][counter][7x7]") {
+    HangExecutor hangExecutor(1024, 100000);
+    hangExecutor.setMaxSteps(100000);
+    hangExecutor.addDefaultHangDetectors();
+
+    // The doubling counter of the counter hang tests
+    std::string programSpec = "d/ruVSRYwbMjjJhjvs";
+    REQUIRE(hangExecutor.execute(programSpec) == RunResult::DETECTED_HANG);
+    REQUIRE(hangExecutor.detectedHangType() == HangType::AFFINE_COUNTER);
+
+    HangCertificate certificate;
+    REQUIRE(hangExecutor.detectedHang()->getCertificate(certificate));
+    REQUIRE(certificate.type == CertificateType::AFFINE_COUNTER);
+
+    REQUIRE(verify(programSpec, certificate));
+    REQUIRE(verify(programSpec, writeAndRead(certificate)));
+
+    SECTION("Wrong start") {
+        // The data does not match the template at any other point
+        certificate.counter.numSteps += 1;
+        REQUIRE(!verify(programSpec, certificate));
+    }
+    SECTION("Wrong template") {
+        auto& cell = certificate.counter.cells[certificate.counter.driverDp
+                                               - certificate.counter.minDp];
+        cell.factor *= 2;
+        REQUIRE(!verify(programSpec, certificate));
+    }
+    SECTION("In parallel") {
+        std::vector<CertifiedHang> hangs = {
+            { .programSpec = programSpec, .certificate = certificate },
+            { .programSpec = "d/ruVSRYwWMkWJuzv8", .certificate = certificate }
+        };
+        auto valid = verifyCertifiedHangs(hangs, 2);
+
+        REQUIRE(valid.size() == 2);
+        REQUIRE(valid[0]);
+        REQUIRE(!valid[1]);
+    }
+}
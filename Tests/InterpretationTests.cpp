@@ -11,6 +11,8 @@
 #include "catch.hpp"
 
 #include "ExhaustiveSearcher.h"
+#include "FastExecutor.h"
+#include "HangExecutor.h"
 
 TEST_CASE( "7x7 Interpretation Tests", "[interpretation][7x7]" ) {
     SearchSettings settings {7};
@@ -72,3 +74,33 @@ TEST_CASE("Round-trip interpreted programs", "[program][blocks]") {
     REQUIRE(spec == roundTripSpec);
     REQUIRE(steps == roundTripSteps);
 }
+
+TEST_CASE("Large program interpretation", "[interpretation][large]") {
+    std::string programSpec;
+
+    SECTION("12x14-Champion") {
+        programSpec = "zggIAACkgAEUCCEAAAEQgAEQEoGUAEECAmWQIEIgAEAWiEAAGAgCAAAIIA";
+    }
+    SECTION("13x13-Champion") {
+        programSpec = "3SICAAAKSAAEUCIBEAAARSAkGUEiBBgIQQIgGWgABCFogQAAYkoCAFgCCA";
+    }
+
+    Program program = Program::fromString(programSpec);
+    REQUIRE(!InterpretedProgramBuilder::supportsSize(program.getSize()));
+
+    auto interpretedProgram = buildInterpretedProgram(program);
+    REQUIRE(std::dynamic_pointer_cast<LargeInterpretedProgramBuilder>(interpretedProgram));
+
+    // Both champions run for an astronomical number of steps. Check that both executors can run
+    // them without errors.
+    const int maxSteps = 1000000;
+    FastExecutor fastExecutor(16384);
+    fastExecutor.setMaxSteps(maxSteps);
+    HangExecutor hangExecutor(16384, 0);
+    hangExecutor.setMaxSteps(maxSteps);
+
+    REQUIRE(fastExecutor.execute(interpretedProgram) == RunResult::ASSUMED_HANG);
+    REQUIRE(hangExecutor.execute(interpretedProgram) == RunResult::ASSUMED_HANG);
+    REQUIRE(fastExecutor.numSteps() >= maxSteps);
+    REQUIRE(hangExecutor.numSteps() >= maxSteps);
+}
@@ -0,0 +1,56 @@
+//
+//  LocalSearchTests.cpp
+//  Tests
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include <memory>
+
+#include "catch.hpp"
+
+#include "LocalSearcher.h"
+
+TEST_CASE("5x5 Local search", "[search][5x5][local]") {
+    SearchSettings settings {5};
+    LocalSearchSettings localSettings;
+    localSettings.maxCandidates = 2000;
+    localSettings.restartPeriod = 200;
+
+    // A program that runs for 33 steps
+    std::vector<std::string> seedPrograms = { "VcrlZAiDPs" };
+
+    auto search = [&]() {
+        LocalSearcher searcher {settings, localSettings};
+        searcher.attachProgressTracker(std::make_unique<ProgressTracker>());
+
+        searcher.search(seedPrograms);
+
+        REQUIRE(searcher.getNumCandidates() == localSettings.maxCandidates);
+        // Many candidates only differ in instructions that are never executed
+        REQUIRE(searcher.getNumCacheHits() > 0);
+
+        auto tracker = searcher.detachProgressTracker();
+        REQUIRE(searcher.getMaxStepsFound() == tracker->getMaxStepsFound());
+        REQUIRE(tracker->getTotalErrors() == 0);
+        REQUIRE(tracker->getTotalHangs() == tracker->getTotalDetectedHangs());
+
+        return tracker;
+    };
+
+    SECTION("Single-threaded") {
+        auto tracker = search();
+
+        REQUIRE(tracker->getMaxStepsFound() >= 33);
+        // Evaluated programs are not evaluated again
+        REQUIRE(tracker->getTotal() < localSettings.maxCandidates);
+    }
+    SECTION("Multi-threaded") {
+        localSettings.numThreads = 4;
+        seedPrograms.push_back("VbrQJw2GPs");
+        auto tracker = search();
+
+        REQUIRE(tracker->getMaxStepsFound() >= 33);
+    }
+}
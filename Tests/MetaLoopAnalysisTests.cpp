@@ -630,3 +630,60 @@ TEST_CASE( "Meta-loop (temporary, hang)", "[meta-loop-analysis][negative][hang]"
         hangExecutor.execute(program);
     }
 }
+
+// Analyzes each meta-loop until one has a fixed-size loop beyond the first meta-loop period
+class RunUntilUnrolledLoop : public HangDetector {
+    MetaLoopAnalysis& _mla;
+    int& _sequenceIndex;
+
+protected:
+    bool shouldCheckNow(HangDetectionEvents events) const override { return true; }
+
+    bool analyzeHangBehaviour() override {
+        if (!_mla.analyzeMetaLoop(_execution)) return false;
+
+        for (int i = _mla.metaLoopPeriod(); i < _mla.loopSize(); ++i) {
+            if (_mla.isLoop(i)
+                && _mla.loopBehaviors()[_mla.loopIndexForSequence(i)].iterationDelta() == 0) {
+                _sequenceIndex = i;
+                return true;
+            }
+        }
+        return false;
+    };
+    Trilian proofHang() override { return Trilian::YES; };
+
+public:
+    RunUntilUnrolledLoop(const ExecutionState& execution, MetaLoopAnalysis& mla,
+                         int& sequenceIndex)
+    : HangDetector(execution), _mla(mla), _sequenceIndex(sequenceIndex) {}
+
+    HangDetectionEvents subscribedEvents() const override { return META_LOOP_ENDED_EVENT; }
+
+    void dump() const override {}
+};
+
+TEST_CASE("Meta-loop unrolled loops", "[meta-loop-analysis][unrolled]") {
+    HangExecutor hangExecutor(1000, 20000);
+    hangExecutor.setMaxSteps(20000);
+
+    MetaLoopAnalysis mla;
+    int sequenceIndex = -1;
+    hangExecutor.addHangDetector(std::make_shared<RunUntilUnrolledLoop>(hangExecutor, mla,
+                                                                        sequenceIndex));
+
+    // Its loop size is twice the meta-loop period. The sequence index of the unrolled loop is
+    // beyond the period.
+    RunResult result = hangExecutor.execute("ZgqCUhWJEIAloA");
+
+    REQUIRE(result == RunResult::DETECTED_HANG);
+    REQUIRE(mla.loopSize() == 2 * mla.metaLoopPeriod());
+    REQUIRE(sequenceIndex >= mla.metaLoopPeriod());
+
+    auto analysis = mla.unrolledLoopSequenceAnalysis(hangExecutor, sequenceIndex);
+    REQUIRE(analysis != nullptr);
+    REQUIRE(!analysis->isLoop());
+
+    // It is cached
+    REQUIRE(mla.unrolledLoopSequenceAnalysis(hangExecutor, sequenceIndex) == analysis);
+}
@@ -8,7 +8,9 @@
 
 #include "catch.hpp"
 
+#include "HangDetector.h"
 #include "HangExecutor.h"
+#include "MetaLoopHangDetector.h"
 
 TEST_CASE("5x5 Periodic Hang tests", "[hang][periodic][5x5]") {
     HangExecutor hangExecutor(1024, 1024);
@@ -447,3 +449,170 @@ TEST_CASE("7x7 Periodic Hang tests", "[hang][periodic][7x7]") {
         REQUIRE(hangExecutor.detectedHangType() == HangType::NESTED_PERIODIC);
     }
 }
+
+TEST_CASE("Hang detector event dispatching", "[hang][periodic][events]") {
+    HangExecutor hangExecutor(1024, 1024);
+    hangExecutor.setMaxSteps(1024);
+    hangExecutor.addDefaultHangDetectors();
+
+    // Simple periodic loop with a counter.
+    RunResult result = hangExecutor.execute("VYgQIECAAg");
+
+    REQUIRE(result == RunResult::DETECTED_HANG);
+    REQUIRE(hangExecutor.detectedHangType() == HangType::PERIODIC);
+
+    auto& periodicStats = hangExecutor.hangDetectors()[0]->stats();
+    REQUIRE(periodicStats.numInvocations > 0);
+    REQUIRE(periodicStats.numSuccessfulAnalyses == 1);
+    REQUIRE(periodicStats.numProofsYes == 1);
+    REQUIRE(periodicStats.numProofsNo == 0);
+
+    // There is no meta-loop, so the meta-loop detector should not have been invoked
+    auto& metaLoopStats = hangExecutor.hangDetectors()[1]->stats();
+    REQUIRE(metaLoopStats.numInvocations == 0);
+}
+
+namespace {
+
+// Records the events it is invoked for, without ever checking for a hang
+class EventRecorder : public HangDetector {
+    HangDetectionEvents _subscribedEvents;
+
+protected:
+    bool shouldCheckNow(HangDetectionEvents events) const override {
+        recordedEvents.push_back(events);
+        numRunBlocks.push_back(_execution.getRunSummary().getNumRunBlocks());
+        return false;
+    }
+
+    bool analyzeHangBehaviour() override { return false; };
+    Trilian proofHang() override { return Trilian::NO; };
+
+public:
+    EventRecorder(const ExecutionState& execution, HangDetectionEvents subscribedEvents)
+    : HangDetector(execution), _subscribedEvents(subscribedEvents) {}
+
+    HangDetectionEvents subscribedEvents() const override { return _subscribedEvents; }
+
+    void dump() const override {}
+
+    // The events, and the number of run blocks when each occurred
+    mutable std::vector<HangDetectionEvents> recordedEvents;
+    mutable std::vector<int> numRunBlocks;
+};
+
+}
+
+TEST_CASE("Hang detector event order", "[hang][events]") {
+    HangExecutor hangExecutor(1024, 2000);
+    hangExecutor.setMaxSteps(2000);
+
+    constexpr HangDetectionEvents allEvents = (LOOP_STARTED_EVENT | LOOP_ITERATION_EVENT
+                                               | LOOP_ENDED_EVENT | META_LOOP_STARTED_EVENT
+                                               | META_LOOP_ENDED_EVENT | META_LOOP_ITERATION_EVENT
+                                               | CHECKPOINT_EVENT);
+    auto recorder = std::make_shared<EventRecorder>(hangExecutor, allEvents);
+    hangExecutor.addHangDetector(recorder);
+
+    // A glider, whose meta-loop has a period of two run blocks
+    hangExecutor.execute("ZgKCBhFglIWFoA");
+
+    auto& events = recorder->recordedEvents;
+    int numCheckpoints = 0;
+    int numMetaLoopIterations = 0;
+    int lastMetaLoopIteration = -1;
+    bool insideLoop = false;
+    for (int i = 0; i < events.size(); i++) {
+        auto event = events[i];
+        if (event & CHECKPOINT_EVENT) {
+            numCheckpoints++;
+        }
+
+        // Loops alternately start and end. Each start is a new run block, and thus a checkpoint.
+        if (event & LOOP_STARTED_EVENT) {
+            REQUIRE(!insideLoop);
+            REQUIRE((event & CHECKPOINT_EVENT) != 0);
+            insideLoop = true;
+        }
+        if (event & LOOP_ENDED_EVENT) {
+            REQUIRE(insideLoop);
+            insideLoop = false;
+        }
+        REQUIRE(((event & LOOP_ITERATION_EVENT) == 0 || insideLoop));
+        REQUIRE(((event & META_LOOP_STARTED_EVENT) == 0 || (event & LOOP_STARTED_EVENT) != 0));
+        REQUIRE(((event & META_LOOP_ENDED_EVENT) == 0 || (event & LOOP_ENDED_EVENT) != 0));
+
+        // Meta-loop iterations complete at a checkpoint, one meta-loop period apart
+        if (event & META_LOOP_ITERATION_EVENT) {
+            int numRunBlocks = recorder->numRunBlocks[i];
+            REQUIRE((event & CHECKPOINT_EVENT) != 0);
+            if (lastMetaLoopIteration >= 0) {
+                REQUIRE(numRunBlocks - lastMetaLoopIteration == 2);
+            }
+            lastMetaLoopIteration = numRunBlocks;
+            numMetaLoopIterations++;
+        }
+    }
+
+    REQUIRE(numCheckpoints > 0);
+    REQUIRE(numCheckpoints <= hangExecutor.getRunSummary().getNumRunBlocks());
+    REQUIRE(numMetaLoopIterations > 2);
+    REQUIRE(hangExecutor.getMetaRunSummary().isInsideLoop());
+    REQUIRE(hangExecutor.getMetaRunSummary().getLoopPeriod() == 2);
+
+    // A detector only receives the events it subscribed to
+    auto metaLoopRecorder = std::make_shared<EventRecorder>(hangExecutor,
+                                                            META_LOOP_ITERATION_EVENT);
+    hangExecutor.pop();
+    hangExecutor.addHangDetector(metaLoopRecorder);
+    hangExecutor.execute("ZgKCBhFglIWFoA");
+
+    REQUIRE(metaLoopRecorder->recordedEvents.size() == numMetaLoopIterations);
+    for (auto event : metaLoopRecorder->recordedEvents) {
+        REQUIRE(event == META_LOOP_ITERATION_EVENT);
+    }
+}
+
+TEST_CASE("Hang detection profile", "[hang][profile]") {
+    HangExecutor hangExecutor(1024, 100000);
+    hangExecutor.setMaxSteps(100000);
+    hangExecutor.addDefaultHangDetectors();
+    hangExecutor.setMeasureDetectorTime(true);
+
+    auto metaLoopDetector = std::dynamic_pointer_cast<MetaLoopHangDetector>(
+        hangExecutor.hangDetectors()[1]);
+    REQUIRE(metaLoopDetector);
+
+    // A regular sweep
+    REQUIRE(hangExecutor.execute("VQgJKGJgWA") == RunResult::DETECTED_HANG);
+    REQUIRE(hangExecutor.detectedHangType() == HangType::REGULAR_SWEEP);
+    hangExecutor.pop();
+
+    auto& sweepStats = metaLoopDetector->checkerStats(HangType::REGULAR_SWEEP);
+    REQUIRE(sweepStats.numSuccessfulAnalyses >= 1);
+    REQUIRE(sweepStats.numProofsYes == 1);
+    REQUIRE(sweepStats.numProofAttempts >= 1);
+    REQUIRE(sweepStats.proofTime.count() > 0);
+
+    auto& gliderStats = metaLoopDetector->checkerStats(HangType::APERIODIC_GLIDER);
+    REQUIRE(gliderStats.numProofsYes == 0);
+
+    // A glider
+    REQUIRE(hangExecutor.execute("ZgKCBhFglIWFoA") == RunResult::DETECTED_HANG);
+    REQUIRE(hangExecutor.detectedHangType() == HangType::APERIODIC_GLIDER);
+    hangExecutor.pop();
+
+    REQUIRE(gliderStats.numSuccessfulAnalyses >= 1);
+    REQUIRE(gliderStats.numProofsYes == 1);
+    REQUIRE(gliderStats.proofTime.count() > 0);
+
+    // Stats accumulate across executions
+    REQUIRE(sweepStats.numProofsYes == 1);
+    REQUIRE(metaLoopDetector->checkerStats(HangType::IRREGULAR_SWEEP).numProofsYes == 0);
+    REQUIRE(metaLoopDetector->checkerStats(HangType::AFFINE_COUNTER).numProofsYes == 0);
+
+    auto& analysisStats = metaLoopDetector->metaLoopAnalysisStats();
+    REQUIRE(analysisStats.numSuccessfulAnalyses >= 2);
+    REQUIRE(analysisStats.analysisTime.count() > 0);
+    REQUIRE(metaLoopDetector->stats().numProofsYes == 2);
+}
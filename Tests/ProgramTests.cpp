@@ -11,6 +11,7 @@
 #include "catch.hpp"
 
 #include "Program.h"
+#include "Utils.h"
 
 TEST_CASE( "Program Encoding/Decoding Tests", "[program][encoding]" ) {
     SECTION( "2x2 All Turn" ) {
@@ -104,3 +105,69 @@ TEST_CASE( "Program Encoding/Decoding Tests", "[program][encoding]" ) {
         REQUIRE(b64 == s);
     }
 }
+
+// Counts the NOOPs ahead by stepping through the program
+int countNoopsAhead(const Program& program, ProgramPointer pp) {
+    int count = 0;
+    while (program.getInstruction(pp.p = nextInstructionPointer(pp)) == Ins::NOOP) {
+        count++;
+    }
+    return count;
+}
+
+void checkNoopsAhead(const Program& program) {
+    ProgramSize size = program.getSize();
+    for (int8_t row = -1; row < size.height; row++) {
+        for (int8_t col = 0; col < size.width; col++) {
+            // Only the entry point can be outside the program
+            if (row < 0 && col > 0) continue;
+
+            for (int dir = 0; dir < 4; dir++) {
+                if (row < 0 && dir != static_cast<int>(Dir::UP)) continue;
+
+                ProgramPointer pp = {
+                    .p = { .col = col, .row = row }, .dir = static_cast<Dir>(dir)
+                };
+                REQUIRE(program.noopsAhead(pp) == countNoopsAhead(program, pp));
+            }
+        }
+    }
+}
+
+TEST_CASE( "Program NOOP look-ahead", "[program][noops]" ) {
+    SECTION( "5x4 Set and clear" ) {
+        Program program(ProgramSize(5, 4));
+        std::vector<InstructionPointer> order;
+        for (int8_t row = 0; row < 4; row++) {
+            for (int8_t col = 0; col < 5; col++) {
+                order.push_back({ .col = col, .row = row });
+            }
+        }
+        // Fixed pseudo-random order and instructions, with mostly NOOPs
+        std::swap(order[3], order[17]);
+        std::swap(order[5], order[11]);
+        std::swap(order[0], order[19]);
+
+        int i = 0;
+        for (auto insP : order) {
+            Ins ins = (i % 5 == 2) ? Ins::TURN : ((i % 7 == 3) ? Ins::DATA : Ins::NOOP);
+            program.setInstruction(insP, ins);
+            checkNoopsAhead(program);
+            i++;
+        }
+
+        while (!order.empty()) {
+            program.clearInstruction(order.back());
+            order.pop_back();
+            checkNoopsAhead(program);
+        }
+    }
+    SECTION( "Clone" ) {
+        Program program = Program::fromString("M6qqg");
+        Program clone;
+        program.setInstruction({ .col = 1, .row = 1 }, Ins::NOOP);
+        program.clone(clone);
+        checkNoopsAhead(clone);
+        REQUIRE(clone.noopsAhead({ .p = { .col = 1, .row = 0 }, .dir = Dir::UP }) == 1);
+    }
+}
@@ -13,6 +13,7 @@
 
 #include "catch.hpp"
 
+#include "HangExecutor.h"
 #include "RunSummary.h"
 
 class RunSummaryTest : public RunSummaryBase {
@@ -21,7 +22,7 @@ class RunSummaryTest : public RunSummaryBase {
     int getRunUnitIdAt(int runUnitIndex) const override { return _runHistory[runUnitIndex]; };
 
 public:
-    RunSummaryTest(const std::vector<int> &runHistory, int* helperBuf)
+    RunSummaryTest(const std::vector<int> &runHistory, std::vector<int>& helperBuf)
     : RunSummaryBase(helperBuf), _runHistory(runHistory) {}
 
     bool processNewRunUnits() override { return processNewHistory(_runHistory); };
@@ -74,7 +75,7 @@ bool checkRunSummary(RunSummaryTest& runSummary, std::vector<int>& expected) {
 
 bool processAndCompare(std::vector<int>& blocks, std::vector<int>& expectedRuns,
                        bool identifyShortLoops = false) {
-    int zArrayHelperBuf[32];
+    std::vector<int> zArrayHelperBuf;
     RunSummaryTest runSummary(blocks, zArrayHelperBuf);
 
     runSummary.setIdentifyShortLoops(identifyShortLoops);
@@ -215,7 +216,7 @@ TEST_CASE( "RunSummary-ShortLoops", "[util][runsummary]" ) {
 
 TEST_CASE( "RunSummaryLoopEquivalence", "[util][runsummary][loop-equivalence]" ) {
     std::vector<int> history;
-    int zArrayHelperBuf[32];
+    std::vector<int> zArrayHelperBuf;
     RunSummaryTest runSummary(history, zArrayHelperBuf);
     int loopOffset;
 
@@ -266,3 +267,46 @@ TEST_CASE( "RunSummaryLoopEquivalence", "[util][runsummary][loop-equivalence]" )
         REQUIRE(!runSummary.areLoopsRotationEqual(loop3, loop2, loopOffset));
     }
 }
+
+TEST_CASE( "BoundedRunHistory", "[util][runsummary][bounded]" ) {
+    SECTION( "DiscardBefore" ) {
+        std::vector<ProgramBlock> blocks;
+        RunHistory history;
+        for (int i = 0; i < 1000; i++) {
+            blocks.emplace_back(i);
+        }
+        for (auto& block : blocks) {
+            history.push_back(&block);
+        }
+
+        history.discardBefore(900);
+
+        REQUIRE(history.size() == 1000);
+        REQUIRE(history.firstIndex() == 900);
+        REQUIRE(history[900] == &blocks[900]);
+        REQUIRE(history.back() == &blocks[999]);
+        REQUIRE(std::distance(history.begin(), history.end()) == 100);
+
+        history.push_back(&blocks[0]);
+        REQUIRE(history[1000] == &blocks[0]);
+    }
+    SECTION( "SameResultAsUnbounded" ) {
+        // A 7x7 program that does not hang in a way that is detected. Its summaries find enough
+        // loops that most of its run history can be discarded.
+        std::string programSpec = "d+6+RLRbylIxbIWz68";
+        HangExecutor hangExecutor(100000, 100000);
+        hangExecutor.setMaxSteps(100000);
+        hangExecutor.addDefaultHangDetectors();
+
+        RunResult result = hangExecutor.execute(programSpec);
+        auto& history = hangExecutor.getRunHistory();
+        size_t historySize = history.size();
+        REQUIRE(history.firstIndex() > historySize / 2);
+        hangExecutor.pop();
+
+        hangExecutor.setBoundRunHistory(false);
+        REQUIRE(hangExecutor.execute(programSpec) == result);
+        REQUIRE(history.size() == historySize);
+        REQUIRE(history.firstIndex() == 0);
+    }
+}
@@ -13,10 +13,8 @@ class RunUntilMetaLoop : public HangDetector {
     int _numIterations;
 
 protected:
-    bool shouldCheckNow() const override {
-        return (_execution.getLoopRunState() == LoopRunState::ENDED
-                && _execution.getMetaRunSummary().isInsideLoop()
-                && _execution.getMetaRunSummary().getLoopIteration() >= _numIterations);
+    bool shouldCheckNow(HangDetectionEvents events) const override {
+        return _execution.getMetaRunSummary().getLoopIteration() >= _numIterations;
     }
 
     bool analyzeHangBehaviour() override { return true; };
@@ -26,14 +24,16 @@ public:
     RunUntilMetaLoop(const ExecutionState& execution, int numIterations = 3)
     : HangDetector(execution), _numIterations(numIterations) {}
 
+    HangDetectionEvents subscribedEvents() const override { return META_LOOP_ENDED_EVENT; }
+
     void dump() const override {}
 };
 
 class RunUntilMetaMetaLoop : public RunUntilMetaLoop {
 protected:
-    bool shouldCheckNow() const override {
+    bool shouldCheckNow(HangDetectionEvents events) const override {
         return (_execution.getMetaMetaRunSummary().isInsideLoop()
-                && RunUntilMetaLoop::shouldCheckNow());
+                && RunUntilMetaLoop::shouldCheckNow(events));
     }
 
     bool analyzeHangBehaviour() override { return true; };
@@ -0,0 +1,157 @@
+//
+//  StaticHangAnalysisTests.cpp
+//  BusyBeaverFinder
+//
+//  Created by Erwin on 18/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include <stdio.h>
+#include "catch.hpp"
+
+#include "ExhaustiveSearcher.h"
+#include "StaticHangAnalyzer.h"
+
+// Executes the program for the given number of steps and then analyzes if it hangs from the block
+// where execution is at. Returns the rule that was needed to prove the hang, or std::nullopt if
+// the hang could not be proven.
+std::optional<PruningRule> analyzeHangFromBlock(std::string programSpec, int numSteps) {
+    Program program = Program::fromString(programSpec);
+    auto interpretedProgram = std::make_shared<InterpretedProgramBuilder>();
+    interpretedProgram->buildFromProgram(program);
+
+    HangExecutor hangExecutor(1024, 0);
+    hangExecutor.setMaxSteps(numSteps);
+    RunResult result = hangExecutor.execute(interpretedProgram);
+
+    REQUIRE(result == RunResult::ASSUMED_HANG);
+
+    // Only consider hangs that cannot be detected by the exit finder. Invoke it first, as the
+    // search does, as it may finalize blocks.
+    ExitFinder exitFinder(program, *interpretedProgram);
+    REQUIRE(exitFinder.canExitFrom(hangExecutor.lastProgramBlock()));
+
+    StaticHangAnalyzer analyzer;
+    if (!analyzer.provesHang(hangExecutor.lastProgramBlock())) {
+        return std::nullopt;
+    }
+
+    return analyzer.lastRule();
+}
+
+TEST_CASE( "Abstract value tests", "[hang][static][abstract-value]" ) {
+    SECTION( "ExactValues" ) {
+        AbstractValue zero = AbstractValue::exact(0);
+        REQUIRE(zero.zeroExcludedBy() == PruningRule::NONE);
+        REQUIRE(zero.nonZeroExcludedBy() == PruningRule::CONSTANT);
+
+        AbstractValue two = zero.add(2);
+        REQUIRE(two == AbstractValue::exact(2));
+        REQUIRE(two.zeroExcludedBy() == PruningRule::CONSTANT);
+        REQUIRE(two.nonZeroExcludedBy() == PruningRule::NONE);
+    }
+    SECTION( "Sign" ) {
+        // A positive value that only increases never becomes zero
+        AbstractValue value = AbstractValue::exact(1).join(AbstractValue::exact(2));
+        REQUIRE(!value.isExact());
+        REQUIRE(value.zeroExcludedBy() == PruningRule::SIGN);
+
+        value = value.add(1);
+        REQUIRE(value.zeroExcludedBy() == PruningRule::SIGN);
+
+        // Decreasing it may result in zero
+        value = value.add(-1);
+        REQUIRE(value.zeroExcludedBy() == PruningRule::NONE);
+    }
+    SECTION( "Congruence" ) {
+        // An odd value that changes by multiples of two never becomes zero
+        AbstractValue value = AbstractValue::exact(1).join(AbstractValue::exact(-1));
+        REQUIRE(value.modulus == 2);
+        REQUIRE(value.residue == 1);
+        REQUIRE(value.zeroExcludedBy() == PruningRule::SIGN);
+
+        // The sign is lost when a positive value is decreased, but the congruence remains
+        value = value.add(-2);
+        REQUIRE(value.zeroExcludedBy() == PruningRule::CONGRUENCE);
+
+        // Adding an odd amount may result in zero
+        value = value.add(3);
+        REQUIRE(value.zeroExcludedBy() == PruningRule::NONE);
+
+        // Joining with a value of a different residue class loses the congruence
+        value = AbstractValue::exact(3).join(AbstractValue::exact(-1)).add(-4);
+        REQUIRE(value.modulus == 4);
+        REQUIRE(value.zeroExcludedBy() == PruningRule::CONGRUENCE);
+        value = value.join(AbstractValue::exact(2));
+        REQUIRE(value.zeroExcludedBy() == PruningRule::NONE);
+    }
+}
+
+TEST_CASE( "Static hang analysis tests", "[hang][static]" ) {
+    SECTION( "6x6-Constant" ) {
+        // Block 5 is entered with a zero value, so it exits with two. Block 4 then always results
+        // in a zero value. Its non-zero exit, to the unfinalized Block 3, is therefore never taken.
+        //
+        // *       *
+        // o _ _ _ _ *
+        // _   *   o
+        // _ * o   o
+        // _ * _ _ _ *
+        // _   *   *
+        //
+        // 0 (0): INC 1 => -/1, #Steps = 5
+        // 1 (65): DEC 2 => 2/3, #Steps = 7
+        // 2 (24): INC 2 => -/4, #Steps = 3
+        // 3 (25): INC 1 => 5/6, #Steps = 3
+        // 4 (73): DEC 2 => 2/3, #Steps = 3
+        // 5 (36): INC 2 => -/4, #Steps = 6
+        // 6 (37): -
+        auto rule = analyzeHangFromBlock("Zr+0AjtydyAjuw", 13);
+
+        REQUIRE(rule == PruningRule::CONSTANT);
+    }
+    SECTION( "6x6-Sign" ) {
+        // Block 6 keeps incrementing a value that starts at one, so its zero exit is never taken.
+        //
+        // *     *
+        // o _ * _
+        // _ o o _ *
+        // _ * _ _ _ *
+        // _   _ *
+        // _   *
+        //
+        // 0 (0): INC 1 => -/1, #Steps = 5
+        // 1 (65): DEC 1 => 2/3, #Steps = 2
+        // 2 (50): SHR 1 => 4/5, #Steps = 2
+        // 3 (51): EXIT => -/-, #Steps = 2
+        // 4 (54): INC 1 => -/6, #Steps = 9
+        // 5 (55): INC 1 => 7/6, #Steps = 3
+        // 6 (53): INC 1 => 7/6, #Steps = 4
+        // 7 (52): EXIT => -/-, #Steps = 3
+        auto rule = analyzeHangFromBlock("Zr70jxSyAjLzvw", 8);
+
+        REQUIRE(rule == PruningRule::SIGN);
+    }
+    SECTION( "7x7-Congruence" ) {
+        // Block 9 is entered with zero, which Blocks 9 and 11 turn into one. The loop of Blocks 8
+        // and 10 subsequently changes the value by even amounts only, so it remains odd. The zero
+        // exits of both blocks, to the unfinalized Block 7, are therefore never taken.
+        //
+        // *       * *
+        // o _ _ * o _ *
+        // _   _   o o
+        // _   _   _ o
+        // _   o _ _ o *
+        // _   * * _ o
+        // _       * *
+        //
+        // 7 (26): -
+        // 8 (27): INC 2 => 9/10
+        // 9 (88): DEC 1 => -/11
+        // 10 (89): DEC 4 => 7/8
+        // 11 (25): INC 2 => 9/10
+        auto rule = analyzeHangFromBlock("d7+tCSM1zMc0GOhz+s", 22);
+
+        REQUIRE(rule == PruningRule::CONGRUENCE);
+    }
+}
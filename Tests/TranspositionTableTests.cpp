@@ -0,0 +1,115 @@
+//
+//  TranspositionTableTests.cpp
+//  Tests
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include <memory>
+
+#include "catch.hpp"
+
+#include "ExhaustiveSearcher.h"
+#include "TranspositionTable.h"
+
+TEST_CASE("Transposition table", "[transposition-table]") {
+    TranspositionTable table(2);
+    RunResult result;
+    int numSteps;
+
+    ExecutionKey key1 = {1, 2, 3};
+    ExecutionKey key2 = {1, 2, 4};
+    ExecutionKey key3 = {5};
+
+    SECTION("Lookup") {
+        REQUIRE(!table.lookup(key1, 1000, result, numSteps));
+
+        table.store(key1, 1000, RunResult::SUCCESS, 42, HangType::UNDETECTED);
+        REQUIRE(table.lookup(key1, 1000, result, numSteps));
+        REQUIRE(result == RunResult::SUCCESS);
+        REQUIRE(numSteps == 42);
+        REQUIRE(!table.lookup(key2, 1000, result, numSteps));
+
+        // The execution would be cut short before it completes
+        REQUIRE(!table.lookup(key1, 42, result, numSteps));
+
+        REQUIRE(table.numLookups() == 4);
+        REQUIRE(table.numHits() == 1);
+    }
+    SECTION("Assumed hang") {
+        table.store(key1, 1000, RunResult::ASSUMED_HANG, 1000, HangType::UNDETECTED);
+
+        REQUIRE(table.lookup(key1, 500, result, numSteps));
+        REQUIRE(result == RunResult::ASSUMED_HANG);
+
+        // The program may terminate after more steps
+        REQUIRE(!table.lookup(key1, 2000, result, numSteps));
+
+        table.store(key1, 2000, RunResult::SUCCESS, 1500, HangType::UNDETECTED);
+        REQUIRE(table.size() == 1);
+        REQUIRE(table.lookup(key1, 2000, result, numSteps));
+        REQUIRE(result == RunResult::SUCCESS);
+    }
+    SECTION("Detected hang") {
+        HangType hangType;
+        table.store(key1, 1000, RunResult::DETECTED_HANG, 200, HangType::REGULAR_SWEEP);
+        table.store(key2, 1000, RunResult::SUCCESS, 100, HangType::UNDETECTED);
+
+        REQUIRE(table.lookup(key1, 1000, result, numSteps, hangType));
+        REQUIRE(result == RunResult::DETECTED_HANG);
+        REQUIRE(hangType == HangType::REGULAR_SWEEP);
+
+        REQUIRE(table.lookup(key2, 1000, result, numSteps, hangType));
+        REQUIRE(hangType == HangType::UNDETECTED);
+    }
+    SECTION("LRU eviction") {
+        table.store(key1, 1000, RunResult::SUCCESS, 1, HangType::UNDETECTED);
+        table.store(key2, 1000, RunResult::SUCCESS, 2, HangType::UNDETECTED);
+
+        // Make key1 the most recently used
+        REQUIRE(table.lookup(key1, 1000, result, numSteps));
+
+        table.store(key3, 1000, RunResult::SUCCESS, 3, HangType::UNDETECTED);
+        REQUIRE(table.size() == 2);
+        REQUIRE(table.numEvictions() == 1);
+        REQUIRE(table.lookup(key1, 1000, result, numSteps));
+        REQUIRE(!table.lookup(key2, 1000, result, numSteps));
+        REQUIRE(table.lookup(key3, 1000, result, numSteps));
+    }
+}
+
+TEST_CASE("5x5 Search with transposition table", "[search][5x5][transposition-table]") {
+    SearchSettings settings {5};
+    // Limit hang detection so that many programs are executed by the fast executor
+    settings.maxHangDetectionSteps = 10;
+    settings.maxSearchSteps = 10;
+
+    auto search = [](SearchSettings settings) {
+        ExhaustiveSearcher searcher {settings};
+        auto tracker = std::make_unique<ProgressTracker>();
+        tracker->setDumpSuccessStepsLimit(INT_MAX);
+        searcher.attachProgressTracker(std::move(tracker));
+
+        searcher.search();
+
+        return searcher.detachProgressTracker();
+    };
+
+    settings.transpositionTableSize = 0;
+    auto reference = search(settings);
+    REQUIRE(reference->getTotalCachedFastExecutions() == 0);
+
+    settings.transpositionTableSize = 4096;
+    auto tracker = search(settings);
+    REQUIRE(tracker->getTotalCachedFastExecutions() > 0);
+
+    // Cached results should not change the outcome of the search
+    REQUIRE(tracker->getTotalFastExecutions() == reference->getTotalFastExecutions());
+    REQUIRE(tracker->getTotalLateEscapes() == reference->getTotalLateEscapes());
+    REQUIRE(tracker->getTotalSuccess() == reference->getTotalSuccess());
+    REQUIRE(tracker->getTotalErrors() == reference->getTotalErrors());
+    REQUIRE(tracker->getTotalHangs() == reference->getTotalHangs());
+    REQUIRE(tracker->getTotalDetectedHangs() == reference->getTotalDetectedHangs());
+    REQUIRE(tracker->getMaxStepsFound() == reference->getMaxStepsFound());
+}
@@ -0,0 +1,97 @@
+//
+//  WorkPlannerTests.cpp
+//  Tests
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include <memory>
+#include <sstream>
+
+#include "catch.hpp"
+
+#include "ExhaustiveSearcher.h"
+#include "SearchOrchestration.h"
+#include "SubTreeProfiler.h"
+#include "WorkPlanner.h"
+
+TEST_CASE("5x5 Work planning", "[search][5x5][work-planner]") {
+    SearchSettings settings {5};
+    settings.subTreeProfileDepth = 3;
+    OrchestratedSearchRunner runner {settings};
+
+    auto tracker = std::make_unique<ProgressTracker>();
+    tracker->setDumpSuccessStepsLimit(INT_MAX);
+    runner.getSearcher().attachProgressTracker(std::move(tracker));
+    runner.run();
+    tracker = runner.getSearcher().detachProgressTracker();
+
+    const SubTreeProfile* profile = runner.getSearcher().getSubTreeProfile();
+    REQUIRE(profile != nullptr);
+
+    SECTION("Profile") {
+        // The sub-trees at the root together cover the search
+        SubTreeStats rootStats;
+        for (auto& [stack, stats] : profile->subTrees()) {
+            if (stack.size() == 1) {
+                // These are on the path to the resume points of the orchestrated search
+                REQUIRE(!stats.complete);
+                rootStats.add(stats);
+            }
+        }
+        REQUIRE(rootStats.numPrograms == tracker->getTotal());
+        REQUIRE(rootStats.numSuccess == tracker->getTotalSuccess());
+        REQUIRE(rootStats.numEquivalent == tracker->getTotalEquivalent());
+        REQUIRE(rootStats.numHangs[(int)HangType::NO_EXIT]
+                == tracker->getTotalHangs(HangType::NO_EXIT));
+    }
+
+    SECTION("Write and read") {
+        std::stringstream stream;
+        profile->write(stream);
+
+        SubTreeProfile copy;
+        REQUIRE(copy.read(stream));
+        REQUIRE(copy.subTrees().size() == profile->subTrees().size());
+        for (auto& [stack, stats] : profile->subTrees()) {
+            auto& copyStats = copy.subTrees().at(stack);
+            REQUIRE(copyStats.complete == stats.complete);
+            REQUIRE(copyStats.numPrograms == stats.numPrograms);
+            REQUIRE(copyStats.numSteps == stats.numSteps);
+        }
+    }
+
+    SECTION("Work units") {
+        WorkPlanner planner(*profile, CostMetric::PROGRAMS);
+        auto units = planner.createWorkUnits(12);
+        REQUIRE(units.size() >= 12);
+
+        auto workers = planner.assignWorkUnits(units, 3);
+        REQUIRE(workers.size() == 3);
+
+        // Searching the work units should give the same result as the orchestrated search
+        long total = 0, totalSuccess = 0;
+        for (auto& workerUnits : workers) {
+            REQUIRE(!workerUnits.empty());
+
+            ExhaustiveSearcher searcher {SearchSettings {5}};
+            auto workerTracker = std::make_unique<ProgressTracker>();
+            workerTracker->setDumpSuccessStepsLimit(INT_MAX);
+            searcher.attachProgressTracker(std::move(workerTracker));
+
+            double cost = 0;
+            for (auto& unit : workerUnits) {
+                searcher.searchSubTree(unit.stack);
+                cost += unit.cost;
+            }
+            workerTracker = searcher.detachProgressTracker();
+            REQUIRE(workerTracker->getTotal() == cost);
+
+            total += workerTracker->getTotal();
+            totalSuccess += workerTracker->getTotalSuccess();
+        }
+        REQUIRE(total == tracker->getTotal());
+        REQUIRE(totalSuccess == tracker->getTotalSuccess());
+    }
+}
@@ -0,0 +1,74 @@
+//
+//  main.cpp
+//  Verifier
+//
+//  Created by Erwin on 19/10/2026.
+//  Copyright © 2026 Erwin. All rights reserved.
+//
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cxxopts.hpp"
+
+#include "HangCertificate.h"
+
+// Checks the hang certificates in a file, as written by the search when it is given a certificate
+// file. It reports the number of valid certificates per type, and the programs whose certificate
+// is invalid.
+int main(int argc, char * argv[]) {
+    cxxopts::Options options("Verifier", "Checks hang certificates");
+    options.add_options()
+        ("certificate-file", "File with hang certificates", cxxopts::value<std::string>())
+        ("threads", "Number of threads, 0 to use all cores",
+         cxxopts::value<int>()->default_value("0"))
+        ("help", "Show help");
+    options.parse_positional({"certificate-file"});
+    auto result = options.parse(argc, argv);
+
+    if (result.count("help") || !result.count("certificate-file")) {
+        std::cout << options.help() << std::endl;
+        return result.count("help") ? 0 : -1;
+    }
+
+    auto certificateFile = result["certificate-file"].as<std::string>();
+    std::ifstream input(certificateFile);
+    std::vector<CertifiedHang> hangs;
+    if (!input || !readCertifiedHangs(input, hangs)) {
+        std::cerr << "Could not read certificate file: " << certificateFile << std::endl;
+        return -1;
+    }
+
+    int numThreads = result["threads"].as<int>();
+    if (numThreads <= 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto valid = verifyCertifiedHangs(hangs, numThreads);
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+
+    const char* typeNames[] = { "Cycle", "AffineCounter", "ClosedTape" };
+    long numValidByType[3] = {};
+    long numInvalid = 0;
+    for (size_t i = 0; i < hangs.size(); i++) {
+        if (valid[i]) {
+            numValidByType[(int)hangs[i].certificate.type]++;
+        } else {
+            numInvalid++;
+            std::cout << "INVALID " << hangs[i].programSpec << std::endl;
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        std::cout << typeNames[i] << ": " << numValidByType[i] << std::endl;
+    }
+    std::cout << "Invalid: " << numInvalid << " of " << hangs.size()
+    << ", time = " << duration.count() << "s, threads = " << numThreads << std::endl;
+
+    return numInvalid == 0 ? 0 : 1;
+}